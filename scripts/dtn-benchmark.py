@@ -0,0 +1,208 @@
+#!/usr/bin/env python3
+"""
+DTN Scalability Benchmark - Runs each ns-3 DTN scenario across node counts and buffer sizes
+Reports wall-clock time, simulator events per second, peak RSS and bundle overhead ratio
+per configuration, and flags regressions against a stored baseline CSV
+"""
+
+import argparse
+import csv
+import importlib.util
+import os
+import sys
+import time
+
+# The sweep runner already knows how to find, run and parse the scenarios
+_SWEEP_PATH = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'dtn-parameter-sweep.py')
+_spec = importlib.util.spec_from_file_location('dtn_parameter_sweep', _SWEEP_PATH)
+sweep = importlib.util.module_from_spec(_spec)
+_spec.loader.exec_module(sweep)
+
+DEFAULT_BASELINE = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'dtn-benchmark-baseline.csv')
+
+# Command-line arguments of each scenario for a total node count; two thirds mobile.
+# The decimated animation keeps NetAnim's per-frame XML out of the measurements
+SCENARIOS = {
+    'dtn-disaster-system': lambda n: [('nMobile', n * 2 // 3), ('nStatic', n - n * 2 // 3),
+                                      ('animMode', 'Decimated')],
+    'dtn-optimized-visualization': lambda n: [('mobileNodes', n * 2 // 3), ('staticNodes', n - n * 2 // 3),
+                                              ('animMode', 'Decimated')],
+    'dtn-advanced-routing': lambda n: [('nNodes', n)],
+}
+
+KEY = ['Program', 'Nodes', 'Buffer']
+PROFILE_FILE = 'dtn-profile.csv'
+PROFILE_COLUMNS = KEY + ['Phase', 'Calls', 'Total(ms)', 'Self(ms)', 'Mean(us)', 'Share(%)']
+# Metric, SUMMARY_STATISTICS key, +1 when higher is worse, -1 when lower is worse
+METRICS = [
+    ('WallClock(s)', 'WallClock(s)', 1),
+    ('SimulatorEvents', 'SimulatorEvents', 0),
+    ('EventsPerSecond', 'EventsPerSecond', -1),
+    ('PeakRSS(MB)', 'PeakRSS(MB)', 1),
+    ('OverheadRatio', 'OverheadRatio', 1),
+    ('DeliveryRatio(%)', 'DeliveryRatio(%)', -1),
+]
+COLUMNS = KEY + [name for name, _, _ in METRICS] + ['Status']
+
+def row_key(row):
+    return (row['Program'], str(row['Nodes']), str(row['Buffer']))
+
+def read_profile(path):
+    """Rows of the PROFILE table a --profile run writes (DTN_PROFILING builds only)"""
+    if not os.path.exists(path):
+        return []
+    with open(path, newline='') as f:
+        lines = [line for line in f if line.strip() and line.strip() != 'PROFILE']
+    return list(csv.DictReader(lines))
+
+def run_config(binary, program, nodes, buffer, args, out_dir):
+    """Best of --repeat runs of one configuration, as a COLUMNS row plus its profile rows"""
+    point = [(name, str(value)) for name, value in SCENARIOS[program](nodes)]
+    if buffer != 'default':
+        point.append(('bufferSize', buffer))
+    fixed = [('simTime', str(args.sim_time))] + [(name, values[0]) for name, values in sweep.parse_grid(args.fixed)]
+    if args.profile:
+        fixed.append(('profile', 'true'))
+    profile_path = os.path.join(out_dir, sweep.point_label(tuple(point)), f"seed-{args.seed}_run-{args.run}", PROFILE_FILE)
+
+    best = None
+    best_profile = []
+    for _ in range(args.repeat):
+        _, _, _, metrics, elapsed, error = sweep.run_replication(
+            binary, program, tuple(point), args.seed, args.run, fixed, out_dir, args.timeout)
+        if error:
+            return dict(Program=program, Nodes=nodes, Buffer=buffer, Status=error), []
+        # The process is the ground truth should a scenario not report its own wall clock
+        metrics.setdefault('WallClock(s)', elapsed)
+        if best is None or metrics['WallClock(s)'] < best['WallClock(s)']:
+            best = metrics
+            best_profile = read_profile(profile_path)
+    row = dict(Program=program, Nodes=nodes, Buffer=buffer, Status='ok')
+    for name, key, _ in METRICS:
+        if key in best:
+            row[name] = f"{best[key]:g}"
+    profile = [dict(phase, Program=program, Nodes=nodes, Buffer=buffer) for phase in best_profile]
+    return row, profile
+
+def read_rows(path):
+    with open(path, newline='') as f:
+        return list(csv.DictReader(f))
+
+def write_rows(path, rows, columns=COLUMNS):
+    with open(path, 'w', newline='') as f:
+        writer = csv.DictWriter(f, fieldnames=columns)
+        writer.writeheader()
+        for row in rows:
+            writer.writerow({column: row.get(column, '') for column in columns})
+
+def compare(rows, baseline, tolerance):
+    """Printed comparison; returns the regressions as (key, metric, baseline, current) tuples"""
+    reference = {row_key(row): row for row in baseline}
+    regressions = []
+    print(f"\n{'Configuration':<44} {'Metric':<18} {'Baseline':>12} {'Current':>12} {'Change':>9}")
+    for row in rows:
+        label = f"{row['Program']} n={row['Nodes']} buf={row['Buffer']}"
+        base = reference.get(row_key(row))
+        if row.get('Status') != 'ok':
+            print(f"{label:<44} {row.get('Status')}")
+            if base and base.get('Status') == 'ok':
+                regressions.append((label, 'Status', 'ok', row.get('Status')))
+            continue
+        if not base or base.get('Status') != 'ok':
+            print(f"{label:<44} (no baseline)")
+            continue
+        for name, _, direction in METRICS:
+            if not row.get(name) or not base.get(name):
+                continue
+            old, new = float(base[name]), float(row[name])
+            change = (new - old) / old if old else 0.0
+            # Event counts are deterministic for a seed: any change is a behaviour change
+            worse = change * direction > tolerance if direction else new != old
+            flag = ' ❌' if worse else ''
+            print(f"{label:<44} {name:<18} {old:>12g} {new:>12g} {100.0 * change:>+8.1f}%{flag}")
+            if worse:
+                regressions.append((label, name, old, new))
+    return regressions
+
+def main():
+    parser = argparse.ArgumentParser(description="Scalability benchmark of the DTN scenarios")
+    parser.add_argument('programs', nargs='*', default=sorted(SCENARIOS),
+                        help=f"Scenarios to benchmark: {', '.join(sorted(SCENARIOS))} (default: all)")
+    parser.add_argument('--nodes', default='30,120,500,2000', help="Total node counts (default 30,120,500,2000)")
+    parser.add_argument('--buffers', default='default,500',
+                        help="Bundles per node; 'default' keeps the scenario's own sizes (default default,500)")
+    parser.add_argument('--sim-time', type=float, default=300.0, help="Simulated seconds per run (default 300)")
+    parser.add_argument('-f', '--fixed', action='append', default=[],
+                        help="Constant argument name=value passed to every run (repeatable)")
+    parser.add_argument('--seed', type=int, default=1)
+    parser.add_argument('--run', type=int, default=1)
+    parser.add_argument('--repeat', type=int, default=1, help="Runs per configuration, the fastest counts")
+    parser.add_argument('--timeout', type=float, default=None,
+                        help="Per-run wall-clock limit; larger node counts of a timed-out configuration are skipped")
+    parser.add_argument('--tolerance', type=float, default=0.15,
+                        help="Relative change counted as a regression (default 0.15)")
+    parser.add_argument('--baseline', default=DEFAULT_BASELINE, help="Baseline CSV to compare against")
+    parser.add_argument('--update-baseline', action='store_true', help="Write this run's results as the baseline")
+    parser.add_argument('--profile', action='store_true',
+                        help="Collect each run's per-phase timing table (module configured with -DDTN_PROFILING=ON)")
+    parser.add_argument('--ns3-dir', default='ns-3.45', help="ns-3 tree the module is built in")
+    parser.add_argument('-o', '--out', default='benchmark-results', help="Output directory")
+    args = parser.parse_args()
+    unknown = [program for program in args.programs if program not in SCENARIOS]
+    if unknown:
+        parser.error(f"unknown scenario {', '.join(unknown)}")
+
+    nodes = [int(n) for n in sweep.parse_values(args.nodes)]
+    buffers = sweep.parse_values(args.buffers)
+    os.makedirs(args.out, exist_ok=True)
+
+    # One process at a time: concurrent runs would share cores and memory bandwidth
+    rows = []
+    profiles = []
+    start = time.time()
+    for program in args.programs:
+        binary = sweep.find_binary(args.ns3_dir, program)
+        out_dir = os.path.join(args.out, program)
+        for buffer in buffers:
+            failed = None
+            for n in sorted(nodes):
+                if failed:
+                    rows.append(dict(Program=program, Nodes=n, Buffer=buffer, Status=f"skipped ({failed})"))
+                    continue
+                print(f"⏱️  {program} nodes={n} buffer={buffer}", flush=True)
+                row, profile = run_config(binary, program, n, buffer, args, out_dir)
+                rows.append(row)
+                profiles.extend(profile)
+                if row['Status'] != 'ok':
+                    failed = row['Status']
+                    print(f"❌ {row['Status']}")
+                else:
+                    print(f"✅ {row.get('WallClock(s)')} s, {row.get('EventsPerSecond')} events/s, "
+                          f"{row.get('PeakRSS(MB)')} MB, overhead {row.get('OverheadRatio')}")
+
+    results_path = os.path.join(args.out, 'benchmark.csv')
+    write_rows(results_path, rows)
+    print(f"📊 {len(rows)} configurations in {time.time() - start:.1f} s: {results_path}")
+    if args.profile:
+        if profiles:
+            profile_path = os.path.join(args.out, 'benchmark-profile.csv')
+            write_rows(profile_path, profiles, PROFILE_COLUMNS)
+            print(f"🔬 Per-phase profile: {profile_path}")
+        else:
+            print("⚠️  No profile tables written; is the module configured with -DDTN_PROFILING=ON?")
+
+    if args.update_baseline:
+        write_rows(args.baseline, rows)
+        print(f"📌 Baseline updated: {args.baseline}")
+        return
+    if not os.path.exists(args.baseline):
+        print(f"⚠️  No baseline at {args.baseline}; record one with --update-baseline")
+        return
+    regressions = compare(rows, read_rows(args.baseline), args.tolerance)
+    if regressions:
+        print(f"\n⚠️  {len(regressions)} regressions beyond {100.0 * args.tolerance:.0f}% against {args.baseline}")
+        sys.exit(1)
+    print(f"\n✅ No regressions against {args.baseline}")
+
+if __name__ == "__main__":
+    main()
@@ -17,14 +17,78 @@ import seaborn as sns
 from matplotlib.patches import Circle
 import os
 import re
+import struct
 from datetime import datetime
 
+# Decimated animation written by DtnAnimationRecorder (--animMode=Decimated)
+ANIMATION_HEADER = struct.Struct('<4sHH')  # magic "DTNA", version, record size
+ANIMATION_HEADER_V2 = struct.Struct('<B3x')  # Version 2 on: node type space, reserved
+ANIMATION_RECORD = struct.Struct('<qIBBH8s')  # time ns, node, kind, node type, flags, payload
+ANIMATION_POSITION = struct.Struct('<ff')  # Payload of NODE / POSITION records: x, y
+ANIMATION_EVENT = struct.Struct('<II')  # Payload of bundle events: bundle id, peer
+ANIMATION_KINDS = {0: 'NODE', 1: 'POSITION', 2: 'CREATED', 3: 'FORWARDED', 4: 'DELIVERED'}
+ANIMATION_MOBILE = 0x01
+ANIMATION_TYPES_DTN = 0  # nodeType bytes are DTN NodeType (disaster drivers, version 1 files)
+ANIMATION_TYPES_VISUAL = 1  # nodeType bytes are already the visual node types below
+# The recorder's DTN NodeType onto the visual node types below
+DTN_TO_VISUAL_TYPE = {0: 0, 1: 0, 2: 1, 3: 2, 4: 3, 5: 5, 6: 4, 7: 6}
+
+class AnimationStream:
+    """Reads a .dtna animation chunk by chunk; each chunks() pass resumes where the last one
+    stopped, so a file a running simulation is still writing can be followed"""
+
+    def __init__(self, path, chunk_records=65536):
+        self.path = path
+        self.chunk_records = chunk_records
+        with open(path, 'rb') as f:
+            header = f.read(ANIMATION_HEADER.size)
+            if len(header) < ANIMATION_HEADER.size:
+                raise ValueError(f"{path} is not a DTN animation")
+            magic, self.version, record_size = ANIMATION_HEADER.unpack(header)
+            if magic != b'DTNA':
+                raise ValueError(f"{path} is not a DTN animation")
+            if record_size != ANIMATION_RECORD.size:
+                raise ValueError(f"{path}: {record_size}-byte records, expected {ANIMATION_RECORD.size}")
+            self.offset = ANIMATION_HEADER.size
+            self.type_space = ANIMATION_TYPES_DTN
+            if self.version >= 2:
+                extension = f.read(ANIMATION_HEADER_V2.size)
+                if len(extension) < ANIMATION_HEADER_V2.size:
+                    raise ValueError(f"{path}: truncated header")
+                self.type_space, = ANIMATION_HEADER_V2.unpack(extension)
+                self.offset += ANIMATION_HEADER_V2.size
+
+    def visual_type(self, node_type):
+        """Visual node type of a record's nodeType byte"""
+        if self.type_space == ANIMATION_TYPES_VISUAL:
+            return node_type if 0 <= node_type <= 7 else 7
+        return DTN_TO_VISUAL_TYPE.get(node_type, 7)
+
+    def chunks(self):
+        """Lists of at most chunk_records (time s, node, kind, node type, flags, payload) tuples,
+        up to the last whole record in the file"""
+        size = ANIMATION_RECORD.size
+        with open(self.path, 'rb') as f:
+            f.seek(self.offset)
+            while True:
+                data = f.read(self.chunk_records * size)
+                whole = len(data) // size * size
+                if whole == 0:
+                    return
+                self.offset += whole
+                yield [(time_ns / 1e9, node, kind, node_type, flags, payload)
+                       for time_ns, node, kind, node_type, flags, payload
+                       in ANIMATION_RECORD.iter_unpack(data[:whole])]
+                if whole < len(data):
+                    return  # A record still being written; the next pass picks it up
+
 class DTNNetworkVisualizer:
     def __init__(self):
         """Initialize the DTN Network Visualizer"""
         self.node_positions = {}
         self.message_flows = []
         self.performance_data = {}
+        self.trajectories = {}
         self.node_types = {
             0: {'name': 'Emergency', 'color': '#FF0000', 'size': 8},
             1: {'name': 'Civilian', 'color': '#00FF00', 'size': 6},
@@ -42,10 +106,14 @@ class DTNNetworkVisualizer:
         try:
             # Copy files from ns-3 directory
             os.system("cp ns-3.45/dtn-optimized-performance.txt . 2>/dev/null")
-            os.system("cp ns-3.45/message-flow-tracking.txt . 2>/dev/null")
+            os.system("cp ns-3.45/message-flow-tracking.dtnt . 2>/dev/null")
+            os.system("cp ns-3.45/dtn-animation.dtna . 2>/dev/null")
+            if os.path.exists('message-flow-tracking.dtnt'):
+                os.system("python3 scripts/dtn-trace-to-csv.py message-flow-tracking.dtnt message-flow-tracking.txt")
             
             self.load_node_positions()
             self.load_message_flows()
+            self.load_animation()
             self.load_performance_metrics()
             print("✅ Successfully loaded simulation data")
         except Exception as e:
@@ -93,6 +161,41 @@ class DTNNetworkVisualizer:
         except Exception as e:
             print(f"⚠️  Error loading message flows: {e}")
     
+    def load_animation(self, path='dtn-animation.dtna'):
+        """Final positions, trajectories and bundle events of a decimated animation"""
+        try:
+            if not os.path.exists(path):
+                return
+            stream = AnimationStream(path)
+            flows = []
+            samples = 0
+            for records in stream.chunks():
+                for time, node, kind, node_type, flags, payload in records:
+                    if kind <= 1:
+                        x, y = ANIMATION_POSITION.unpack(payload)
+                        self.node_positions[node] = {
+                            'x': x, 'y': y, 'type': stream.visual_type(node_type),
+                            'is_mobile': bool(flags & ANIMATION_MOBILE)
+                        }
+                        self.trajectories.setdefault(node, []).append((time, x, y))
+                        samples += 1
+                        continue
+                    action = ANIMATION_KINDS.get(kind, 'UNKNOWN')
+                    bundle_id, peer = ANIMATION_EVENT.unpack(payload)
+                    # Same columns as the message-flow trace export
+                    from_node, to_node = {'CREATED': (node, node), 'DELIVERED': (peer, node)}.get(action, (node, peer))
+                    flows.append({
+                        'Time(s)': time, 'BundleID': bundle_id, 'FromNode': from_node,
+                        'ToNode': to_node, 'Action': action, 'NodeType': node_type
+                    })
+            # The full trace, when there is one, has every hop; the animation only bundle events
+            if not self.message_flows:
+                self.message_flows = flows
+            print(f"🎞️  Loaded {samples} position samples of {len(self.trajectories)} nodes "
+                  f"and {len(flows)} bundle events from {path}")
+        except Exception as e:
+            print(f"⚠️  Error loading animation: {e}")
+    
     def load_performance_metrics(self):
         """Load performance metrics"""
         try:
@@ -246,7 +349,9 @@ class DTNNetworkVisualizer:
         
         # Add message flow arrows
         if self.message_flows:
-            for i, flow in enumerate(self.message_flows[:20]):  # Show first 20 flows
+            # Hops of delivered bundles when the trace carries them, else any of the first 20 flows
+            routes = [flow for flow in self.message_flows if flow.get('Action') == 'ROUTE']
+            for i, flow in enumerate((routes or self.message_flows)[:20]):
                 try:
                     from_node = int(flow['FromNode'])
                     to_node = int(flow['ToNode'])
@@ -386,9 +491,13 @@ class DTNNetworkVisualizer:
         ax2.legend()
         ax2.tick_params(axis='x', rotation=45)
         
-        # Spatial distribution heatmap
-        x_coords = [data['x'] for data in self.node_positions.values()]
-        y_coords = [data['y'] for data in self.node_positions.values()]
+        # Spatial distribution heatmap, over every sampled position when there is an animation
+        if self.trajectories:
+            x_coords = [x for samples in self.trajectories.values() for _, x, _ in samples]
+            y_coords = [y for samples in self.trajectories.values() for _, _, y in samples]
+        else:
+            x_coords = [data['x'] for data in self.node_positions.values()]
+            y_coords = [data['y'] for data in self.node_positions.values()]
         
         ax3.hist2d(x_coords, y_coords, bins=20, cmap='Blues', alpha=0.7)
         ax3.set_title('Node Spatial Distribution Heatmap', fontweight='bold')
@@ -0,0 +1,241 @@
+#!/usr/bin/env python3
+"""
+DTN Parameter Sweep - Runs ns-3 DTN scenarios over a parameter grid in parallel
+Every (grid point, run) is an independent replication with its own output directory;
+the SUMMARY_STATISTICS of all runs are merged into one CSV with 95% confidence intervals
+"""
+
+import argparse
+import csv
+import glob
+import itertools
+import math
+import os
+import statistics
+import subprocess
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor, as_completed
+
+# Result file each scenario writes into its --outputDir
+RESULT_FILES = {
+    'dtn-disaster-system': 'dtn-performance-stats.txt',
+    'dtn-optimized-visualization': 'dtn-optimized-performance.txt',
+    'dtn-advanced-routing': 'enhanced-dtn-performance.txt',
+}
+
+# Two-sided 95% Student t quantiles by degrees of freedom; 1.96 beyond the table
+T_95 = [12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042]
+
+def parse_values(text):
+    """'10,20,40' -> ['10','20','40']; '1-5' -> ['1',...,'5']"""
+    values = []
+    for item in text.split(','):
+        if '-' in item and item.replace('-', '').isdigit():
+            low, high = item.split('-')
+            values.extend(str(v) for v in range(int(low), int(high) + 1))
+        elif item:
+            values.append(item)
+    return values
+
+def parse_grid(specs):
+    """['nMobile=10,20', 'simTime=300'] -> [('nMobile', [...]), ('simTime', [...])]"""
+    grid = []
+    for spec in specs:
+        if '=' not in spec:
+            raise ValueError(f"grid parameter '{spec}' is not name=v1,v2,...")
+        name, values = spec.split('=', 1)
+        grid.append((name, parse_values(values)))
+    return grid
+
+def find_binary(ns3_dir, program):
+    """Built example binary, e.g. build/contrib/dtn/examples/ns3.45-dtn-disaster-system-default"""
+    pattern = os.path.join(ns3_dir, 'build', '**', f'ns3*-{program}-*')
+    candidates = [path for path in glob.glob(pattern, recursive=True)
+                  if os.path.isfile(path) and os.access(path, os.X_OK) and not path.endswith('.so')]
+    if not candidates:
+        raise FileNotFoundError(f"no built binary for {program} under {ns3_dir}/build "
+                                f"(./ns3 configure --enable-examples && ./ns3 build)")
+    return max(candidates, key=os.path.getmtime)
+
+def point_label(point):
+    return '_'.join(f"{name}={value}" for name, value in point) or 'default'
+
+def t_quantile(df):
+    return T_95[df - 1] if df <= len(T_95) else 1.96
+
+def parse_summary(path):
+    """Numeric Key,Value lines of every SUMMARY_STATISTICS section"""
+    metrics = {}
+    in_summary = False
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if line == 'SUMMARY_STATISTICS':
+                in_summary = True
+                continue
+            if not line or (line.isupper() and ',' not in line):
+                in_summary = False
+                continue
+            if in_summary and ',' in line:
+                key, value = line.split(',', 1)
+                try:
+                    metrics[key] = float(value)
+                except ValueError:
+                    pass
+    return metrics
+
+def run_replication(binary, program, point, seed, run, fixed, out_dir, timeout):
+    """One ns-3 process; returns (point, seed, run, metrics or None, seconds, error)"""
+    run_dir = os.path.join(out_dir, point_label(point), f"seed-{seed}_run-{run}")
+    os.makedirs(run_dir, exist_ok=True)
+    args = [binary] + [f"--{name}={value}" for name, value in fixed + list(point)]
+    args += [f"--seed={seed}", f"--run={run}", f"--outputDir={run_dir}", "--verbose=false"]
+
+    start = time.time()
+    with open(os.path.join(run_dir, 'stdout.log'), 'w') as log:
+        try:
+            result = subprocess.run(args, stdout=log, stderr=subprocess.STDOUT, timeout=timeout)
+        except subprocess.TimeoutExpired:
+            return point, seed, run, None, time.time() - start, 'timeout'
+    elapsed = time.time() - start
+    if result.returncode != 0:
+        return point, seed, run, None, elapsed, f"exit code {result.returncode}"
+
+    result_path = os.path.join(run_dir, RESULT_FILES[program])
+    if not os.path.exists(result_path):
+        return point, seed, run, None, elapsed, f"missing {RESULT_FILES[program]}"
+    return point, seed, run, parse_summary(result_path), elapsed, None
+
+def write_runs(path, names, results):
+    metric_names = sorted({key for r in results for key in r[3]})
+    with open(path, 'w', newline='') as f:
+        writer = csv.writer(f)
+        writer.writerow(names + ['Seed', 'Run', 'WallTime(s)'] + metric_names)
+        for point, seed, run, metrics, elapsed, _ in sorted(results, key=lambda r: r[:3]):
+            writer.writerow([value for _, value in point] + [seed, run, f"{elapsed:.2f}"]
+                            + [metrics.get(m, '') for m in metric_names])
+
+def write_summary(path, names, points, results):
+    """One row per grid point: replications, then mean/stddev/CI95 per metric"""
+    metric_names = sorted({key for r in results for key in r[3]})
+    by_point = {}
+    for point, _, _, metrics, _, _ in results:
+        by_point.setdefault(point, []).append(metrics)
+
+    with open(path, 'w', newline='') as f:
+        writer = csv.writer(f)
+        header = names + ['Replications']
+        for metric in metric_names:
+            header += [f"{metric}_mean", f"{metric}_stddev", f"{metric}_ci95"]
+        writer.writerow(header)
+
+        for point in points:
+            runs = by_point.get(point)
+            if not runs:
+                continue
+            row = [value for _, value in point] + [len(runs)]
+            for metric in metric_names:
+                samples = [m[metric] for m in runs if metric in m]
+                if not samples:
+                    row += ['', '', '']
+                    continue
+                mean = statistics.fmean(samples)
+                if len(samples) > 1:
+                    stddev = statistics.stdev(samples)
+                    ci = t_quantile(len(samples) - 1) * stddev / math.sqrt(len(samples))
+                else:
+                    stddev = ci = 0.0
+                row += [f"{mean:g}", f"{stddev:g}", f"{ci:g}"]
+            writer.writerow(row)
+
+def write_protocol_metrics(path, names, results):
+    """DTN_METRICS section for dtn-visualization-scripts.py, measured: one row per --routing
+    value, the means over every run with it; nothing unless routing is a grid parameter"""
+    if 'routing' not in names:
+        return False
+    by_protocol = {}
+    for point, _, _, metrics, _, _ in results:
+        by_protocol.setdefault(dict(point)['routing'], []).append(metrics)
+
+    def mean(runs, *keys, scale=1.0):
+        for key in keys:
+            samples = [m[key] for m in runs if key in m]
+            if samples:
+                return statistics.fmean(samples) * scale
+        return 0.0
+
+    with open(path, 'w') as f:
+        f.write("DTN_METRICS\n")
+        f.write("Protocol,Delay(ms),Throughput(Mbps),DeliveryRatio(%),OverheadRatio,Runs\n")
+        for protocol, runs in sorted(by_protocol.items()):
+            delay = mean(runs, 'MedianLatency(s)', scale=1000.0)
+            throughput = mean(runs, 'AverageThroughput(Mbps)') or mean(runs, 'AverageThroughput(Kbps)', scale=1e-3)
+            f.write(f"{protocol},{delay:g},{throughput:g},{mean(runs, 'DeliveryRatio(%)'):g},"
+                    f"{mean(runs, 'OverheadRatio'):g},{len(runs)}\n")
+    return True
+
+def main():
+    parser = argparse.ArgumentParser(description="Parallel ns-3 parameter sweep for the DTN scenarios")
+    parser.add_argument('program', choices=sorted(RESULT_FILES), help="Scenario to sweep")
+    parser.add_argument('-p', '--param', action='append', default=[],
+                        help="Grid parameter name=v1,v2,... (repeatable; the grid is their product)")
+    parser.add_argument('-f', '--fixed', action='append', default=[],
+                        help="Constant argument name=value passed to every run (repeatable)")
+    parser.add_argument('--seeds', default='1', help="Seeds, e.g. 1,2 or 1-3 (default 1)")
+    parser.add_argument('--runs', default='1-10', help="Run numbers per seed, e.g. 1-10 (default)")
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count() or 1,
+                        help="Concurrent ns-3 processes (default: all cores)")
+    parser.add_argument('--ns3-dir', default='ns-3.45', help="ns-3 tree the module is built in")
+    parser.add_argument('--binary', help="Scenario executable (default: found under <ns3-dir>/build)")
+    parser.add_argument('--timeout', type=float, default=None, help="Per-run wall-clock limit in seconds")
+    parser.add_argument('-o', '--out', default='sweep-results', help="Output directory")
+    args = parser.parse_args()
+
+    grid = parse_grid(args.param)
+    fixed = [(name, values[0]) for name, values in parse_grid(args.fixed)]
+    names = [name for name, _ in grid]
+    points = [tuple(zip(names, combo)) for combo in itertools.product(*[values for _, values in grid])]
+    replications = [(int(seed), int(run)) for seed in parse_values(args.seeds) for run in parse_values(args.runs)]
+
+    binary = args.binary or find_binary(args.ns3_dir, args.program)
+    out_dir = os.path.join(args.out, args.program)
+    os.makedirs(out_dir, exist_ok=True)
+
+    jobs = [(point, seed, run) for point in points for seed, run in replications]
+    print(f"🚀 {len(jobs)} runs ({len(points)} grid points x {len(replications)} replications) "
+          f"on {args.jobs} workers: {binary}")
+
+    # Each worker thread only waits on its own ns-3 process, so threads suffice
+    results, failures = [], []
+    start = time.time()
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        futures = [pool.submit(run_replication, binary, args.program, point, seed, run,
+                               fixed, out_dir, args.timeout) for point, seed, run in jobs]
+        for done, future in enumerate(as_completed(futures), 1):
+            point, seed, run, metrics, elapsed, error = future.result()
+            if error:
+                failures.append(future.result())
+                print(f"❌ [{done}/{len(jobs)}] {point_label(point)} seed {seed} run {run}: {error}")
+            else:
+                results.append(future.result())
+                print(f"✅ [{done}/{len(jobs)}] {point_label(point)} seed {seed} run {run} ({elapsed:.1f} s)")
+
+    runs_path = os.path.join(out_dir, 'sweep-runs.csv')
+    summary_path = os.path.join(out_dir, 'sweep-summary.csv')
+    write_runs(runs_path, names, results)
+    write_summary(summary_path, names, points, results)
+    metrics_path = os.path.join(out_dir, 'dtn-protocol-metrics.txt')
+    if write_protocol_metrics(metrics_path, names, results):
+        print(f"📈 Measured protocol comparison: {metrics_path}")
+
+    print(f"📊 {len(results)} runs merged into {summary_path} (per run: {runs_path}) "
+          f"in {time.time() - start:.1f} s")
+    if failures:
+        print(f"⚠️  {len(failures)} runs failed; see stdout.log in their directories")
+        sys.exit(1)
+
+if __name__ == "__main__":
+    main()
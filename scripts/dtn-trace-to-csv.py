@@ -0,0 +1,43 @@
+#!/usr/bin/env python3
+"""
+DTN Trace Export - Converts the binary message-flow trace (.dtnt) to CSV
+Writes the Time(s),BundleID,FromNode,ToNode,Action,NodeType layout the visualizers read
+"""
+
+import struct
+import sys
+
+MAGIC = b'DTNT'
+HEADER = struct.Struct('<4sHH')      # magic, version, record size
+RECORD = struct.Struct('<qIIIBBH')   # time ns, bundle, from, to, action, node type, reserved
+ACTIONS = ['CREATED', 'RECEIVED', 'DELIVERED', 'FORWARDED', 'CONTACT_UP', 'CONTACT_DOWN', 'EVICTED', 'RELEASED', 'PURGED', 'ROUTE']
+CHUNK_RECORDS = 65536
+
+def export_trace(trace_path, csv_path):
+    """Convert trace_path to csv_path; returns the number of records written"""
+    count = 0
+    with open(trace_path, 'rb') as trace, open(csv_path, 'w') as out:
+        magic, version, record_size = HEADER.unpack(trace.read(HEADER.size))
+        if magic != MAGIC or record_size != RECORD.size:
+            raise ValueError(f"{trace_path}: not a DTN trace (version {version}, record size {record_size})")
+
+        out.write("Time(s),BundleID,FromNode,ToNode,Action,NodeType\n")
+        while True:
+            chunk = trace.read(RECORD.size * CHUNK_RECORDS)
+            if not chunk:
+                break
+            usable = len(chunk) - len(chunk) % RECORD.size  # Ignore a torn final record
+            for time_ns, bundle, src, dst, action, node_type, _ in RECORD.iter_unpack(chunk[:usable]):
+                name = ACTIONS[action] if action < len(ACTIONS) else 'UNKNOWN'
+                out.write(f"{time_ns / 1e9:g},{bundle},{src},{dst},{name},{node_type}\n")
+                count += 1
+    return count
+
+if __name__ == "__main__":
+    if len(sys.argv) not in (2, 3):
+        print("Usage: dtn-trace-to-csv.py <trace.dtnt> [output.csv]")
+        sys.exit(1)
+    trace_path = sys.argv[1]
+    csv_path = sys.argv[2] if len(sys.argv) == 3 else trace_path.rsplit('.', 1)[0] + '.txt'
+    records = export_trace(trace_path, csv_path)
+    print(f"✅ Exported {records} trace records to {csv_path}")
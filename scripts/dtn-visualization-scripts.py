@@ -32,7 +32,12 @@ class DTNVisualizationFramework:
     def load_simulation_data(self):
         """Load real simulation data from ns-3 output files"""
         try:
-            if os.path.exists('dtn-performance-stats.txt'):
+            # Measured comparison of a sweep over --routing; a single run only measures its own protocol
+            if os.path.exists('dtn-protocol-metrics.txt'):
+                with open('dtn-protocol-metrics.txt', 'r') as f:
+                    content = f.read()
+                    self.parse_simulation_data(content)
+            elif os.path.exists('dtn-performance-stats.txt'):
                 with open('dtn-performance-stats.txt', 'r') as f:
                     content = f.read()
                     self.parse_simulation_data(content)
@@ -47,34 +52,45 @@ class DTNVisualizationFramework:
         """Parse the simulation output file and extract performance metrics"""
         lines = content.split('\n')
         
-        # Parse DTN metrics section
+        # Parse DTN metrics section (dtn-parameter-sweep.py over --routing)
         dtn_section = False
+        columns = []
+        overheads = {}
         for line in lines:
             if line.strip() == "DTN_METRICS":
                 dtn_section = True
                 continue
-            elif line.strip().startswith("NODE_PERFORMANCE"):
+            elif not line.strip() or (line.strip().isupper() and ',' not in line):
                 dtn_section = False
                 continue
             
-            if dtn_section and ',' in line and not line.startswith('Protocol'):
-                parts = line.strip().split(',')
-                if len(parts) >= 5:
-                    protocol = parts[0]
-                    delay = float(parts[1])
-                    throughput = float(parts[2])
-                    delivery_ratio = float(parts[3])
-                    energy_efficiency = float(parts[4])
-                    
-                    # Convert to our visualization format
-                    self.performance_data[protocol] = {
-                        'delay': delay,
-                        'bandwidth': throughput * 10,  # Scale for visualization
-                        'response': delay * 0.8,  # Response time related to delay
-                        'data_loss': 100 - delivery_ratio,
-                        'energy': 1.0 - energy_efficiency,  # Invert for energy consumption
-                        'scalability': delivery_ratio * 100  # Scale for visualization
-                    }
+            if dtn_section and line.startswith('Protocol'):
+                columns = line.strip().split(',')
+            elif dtn_section and ',' in line:
+                row = dict(zip(columns, line.strip().split(',')))
+                if 'Delay(ms)' not in row:
+                    continue
+                protocol = row['Protocol']
+                delay = float(row['Delay(ms)'])
+                throughput = float(row.get('Throughput(Mbps)', 0))
+                delivery_ratio = float(row.get('DeliveryRatio(%)', 0))
+                overheads[protocol] = float(row.get('OverheadRatio', 0))
+                
+                # Convert to our visualization format
+                self.performance_data[protocol] = {
+                    'delay': delay,
+                    'bandwidth': throughput * 10,  # Scale for visualization
+                    'response': delay * 0.8,  # Response time related to delay
+                    'data_loss': 100 - delivery_ratio,
+                    'energy': 0.0,
+                    'scalability': delivery_ratio * 100  # Scale for visualization
+                }
+        # Radio energy follows transmissions: overhead relative to the costliest protocol
+        highest = max(overheads.values(), default=0.0)
+        for protocol, overhead in overheads.items():
+            self.performance_data[protocol]['energy'] = overhead / highest if highest > 0 else 0.0
+        if self.performance_data:
+            self.protocols = list(self.performance_data)[:len(self.colors)]
         
         # Parse time series data for dynamic visualization
         self.time_series_data = []
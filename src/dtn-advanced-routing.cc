@@ -1,610 +0,0 @@
-/*
- * Advanced DTN Routing with AI/ML Integration
- * Enhanced routing protocols with machine learning and intelligent decision making
- * 
- * Author: Krishnendu
- * Project: Final Year - Advanced DTN Routing System
- */
-
-#include "ns3/core-module.h"
-#include "ns3/network-module.h"
-#include "ns3/mobility-module.h"
-#include "ns3/wifi-module.h"
-#include "ns3/lte-module.h"
-#include "ns3/internet-module.h"
-#include "ns3/applications-module.h"
-#include "ns3/flow-monitor-module.h"
-#include <iostream>
-#include <fstream>
-#include <vector>
-#include <map>
-#include <algorithm>
-#include <cmath>
-#include <random>
-
-using namespace ns3;
-
-NS_LOG_COMPONENT_DEFINE("DTNAdvancedRouting");
-
-// Enhanced Bundle Structure with ML features
-struct EnhancedDTNBundle {
-    uint32_t bundleId;
-    uint32_t sourceNode;
-    uint32_t destinationNode;
-    uint32_t priority;  // 0=Emergency, 1=Medical, 2=General, 3=Low
-    Time creationTime;
-    Time ttl;
-    uint32_t hopCount;
-    std::string payload;
-    bool delivered;
-    
-    // ML Features
-    double urgencyScore;
-    double deliveryProbability;
-    std::vector<uint32_t> routingHistory;
-    double energyCost;
-    uint32_t retransmissionCount;
-    Time lastForwardTime;
-};
-
-// Node Context Information for AI/ML
-struct NodeContext {
-    uint32_t nodeId;
-    NodeType nodeType;
-    Vector position;
-    Vector velocity;
-    double batteryLevel;
-    uint32_t bufferOccupancy;
-    double socialWeight;
-    std::map<uint32_t, double> encounterHistory;
-    std::map<uint32_t, Time> lastContactTime;
-    double trustScore;
-    uint32_t messagesSent;
-    uint32_t messagesReceived;
-    double averageDelay;
-};
-
-// AI/ML Routing Decision Engine
-class MLRoutingEngine {
-public:
-    MLRoutingEngine();
-    ~MLRoutingEngine();
-    
-    double CalculateDeliveryProbability(const EnhancedDTNBundle& bundle, const NodeContext& currentNode, const NodeContext& neighborNode);
-    double CalculateUrgencyScore(const EnhancedDTNBundle& bundle);
-    bool ShouldForwardBundle(const EnhancedDTNBundle& bundle, const NodeContext& currentNode, const NodeContext& neighborNode);
-    void UpdateLearningModel(uint32_t bundleId, bool deliverySuccess, double actualDelay);
-    
-private:
-    // Simple neural network weights (simplified implementation)
-    std::vector<double> m_weights;
-    double m_learningRate;
-    std::map<uint32_t, double> m_deliveryHistory;
-    
-    double Sigmoid(double x);
-    double PredictDeliverySuccess(const std::vector<double>& features);
-    void BackpropagateError(const std::vector<double>& features, double expected, double actual);
-};
-
-MLRoutingEngine::MLRoutingEngine() : m_learningRate(0.01) {
-    // Initialize neural network weights randomly
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dis(-0.5, 0.5);
-    
-    // 8 input features -> 1 output (delivery probability)
-    for (int i = 0; i < 8; ++i) {
-        m_weights.push_back(dis(gen));
-    }
-}
-
-MLRoutingEngine::~MLRoutingEngine() {}
-
-double MLRoutingEngine::Sigmoid(double x) {
-    return 1.0 / (1.0 + std::exp(-x));
-}
-
-double MLRoutingEngine::PredictDeliverySuccess(const std::vector<double>& features) {
-    double sum = 0.0;
-    for (size_t i = 0; i < features.size() && i < m_weights.size(); ++i) {
-        sum += features[i] * m_weights[i];
-    }
-    return Sigmoid(sum);
-}
-
-void MLRoutingEngine::BackpropagateError(const std::vector<double>& features, double expected, double actual) {
-    double error = expected - actual;
-    
-    // Update weights using gradient descent
-    for (size_t i = 0; i < features.size() && i < m_weights.size(); ++i) {
-        m_weights[i] += m_learningRate * error * actual * (1 - actual) * features[i];
-    }
-}
-
-double MLRoutingEngine::CalculateDeliveryProbability(const EnhancedDTNBundle& bundle, 
-                                                   const NodeContext& currentNode, 
-                                                   const NodeContext& neighborNode) {
-    // Extract features for ML prediction
-    std::vector<double> features;
-    
-    // Feature 1: Distance to destination (normalized)
-    double distance = CalculateDistance(neighborNode.position, Vector(0, 0, 0)); // Simplified
-    features.push_back(std::min(1.0, distance / 1000.0));
-    
-    // Feature 2: Node battery level
-    features.push_back(neighborNode.batteryLevel);
-    
-    // Feature 3: Buffer occupancy (normalized)
-    features.push_back(neighborNode.bufferOccupancy / 100.0);
-    
-    // Feature 4: Social weight
-    features.push_back(neighborNode.socialWeight);
-    
-    // Feature 5: Trust score
-    features.push_back(neighborNode.trustScore);
-    
-    // Feature 6: Bundle priority (normalized)
-    features.push_back(bundle.priority / 3.0);
-    
-    // Feature 7: Bundle age (normalized)
-    double age = (Simulator::Now() - bundle.creationTime).GetSeconds();
-    features.push_back(std::min(1.0, age / 3600.0)); // Normalize to 1 hour
-    
-    // Feature 8: Hop count (normalized)
-    features.push_back(std::min(1.0, bundle.hopCount / 10.0));
-    
-    return PredictDeliverySuccess(features);
-}
-
-double MLRoutingEngine::CalculateUrgencyScore(const EnhancedDTNBundle& bundle) {
-    double urgency = 0.0;
-    
-    // Priority-based urgency
-    switch(bundle.priority) {
-        case 0: urgency += 1.0; break;  // Emergency
-        case 1: urgency += 0.8; break; // Medical
-        case 2: urgency += 0.5; break; // General
-        case 3: urgency += 0.2; break; // Low
-    }
-    
-    // Time-based urgency (increases as TTL approaches)
-    double timeRemaining = (bundle.ttl - (Simulator::Now() - bundle.creationTime)).GetSeconds();
-    double totalTTL = bundle.ttl.GetSeconds();
-    urgency += (1.0 - (timeRemaining / totalTTL)) * 0.5;
-    
-    // Retransmission penalty
-    urgency -= bundle.retransmissionCount * 0.1;
-    
-    return std::max(0.0, std::min(1.0, urgency));
-}
-
-bool MLRoutingEngine::ShouldForwardBundle(const EnhancedDTNBundle& bundle, 
-                                        const NodeContext& currentNode, 
-                                        const NodeContext& neighborNode) {
-    double deliveryProb = CalculateDeliveryProbability(bundle, currentNode, neighborNode);
-    double urgency = CalculateUrgencyScore(bundle);
-    
-    // Decision threshold based on urgency and delivery probability
-    double threshold = 0.3 + (urgency * 0.4); // Dynamic threshold
-    
-    return deliveryProb > threshold;
-}
-
-void MLRoutingEngine::UpdateLearningModel(uint32_t bundleId, bool deliverySuccess, double actualDelay) {
-    // Update learning model based on actual delivery results
-    if (m_deliveryHistory.find(bundleId) != m_deliveryHistory.end()) {
-        double predicted = m_deliveryHistory[bundleId];
-        double actual = deliverySuccess ? 1.0 : 0.0;
-        
-        // Simple learning update (would be more sophisticated in real implementation)
-        std::vector<double> dummyFeatures(8, 0.5); // Simplified
-        BackpropagateError(dummyFeatures, actual, predicted);
-    }
-}
-
-// Enhanced DTN Application with AI/ML Routing
-class EnhancedDTNApplication : public Application {
-public:
-    static TypeId GetTypeId(void);
-    EnhancedDTNApplication();
-    virtual ~EnhancedDTNApplication();
-    
-    void SetNodeContext(const NodeContext& context);
-    void SendEnhancedBundle(uint32_t destination, uint32_t priority, std::string payload);
-    void ReceiveEnhancedBundle(const EnhancedDTNBundle& bundle);
-    
-private:
-    virtual void StartApplication(void);
-    virtual void StopApplication(void);
-    
-    void PeriodicUpdate();
-    void IntelligentRouting();
-    void AdaptiveSprayAndWait();
-    void SocialBasedRouting();
-    void EnergyAwareRouting();
-    void UpdateNodeContext();
-    
-    NodeContext m_nodeContext;
-    std::vector<EnhancedDTNBundle> m_enhancedBundleStore;
-    std::map<uint32_t, NodeContext> m_neighborContexts;
-    MLRoutingEngine m_mlEngine;
-    
-    Ptr<Socket> m_socket;
-    uint32_t m_bundleCounter;
-    EventId m_updateEvent;
-    Time m_updateInterval;
-    
-    // Performance metrics
-    uint32_t m_intelligentForwards;
-    uint32_t m_successfulDeliveries;
-    double m_totalEnergyConsumed;
-    std::vector<double> m_deliveryDelays;
-};
-
-TypeId EnhancedDTNApplication::GetTypeId(void) {
-    static TypeId tid = TypeId("EnhancedDTNApplication")
-        .SetParent<Application>()
-        .SetGroupName("Applications")
-        .AddConstructor<EnhancedDTNApplication>();
-    return tid;
-}
-
-EnhancedDTNApplication::EnhancedDTNApplication() 
-    : m_bundleCounter(0),
-      m_updateInterval(Seconds(5.0)),
-      m_intelligentForwards(0),
-      m_successfulDeliveries(0),
-      m_totalEnergyConsumed(0.0) {
-    
-    // Initialize node context with default values
-    m_nodeContext.batteryLevel = 1.0;
-    m_nodeContext.bufferOccupancy = 0;
-    m_nodeContext.socialWeight = 0.5;
-    m_nodeContext.trustScore = 0.8;
-    m_nodeContext.messagesSent = 0;
-    m_nodeContext.messagesReceived = 0;
-    m_nodeContext.averageDelay = 0.0;
-}
-
-EnhancedDTNApplication::~EnhancedDTNApplication() {}
-
-void EnhancedDTNApplication::SetNodeContext(const NodeContext& context) {
-    m_nodeContext = context;
-}
-
-void EnhancedDTNApplication::StartApplication(void) {
-    NS_LOG_FUNCTION(this);
-    
-    // Create socket for enhanced DTN communication
-    m_socket = Socket::CreateSocket(GetNode(), UdpSocketFactory::GetTypeId());
-    InetSocketAddress local = InetSocketAddress(Ipv4Address::GetAny(), 8888);
-    m_socket->Bind(local);
-    
-    // Start periodic updates
-    m_updateEvent = Simulator::Schedule(m_updateInterval, &EnhancedDTNApplication::PeriodicUpdate, this);
-    
-    NS_LOG_INFO("Enhanced DTN Application started on node " << m_nodeContext.nodeId);
-}
-
-void EnhancedDTNApplication::StopApplication(void) {
-    NS_LOG_FUNCTION(this);
-    
-    if (m_updateEvent.IsRunning()) {
-        Simulator::Cancel(m_updateEvent);
-    }
-    
-    if (m_socket) {
-        m_socket->Close();
-        m_socket = 0;
-    }
-    
-    // Log enhanced statistics
-    double avgDelay = 0.0;
-    if (!m_deliveryDelays.empty()) {
-        avgDelay = std::accumulate(m_deliveryDelays.begin(), m_deliveryDelays.end(), 0.0) / m_deliveryDelays.size();
-    }
-    
-    NS_LOG_INFO("Enhanced Node " << m_nodeContext.nodeId << " Final Stats:");
-    NS_LOG_INFO("  Intelligent Forwards: " << m_intelligentForwards);
-    NS_LOG_INFO("  Successful Deliveries: " << m_successfulDeliveries);
-    NS_LOG_INFO("  Average Delay: " << avgDelay << " seconds");
-    NS_LOG_INFO("  Total Energy Consumed: " << m_totalEnergyConsumed << " J");
-}
-
-void EnhancedDTNApplication::SendEnhancedBundle(uint32_t destination, uint32_t priority, std::string payload) {
-    NS_LOG_FUNCTION(this << destination << priority);
-    
-    EnhancedDTNBundle newBundle;
-    newBundle.bundleId = m_bundleCounter++;
-    newBundle.sourceNode = m_nodeContext.nodeId;
-    newBundle.destinationNode = destination;
-    newBundle.priority = priority;
-    newBundle.creationTime = Simulator::Now();
-    newBundle.ttl = Seconds(3600); // 1 hour TTL
-    newBundle.hopCount = 0;
-    newBundle.payload = payload;
-    newBundle.delivered = false;
-    newBundle.urgencyScore = m_mlEngine.CalculateUrgencyScore(newBundle);
-    newBundle.deliveryProbability = 0.5; // Initial estimate
-    newBundle.energyCost = 0.0;
-    newBundle.retransmissionCount = 0;
-    newBundle.lastForwardTime = Simulator::Now();
-    
-    m_enhancedBundleStore.push_back(newBundle);
-    m_nodeContext.messagesSent++;
-    
-    NS_LOG_INFO("Enhanced Bundle " << newBundle.bundleId << " created with urgency " << newBundle.urgencyScore);
-}
-
-void EnhancedDTNApplication::ReceiveEnhancedBundle(const EnhancedDTNBundle& bundle) {
-    NS_LOG_FUNCTION(this);
-    
-    m_nodeContext.messagesReceived++;
-    
-    if (bundle.destinationNode == m_nodeContext.nodeId) {
-        // Bundle delivered successfully
-        m_successfulDeliveries++;
-        double delay = (Simulator::Now() - bundle.creationTime).GetSeconds();
-        m_deliveryDelays.push_back(delay);
-        
-        // Update ML model with successful delivery
-        m_mlEngine.UpdateLearningModel(bundle.bundleId, true, delay);
-        
-        NS_LOG_INFO("Enhanced Bundle " << bundle.bundleId << " delivered to node " << m_nodeContext.nodeId 
-                    << " with delay " << delay << " seconds");
-        return;
-    }
-    
-    // Store bundle for intelligent forwarding
-    if (m_enhancedBundleStore.size() < 200) { // Enhanced buffer size
-        m_enhancedBundleStore.push_back(bundle);
-        m_nodeContext.bufferOccupancy = m_enhancedBundleStore.size();
-        NS_LOG_INFO("Enhanced Bundle " << bundle.bundleId << " stored for intelligent forwarding");
-    }
-}
-
-void EnhancedDTNApplication::PeriodicUpdate() {
-    NS_LOG_FUNCTION(this);
-    
-    UpdateNodeContext();
-    IntelligentRouting();
-    
-    // Schedule next update
-    m_updateEvent = Simulator::Schedule(m_updateInterval, &EnhancedDTNApplication::PeriodicUpdate, this);
-}
-
-void EnhancedDTNApplication::UpdateNodeContext() {
-    // Update mobility information
-    Ptr<MobilityModel> mobility = GetNode()->GetObject<MobilityModel>();
-    if (mobility) {
-        m_nodeContext.position = mobility->GetPosition();
-        m_nodeContext.velocity = mobility->GetVelocity();
-    }
-    
-    // Simulate battery drain
-    m_nodeContext.batteryLevel = std::max(0.0, m_nodeContext.batteryLevel - 0.001);
-    
-    // Update social weight based on encounters
-    double totalEncounters = 0;
-    for (const auto& encounter : m_nodeContext.encounterHistory) {
-        totalEncounters += encounter.second;
-    }
-    m_nodeContext.socialWeight = std::min(1.0, totalEncounters / 100.0);
-    
-    // Update trust score based on successful message deliveries
-    if (m_nodeContext.messagesSent > 0) {
-        m_nodeContext.trustScore = (double)m_successfulDeliveries / m_nodeContext.messagesSent;
-    }
-}
-
-void EnhancedDTNApplication::IntelligentRouting() {
-    NS_LOG_FUNCTION(this);
-    
-    // Perform intelligent routing based on ML predictions
-    for (auto& bundle : m_enhancedBundleStore) {
-        if (!bundle.delivered && (Simulator::Now() - bundle.creationTime) < bundle.ttl) {
-            
-            // Update urgency score
-            bundle.urgencyScore = m_mlEngine.CalculateUrgencyScore(bundle);
-            
-            // Simulate neighbor discovery and intelligent forwarding
-            for (const auto& neighbor : m_neighborContexts) {
-                if (m_mlEngine.ShouldForwardBundle(bundle, m_nodeContext, neighbor.second)) {
-                    
-                    // Calculate energy cost
-                    double energyCost = 0.01 * bundle.payload.length(); // Simplified energy model
-                    
-                    if (m_nodeContext.batteryLevel > energyCost) {
-                        // Forward bundle intelligently
-                        bundle.hopCount++;
-                        bundle.retransmissionCount++;
-                        bundle.lastForwardTime = Simulator::Now();
-                        bundle.energyCost += energyCost;
-                        
-                        m_nodeContext.batteryLevel -= energyCost;
-                        m_totalEnergyConsumed += energyCost;
-                        m_intelligentForwards++;
-                        
-                        NS_LOG_INFO("Intelligent forward of bundle " << bundle.bundleId 
-                                    << " to neighbor " << neighbor.first 
-                                    << " (urgency: " << bundle.urgencyScore << ")");
-                        break; // Forward to one neighbor per cycle
-                    }
-                }
-            }
-        }
-    }
-    
-    // Clean up expired bundles
-    m_enhancedBundleStore.erase(
-        std::remove_if(m_enhancedBundleStore.begin(), m_enhancedBundleStore.end(),
-            [](const EnhancedDTNBundle& bundle) {
-                return (Simulator::Now() - bundle.creationTime) >= bundle.ttl;
-            }),
-        m_enhancedBundleStore.end()
-    );
-    
-    m_nodeContext.bufferOccupancy = m_enhancedBundleStore.size();
-}
-
-void EnhancedDTNApplication::AdaptiveSprayAndWait() {
-    // Adaptive Spray-and-Wait with ML-based copy number optimization
-    for (auto& bundle : m_enhancedBundleStore) {
-        if (!bundle.delivered) {
-            // Calculate optimal number of copies based on urgency and network conditions
-            uint32_t optimalCopies = static_cast<uint32_t>(bundle.urgencyScore * 10) + 1;
-            
-            // Spray phase with intelligent copy distribution
-            if (bundle.retransmissionCount < optimalCopies) {
-                // Continue spraying
-                NS_LOG_DEBUG("Adaptive spray for bundle " << bundle.bundleId);
-            } else {
-                // Wait phase - only forward to nodes with high delivery probability
-                NS_LOG_DEBUG("Wait phase for bundle " << bundle.bundleId);
-            }
-        }
-    }
-}
-
-void EnhancedDTNApplication::SocialBasedRouting() {
-    // Social-based routing using centrality and community detection
-    for (auto& bundle : m_enhancedBundleStore) {
-        if (!bundle.delivered) {
-            // Find socially connected nodes for better delivery probability
-            double maxSocialWeight = 0.0;
-            uint32_t bestSocialNode = 0;
-            
-            for (const auto& neighbor : m_neighborContexts) {
-                if (neighbor.second.socialWeight > maxSocialWeight) {
-                    maxSocialWeight = neighbor.second.socialWeight;
-                    bestSocialNode = neighbor.first;
-                }
-            }
-            
-            if (maxSocialWeight > m_nodeContext.socialWeight) {
-                NS_LOG_DEBUG("Social-based forward to node " << bestSocialNode);
-            }
-        }
-    }
-}
-
-void EnhancedDTNApplication::EnergyAwareRouting() {
-    // Energy-aware routing to extend network lifetime
-    for (auto& bundle : m_enhancedBundleStore) {
-        if (!bundle.delivered && m_nodeContext.batteryLevel > 0.1) { // Reserve 10% battery
-            
-            // Calculate energy-efficient forwarding
-            double energyThreshold = bundle.urgencyScore * 0.1; // Higher urgency allows more energy use
-            
-            if (bundle.energyCost < energyThreshold) {
-                NS_LOG_DEBUG("Energy-efficient forward for bundle " << bundle.bundleId);
-            }
-        }
-    }
-}
-
-// Main simulation for enhanced DTN routing
-int main(int argc, char *argv[]) {
-    LogComponentEnable("DTNAdvancedRouting", LOG_LEVEL_INFO);
-    
-    uint32_t nNodes = 50;
-    double simulationTime = 1200.0; // 20 minutes
-    
-    CommandLine cmd;
-    cmd.AddValue("nNodes", "Number of nodes", nNodes);
-    cmd.AddValue("simTime", "Simulation time", simulationTime);
-    cmd.Parse(argc, argv);
-    
-    NS_LOG_INFO("Starting Enhanced DTN Routing Simulation");
-    NS_LOG_INFO("Nodes: " << nNodes << ", Simulation time: " << simulationTime << " seconds");
-    
-    // Create nodes
-    NodeContainer nodes;
-    nodes.Create(nNodes);
-    
-    // Configure WiFi with enhanced parameters
-    WifiHelper wifi;
-    wifi.SetStandard(WIFI_STANDARD_80211ac);
-    
-    WifiMacHelper wifiMac;
-    wifiMac.SetType("ns3::AdhocWifiMac");
-    
-    YansWifiPhyHelper wifiPhy;
-    YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default();
-    wifiPhy.SetChannel(wifiChannel.Create());
-    wifiPhy.Set("TxPowerStart", DoubleValue(20.0));
-    wifiPhy.Set("TxPowerEnd", DoubleValue(20.0));
-    
-    NetDeviceContainer wifiDevices = wifi.Install(wifiPhy, wifiMac, nodes);
-    
-    // Enhanced mobility model with realistic patterns
-    MobilityHelper mobility;
-    mobility.SetPositionAllocator("ns3::RandomRectanglePositionAllocator",
-                                 "X", StringValue("ns3::UniformRandomVariable[Min=0.0|Max=2000.0]"),
-                                 "Y", StringValue("ns3::UniformRandomVariable[Min=0.0|Max=2000.0]"));
-    
-    mobility.SetMobilityModel("ns3::RandomWaypointMobilityModel",
-                             "Speed", StringValue("ns3::UniformRandomVariable[Min=1.0|Max=30.0]"),
-                             "Pause", StringValue("ns3::ConstantRandomVariable[Constant=5.0]"));
-    
-    mobility.Install(nodes);
-    
-    // Install Internet stack
-    InternetStackHelper internet;
-    internet.Install(nodes);
-    
-    Ipv4AddressHelper ipv4;
-    ipv4.SetBase("192.168.1.0", "255.255.255.0");
-    Ipv4InterfaceContainer interfaces = ipv4.Assign(wifiDevices);
-    
-    // Install enhanced DTN applications
-    for (uint32_t i = 0; i < nodes.GetN(); ++i) {
-        Ptr<EnhancedDTNApplication> app = CreateObject<EnhancedDTNApplication>();
-        
-        NodeContext context;
-        context.nodeId = i;
-        context.nodeType = static_cast<NodeType>(i % 8);
-        context.batteryLevel = 1.0;
-        context.socialWeight = 0.5;
-        context.trustScore = 0.8;
-        
-        app->SetNodeContext(context);
-        nodes.Get(i)->AddApplication(app);
-        app->SetStartTime(Seconds(1.0));
-        app->SetStopTime(Seconds(simulationTime));
-    }
-    
-    // Generate intelligent traffic patterns
-    for (uint32_t i = 0; i < 20; ++i) {
-        Simulator::Schedule(Seconds(10.0 + i * 30.0), [&, i]() {
-            uint32_t source = i % nNodes;
-            uint32_t dest = (i + nNodes/2) % nNodes;
-            uint32_t priority = i % 4;
-            
-            Ptr<EnhancedDTNApplication> app = DynamicCast<EnhancedDTNApplication>(nodes.Get(source)->GetApplication(0));
-            app->SendEnhancedBundle(dest, priority, "Enhanced DTN message " + std::to_string(i));
-        });
-    }
-    
-    // Enable flow monitoring
-    FlowMonitorHelper flowmon;
-    Ptr<FlowMonitor> monitor = flowmon.InstallAll();
-    
-    NS_LOG_INFO("Running enhanced DTN simulation...");
-    
-    Simulator::Stop(Seconds(simulationTime));
-    Simulator::Run();
-    
-    // Generate enhanced performance report
-    std::ofstream reportFile("enhanced-dtn-performance.txt");
-    reportFile << "Enhanced DTN Routing Performance Report\n";
-    reportFile << "======================================\n";
-    reportFile << "Simulation completed successfully with AI/ML integration\n";
-    reportFile << "Advanced routing protocols implemented and tested\n";
-    reportFile.close();
-    
-    NS_LOG_INFO("Enhanced DTN simulation completed successfully!");
-    
-    Simulator::Destroy();
-    return 0;
-}
@@ -0,0 +1,196 @@
+/*
+ * Advanced DTN Routing with AI/ML Integration
+ * Enhanced routing protocols with machine learning and intelligent decision making
+ * 
+ * Author: Krishnendu
+ * Project: Final Year - Advanced DTN Routing System
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/flow-monitor-module.h"
+#include "ns3/dtn-module.h"
+#include <iostream>
+#include <fstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("DTNAdvancedRouting");
+
+// Main simulation for enhanced DTN routing
+int main(int argc, char *argv[]) {
+    LogComponentEnable("DTNAdvancedRouting", LOG_LEVEL_INFO);
+    
+    uint32_t nNodes = 50;
+    double simulationTime = 1200.0; // 20 minutes
+    std::string routing = "Intelligent";
+    uint32_t sprayCopies = 8;
+    bool mlAveraging = true;
+    uint32_t seed = 1;
+    uint64_t run = 1;
+    std::string outputDir = ".";
+    bool verbose = true;
+    double energy = 0.0;
+    uint32_t bufferSize = 200;
+    bool profiling = false;
+    double snapshotAt = 0.0;
+    std::string snapshotFile = "dtn-snapshot.txt";
+    std::string warmStart = "";
+    
+    CommandLine cmd;
+    cmd.AddValue("nNodes", "Number of nodes", nNodes);
+    cmd.AddValue("simTime", "Simulation time", simulationTime);
+    cmd.AddValue("routing", "Routing strategy (Intelligent, Epidemic, Prophet, SprayAndWait)", routing);
+    cmd.AddValue("sprayCopies", "Initial copies per bundle for SprayAndWait", sprayCopies);
+    cmd.AddValue("mlAveraging", "Average ML models between meeting nodes (Intelligent routing)", mlAveraging);
+    cmd.AddValue("seed", "Global random seed (RngSeedManager)", seed);
+    cmd.AddValue("run", "Run number: independent replication under the same seed", run);
+    cmd.AddValue("outputDir", "Existing directory for the result files", outputDir);
+    cmd.AddValue("verbose", "Log every bundle event of the DTN applications", verbose);
+    cmd.AddValue("energy", "Battery of every node in J, drained by its Wi-Fi radio (0 = unlimited)", energy);
+    cmd.AddValue("bufferSize", "Bundles each node can buffer", bufferSize);
+    cmd.AddValue("profile", "Write a per-phase timing table to outputDir/dtn-profile.csv (DTN_PROFILING builds)", profiling);
+    cmd.AddValue("snapshotAt", "Save positions, buffers and ML weights at this time in seconds to outputDir (0 = never)", snapshotAt);
+    cmd.AddValue("snapshotFile", "File name of the snapshot", snapshotFile);
+    cmd.AddValue("warmStart", "Continue from this snapshot instead of simulating up to its time", warmStart);
+    cmd.Parse(argc, argv);
+    
+    if (verbose) {
+        LogComponentEnable("DtnApplication", LOG_LEVEL_INFO);
+        LogComponentEnable("EnhancedDTNApplication", LOG_LEVEL_INFO);
+    }
+    
+    RngSeedManager::SetSeed(seed);
+    RngSeedManager::SetRun(run);
+    
+    DtnHelper dtn("ns3::EnhancedDTNApplication");
+    dtn.SetRoutingStrategy(routing, sprayCopies);
+    dtn.SetAttribute("Port", UintegerValue(8888));
+    dtn.SetAttribute("BufferCapacity", UintegerValue(bufferSize));
+    dtn.SetAttribute("BeaconInterval", TimeValue(Seconds(5.0)));
+    dtn.SetAttribute("ModelAveraging", BooleanValue(mlAveraging));
+    
+    NS_LOG_INFO("Starting Enhanced DTN Routing Simulation");
+    NS_LOG_INFO("Nodes: " << nNodes << ", Simulation time: " << simulationTime << " seconds");
+    NS_LOG_INFO("Routing strategy: " << routing);
+    NS_LOG_INFO("Seed: " << seed << ", Run: " << run);
+    
+    // Create nodes
+    NodeContainer nodes;
+    nodes.Create(nNodes);
+    
+    // Configure WiFi with enhanced parameters
+    NetDeviceContainer wifiDevices = DtnHelper::InstallAdhocWifi(nodes, WIFI_STANDARD_80211ac, 20.0);
+    if (energy > 0.0) {
+        DtnHelper::InstallEnergy(nodes, wifiDevices, energy);
+    }
+    
+    // Enhanced mobility model with realistic patterns
+    DtnHelper::InstallRandomWaypoint(nodes, 2000.0, 1.0, 30.0, 5.0);
+    
+    // Explicit stream numbers keep draws stable when unrelated code adds
+    // random variables; applications take the streams after mobility
+    int64_t stream = 0;
+    stream += MobilityHelper::AssignStreams(nodes, stream);
+    
+    Ipv4InterfaceContainer interfaces = DtnHelper::InstallInternet(nodes, wifiDevices, "192.168.1.0");
+    
+    // Install enhanced DTN applications
+    ApplicationContainer apps = dtn.Install(nodes);
+    for (uint32_t i = 0; i < apps.GetN(); ++i) {
+        DynamicCast<DtnApplication>(apps.Get(i))->SetNodeType(i % 8);
+    }
+    stream += DtnHelper::AssignStreams(apps, stream);
+    
+    // Warm start: trained models and buffers come from the snapshot
+    DtnSnapshot warmSnapshot;
+    Time warmTime = Seconds(0.0);
+    if (!warmStart.empty()) {
+        NS_ABORT_MSG_UNLESS(warmSnapshot.Load(warmStart), "Cannot read snapshot " << warmStart);
+        warmTime = warmSnapshot.GetTime();
+        NS_ABORT_MSG_UNLESS(warmTime < Seconds(simulationTime), "Snapshot " << warmStart << " is past simTime");
+        Simulator::Schedule(warmTime, &DtnSnapshot::Restore, &warmSnapshot, nodes);
+    }
+    apps.Start(std::max(Seconds(1.0), warmTime));
+    apps.Stop(Seconds(simulationTime));
+    
+    // Bundle-level end-to-end metrics
+    Ptr<DtnStatsCollector> collector = CreateObject<DtnStatsCollector>();
+    if (warmTime.IsStrictlyPositive()) {
+        Simulator::Schedule(warmTime, &DtnStatsCollector::Install, collector, apps);
+    } else {
+        collector->Install(apps);
+    }
+    
+    // Generate intelligent traffic patterns; a warm start skips what its snapshot holds
+    for (uint32_t i = 0; i < 20; ++i) {
+        if (Seconds(10.0 + i * 30.0) <= warmTime) {
+            continue;
+        }
+        Simulator::Schedule(Seconds(10.0 + i * 30.0), [&, i]() {
+            uint32_t source = i % nNodes;
+            uint32_t dest = (i + nNodes/2) % nNodes;
+            uint32_t priority = i % 4;
+            
+            Ptr<DtnApplication> app = DynamicCast<DtnApplication>(nodes.Get(source)->GetApplication(0));
+            app->SendBundle(dest, priority, "Enhanced DTN message " + std::to_string(i));
+        });
+    }
+    
+    DtnSnapshot snapshot;
+    if (snapshotAt > 0.0) {
+        NS_ABORT_MSG_UNLESS(Seconds(snapshotAt) > warmTime && snapshotAt <= simulationTime,
+                            "snapshotAt must fall after the start and by simTime");
+        Simulator::Schedule(Seconds(snapshotAt), [&]() {
+            snapshot.Capture(nodes);
+            NS_ABORT_MSG_UNLESS(snapshot.Write(outputDir + "/" + snapshotFile),
+                                "Cannot write snapshot " << outputDir << "/" << snapshotFile);
+        });
+    }
+    
+    // Enable flow monitoring
+    FlowMonitorHelper flowmon;
+    Ptr<FlowMonitor> monitor = flowmon.InstallAll();
+    
+    NS_LOG_INFO("Running enhanced DTN simulation...");
+    
+    if (profiling) {
+        DtnHelper::EnableProfiling(outputDir + "/dtn-profile.csv");
+    }
+    Simulator::Stop(Seconds(simulationTime));
+    DtnRunProfile profile = DtnHelper::Run();
+    
+    // Generate enhanced performance report
+    Ptr<Ipv4FlowClassifier> classifier = DynamicCast<Ipv4FlowClassifier>(flowmon.GetClassifier());
+    
+    std::ofstream reportFile(outputDir + "/enhanced-dtn-performance.txt");
+    reportFile << "Enhanced DTN Routing Performance Report\n";
+    reportFile << "======================================\n";
+    reportFile << "Nodes: " << nNodes << ", Routing: " << routing << "\n\n";
+    
+    DtnFlowSummary flows = DtnHelper::WriteFlowStatistics(monitor, classifier, reportFile);
+    
+    reportFile << "\nSUMMARY_STATISTICS\n";
+    reportFile << "TotalFlows," << flows.flows << "\n";
+    reportFile << "AverageDelay(ms)," << flows.avgDelayMs << "\n";
+    reportFile << "AverageThroughput(Kbps)," << flows.avgThroughput << "\n";
+    reportFile << "AveragePacketLoss(%)," << flows.avgPacketLoss << "\n";
+    reportFile << "DeliveryRatio(%)," << collector->GetDeliveryRatio() << "\n";
+    reportFile << "OverheadRatio," << collector->GetOverheadRatio() << "\n";
+    reportFile << "MedianLatency(s)," << collector->GetLatency().GetQuantile(0.5) << "\n";
+    reportFile << "FirstNodeDepleted(s)," << collector->GetFirstDepletion().GetSeconds() << "\n";
+    DtnHelper::WriteRunProfile(profile, reportFile);
+    
+    reportFile << "\n";
+    collector->WriteEndToEnd(reportFile);
+    reportFile << "\n";
+    collector->WriteEnergy(reportFile);
+    reportFile.close();
+    
+    NS_LOG_INFO("Enhanced DTN simulation completed successfully!");
+    
+    Simulator::Destroy();
+    return 0;
+}
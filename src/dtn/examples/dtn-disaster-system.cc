@@ -0,0 +1,528 @@
+/*
+ * Disaster-Resilient Delay-Tolerant Networking (DTN) System
+ * Advanced implementation with hierarchical nodes, intelligent routing, and disaster simulation
+ * 
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/netanim-module.h"
+#include "ns3/flow-monitor-module.h"
+#include "ns3/dtn-module.h"
+#ifdef NS3_MPI
+#include "ns3/mpi-module.h"
+#endif
+#include <iostream>
+#include <fstream>
+#include <memory>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("DTNDisasterSystem");
+
+// Configure node-specific buffer size and beacon rate
+static void ConfigureNodeType(Ptr<DtnApplication> app, NodeType type, Time sleepSlot, uint32_t bufferOverride) {
+    uint32_t bufferSize = 100;
+    Time beaconInterval = Seconds(10.0);
+    
+    switch(type) {
+        case MOBILE_COMMAND_CENTER:
+            bufferSize = 1000;
+            beaconInterval = Seconds(5.0);
+            break;
+        case EMERGENCY_RESPONDER:
+            bufferSize = 500;
+            beaconInterval = Seconds(7.0);
+            break;
+        case CIVILIAN_DEVICE:
+            bufferSize = 50;
+            beaconInterval = Seconds(15.0);
+            break;
+        case RESCUE_VEHICLE:
+            bufferSize = 800;
+            beaconInterval = Seconds(6.0);
+            break;
+        case AUTONOMOUS_DRONE:
+            bufferSize = 200;
+            beaconInterval = Seconds(3.0);
+            break;
+        case EMERGENCY_SHELTER:
+            bufferSize = 2000;
+            beaconInterval = Seconds(8.0);
+            break;
+        case HOSPITAL_CENTER:
+            bufferSize = 1500;
+            beaconInterval = Seconds(4.0);
+            break;
+        case IOT_SENSOR:
+            bufferSize = 20;
+            beaconInterval = Seconds(30.0);
+            break;
+    }
+    
+    app->SetNodeType(type);
+    app->SetBufferCapacity(bufferOverride ? bufferOverride : bufferSize);
+    app->SetBeaconInterval(beaconInterval);
+    // Sensors and civilian phones sleep between the slots of their duty cycle
+    if (sleepSlot.IsStrictlyPositive()) {
+        app->SetWakeupSchedule(DtnWakeupSchedule::ForNodeType(type, sleepSlot));
+    }
+}
+
+int main(int argc, char *argv[]) {
+    // Enable logging
+    LogComponentEnable("DTNDisasterSystem", LOG_LEVEL_INFO);
+    
+    // Parse command line arguments
+    uint32_t nMobileNodes = 20;
+    uint32_t nStaticNodes = 10;
+    double simulationTime = 600.0; // 10 minutes
+    std::string animFile = "dtn-disaster-animation.xml";
+    std::string animMode = "NetAnim";
+    Time animInterval = Seconds(1.0);
+    std::string routing = "Epidemic";
+    uint32_t sprayCopies = 8;
+    uint32_t seed = 1;
+    uint64_t run = 1;
+    std::string outputDir = ".";
+    bool verbose = true;
+    uint32_t regionRows = 1;
+    uint32_t regionCols = 1;
+    double regionSize = 1000.0;
+    bool distributed = false;
+    double maxRange = 0.0;
+    bool spatialIndex = false;
+    std::string dropPolicy = "DropTail";
+    std::string scheduling = "Strict";
+    bool custody = false;
+    std::string contactPlanFile = "";
+    std::string recordContacts = "";
+    std::string linkRate = "11Mbps";
+    Time linkDelay = MilliSeconds(2);
+    bool cgr = false;
+    std::string cgrPlan = "";
+    double cgrRange = 250.0;
+    double energy = 0.0;
+    bool sleep = false;
+    Time sleepSlot = Seconds(1.0);
+    uint32_t bufferSize = 0;
+    bool profiling = false;
+    double disasterTime = 300.0;
+    std::string failNodes = "0,1,2";
+    double snapshotAt = 0.0;
+    std::string snapshotFile = "dtn-snapshot.txt";
+    std::string warmStart = "";
+    
+    CommandLine cmd;
+    cmd.AddValue("nMobile", "Number of mobile nodes per region", nMobileNodes);
+    cmd.AddValue("nStatic", "Number of static nodes per region (the first is the region gateway)", nStaticNodes);
+    cmd.AddValue("simTime", "Simulation time in seconds", simulationTime);
+    cmd.AddValue("animFile", "NetAnim output file", animFile);
+    cmd.AddValue("animMode", "Animation output (NetAnim: full XML trace, Decimated: sampled positions and bundle events, None)", animMode);
+    cmd.AddValue("animInterval", "Position sampling interval of the Decimated animation", animInterval);
+    cmd.AddValue("routing", "Routing strategy (Epidemic, Prophet, SprayAndWait)", routing);
+    cmd.AddValue("sprayCopies", "Initial copies per bundle for SprayAndWait", sprayCopies);
+    cmd.AddValue("seed", "Global random seed (RngSeedManager)", seed);
+    cmd.AddValue("run", "Run number: independent replication under the same seed", run);
+    cmd.AddValue("outputDir", "Existing directory for the result files", outputDir);
+    cmd.AddValue("verbose", "Log every bundle event of the DTN applications", verbose);
+    cmd.AddValue("regionRows", "Rows of the grid of regions the area is split into", regionRows);
+    cmd.AddValue("regionCols", "Columns of the grid of regions", regionCols);
+    cmd.AddValue("regionSize", "Side of one square region in metres", regionSize);
+    cmd.AddValue("distributed", "Run the regions on MPI ranks (needs ns-3 built with --enable-mpi)", distributed);
+    cmd.AddValue("maxRange", "Hard Wi-Fi range cut-off in metres (0 = propagation loss only)", maxRange);
+    cmd.AddValue("spatialIndex", "Skip receivers beyond maxRange before any PHY work (large node counts)", spatialIndex);
+    cmd.AddValue("dropPolicy", "Full-buffer drop policy (DropTail, LowestPriority, LeastRetention)", dropPolicy);
+    cmd.AddValue("scheduling", "Contact transmit order (Strict, WeightedFair)", scheduling);
+    cmd.AddValue("custody", "Custody transfer: one custodian per bundle, released on a batched ACK", custody);
+    cmd.AddValue("contactPlan", "Replay this contact plan over an abstract link instead of simulating Wi-Fi", contactPlanFile);
+    cmd.AddValue("recordContacts", "Write the contacts of this run to outputDir as a contact plan", recordContacts);
+    cmd.AddValue("linkRate", "Per-node data rate of the contact-plan link", linkRate);
+    cmd.AddValue("linkDelay", "Frame latency of the contact-plan link", linkDelay);
+    cmd.AddValue("cgr", "Contact Graph Routing over permanent contacts between static nodes within cgrRange", cgr);
+    cmd.AddValue("cgrPlan", "Contact plan of scheduled contacts (patrols, recorded runs) for Contact Graph Routing", cgrPlan);
+    cmd.AddValue("cgrRange", "Distance in metres within which static nodes are taken to be in permanent contact", cgrRange);
+    cmd.AddValue("energy", "Battery of every node in J, drained by its Wi-Fi radio (0 = unlimited)", energy);
+    cmd.AddValue("sleep", "Duty-cycle the radios of IoT sensors and civilian devices", sleep);
+    cmd.AddValue("sleepSlot", "Slot length of the duty-cycle wakeup schedules", sleepSlot);
+    cmd.AddValue("bufferSize", "Bundles every node can buffer (0 = per node type, 20 to 2000)", bufferSize);
+    cmd.AddValue("profile", "Write a per-phase timing table to outputDir/dtn-profile.csv (DTN_PROFILING builds)", profiling);
+    cmd.AddValue("disasterTime", "Time in seconds at which region 0's damaged static nodes fail", disasterTime);
+    cmd.AddValue("failNodes", "Comma-separated indices of the static nodes of region 0 that fail", failNodes);
+    cmd.AddValue("snapshotAt", "Save positions and DTN state at this time in seconds to outputDir (0 = never)", snapshotAt);
+    cmd.AddValue("snapshotFile", "File name of the snapshot; ranks other than 0 add -rank<n>", snapshotFile);
+    cmd.AddValue("warmStart", "Continue from this snapshot instead of simulating up to its time", warmStart);
+    cmd.Parse(argc, argv);
+    
+    // Regions are dealt round-robin over the ranks; one process simulates them all otherwise
+    uint32_t rank = 0;
+    uint32_t ranks = 1;
+    if (distributed) {
+#ifdef NS3_MPI
+        GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::DistributedSimulatorImpl"));
+        MpiInterface::Enable(&argc, &argv);
+        rank = MpiInterface::GetSystemId();
+        ranks = MpiInterface::GetSize();
+#else
+        NS_FATAL_ERROR("--distributed needs ns-3 configured with --enable-mpi");
+#endif
+    }
+    
+    DtnRegionHelper regions(regionRows, regionCols, regionSize);
+    regions.SetPartition(rank, ranks);
+    NS_ABORT_MSG_UNLESS(animMode == "NetAnim" || animMode == "Decimated" || animMode == "None",
+                        "Unknown animMode " << animMode);
+    NS_ABORT_MSG_IF(regions.GetNRegions() > 254, "At most 254 regions (one 10.x.0.0/16 each)");
+    
+    std::vector<uint32_t> failedNodes;
+    std::istringstream failList(failNodes);
+    std::string failIndex;
+    while (std::getline(failList, failIndex, ',')) {
+        if (failIndex.empty()) {
+            continue;
+        }
+        failedNodes.push_back(std::stoul(failIndex));
+        NS_ABORT_MSG_UNLESS(failedNodes.back() < nStaticNodes, "failNodes index " << failIndex << " is not below nStatic");
+    }
+    
+    if (verbose) {
+        LogComponentEnable("DtnApplication", LOG_LEVEL_INFO);
+    }
+    
+    RngSeedManager::SetSeed(seed);
+    RngSeedManager::SetRun(run);
+    
+    DtnHelper dtn;
+    dtn.SetRoutingStrategy(routing, sprayCopies);
+    dtn.SetAttribute("DropPolicy", StringValue(dropPolicy));
+    dtn.SetAttribute("TransmitScheduling", StringValue(scheduling));
+    dtn.SetAttribute("CustodyTransfer", BooleanValue(custody));
+    
+    // Predictable contacts get unicast routes, every other destination the routing strategy
+    Ptr<DtnContactGraph> contactGraph;
+    if (cgr || !cgrPlan.empty()) {
+        contactGraph = Create<DtnContactGraph>();
+        if (!cgrPlan.empty()) {
+            DtnContactPlan scheduled;
+            NS_ABORT_MSG_UNLESS(scheduled.Load(cgrPlan), "Cannot read contact plan " << cgrPlan);
+            contactGraph->AddContacts(scheduled);
+        }
+        dtn.SetContactGraph(contactGraph);
+    }
+    
+    NS_LOG_INFO("Starting DTN Disaster System Simulation");
+    NS_LOG_INFO("Regions: " << regionRows << "x" << regionCols << " of " << regionSize << " m, rank "
+                << rank << "/" << ranks);
+    NS_LOG_INFO("Mobile nodes: " << nMobileNodes << ", Static nodes: " << nStaticNodes << " per region");
+    NS_LOG_INFO("Routing strategy: " << routing << ", drop policy: " << dropPolicy
+                << ", scheduling: " << scheduling);
+    NS_LOG_INFO("Seed: " << seed << ", Run: " << run);
+    
+    DtnContactPlan contactPlan;
+    if (!contactPlanFile.empty()) {
+        NS_ABORT_MSG_UNLESS(contactPlan.Load(contactPlanFile), "Cannot read contact plan " << contactPlanFile);
+        NS_LOG_INFO("Contact plan: " << contactPlan.GetSize() << " contacts over a " << linkRate << " link");
+    }
+    
+    // Create nodes: every rank builds every region so node ids agree, but
+    // only the local regions get devices, mobility and applications
+    regions.Create(nMobileNodes, nStaticNodes);
+    NodeContainer localNodes = regions.GetLocalNodes();
+    
+    for (uint32_t r = 0; r < regions.GetNRegions(); ++r) {
+        if (!regions.IsLocal(r)) {
+            continue;
+        }
+        NodeContainer regionNodes = regions.GetNodes(r);
+        Vector origin = regions.GetOrigin(r);
+        
+        // Configure WiFi: one channel per region, or the recorded contacts of its nodes
+        NetDeviceContainer wifiDevices = contactPlanFile.empty()
+            ? DtnHelper::InstallAdhocWifi(regionNodes, WIFI_STANDARD_80211n, 0.0, maxRange, spatialIndex)
+            : DtnHelper::InstallContactPlan(regionNodes, contactPlan, linkRate, linkDelay);
+        if (energy > 0.0) {
+            DtnHelper::InstallEnergy(regionNodes, wifiDevices, energy);
+        }
+        
+        // Mobile nodes - Random Waypoint mobility, static nodes - fixed grid positions
+        DtnHelper::InstallRandomWaypoint(regions.GetMobileNodes(r), regionSize, 1.0, 20.0, 2.0, origin);
+        DtnHelper::InstallGrid(regions.GetStaticNodes(r), 200.0, 5, origin);
+        
+        // Assign IP addresses
+        DtnHelper::InstallInternet(regionNodes, wifiDevices, "10." + std::to_string(r + 1) + ".0.0",
+                                   "255.255.0.0");
+    }
+    
+    // Explicit stream numbers keep draws stable when unrelated code adds random variables
+    MobilityHelper::AssignStreams(localNodes, 0);
+    
+    if (contactGraph && cgr) {
+        for (uint32_t r = 0; r < regions.GetNRegions(); ++r) {
+            if (regions.IsLocal(r)) {
+                contactGraph->AddStaticContacts(regions.GetStaticNodes(r), cgrRange);
+            }
+        }
+        NS_LOG_INFO("Contact graph: " << contactGraph->GetSize() << " scheduled contacts");
+    }
+    
+    // Region gateways relay between neighbouring regions (and ranks)
+    if (regions.GetNRegions() > 1) {
+        regions.InstallGatewayLinks("100Mbps", MilliSeconds(10));
+    }
+    
+    // Install DTN applications
+    ApplicationContainer apps;
+    for (uint32_t r = 0; r < regions.GetNRegions(); ++r) {
+        if (!regions.IsLocal(r)) {
+            continue;
+        }
+        ApplicationContainer regionApps = dtn.Install(regions.GetNodes(r));
+        for (uint32_t i = 0; i < regionApps.GetN(); ++i) {
+            // Assign node types
+            NodeType nodeType;
+            if (i < nMobileNodes) {
+                // Assign different mobile node types
+                nodeType = static_cast<NodeType>(i % 5); // 0-4 are mobile types
+            } else {
+                // Assign static node types
+                nodeType = static_cast<NodeType>(5 + (i - nMobileNodes) % 3); // 5-7 are static types
+            }
+            ConfigureNodeType(DynamicCast<DtnApplication>(regionApps.Get(i)), nodeType,
+                              sleep ? sleepSlot : Seconds(0.0), bufferSize);
+        }
+        apps.Add(regionApps);
+    }
+    
+    // Warm start: the snapshot's state replaces simulating up to its time.
+    // Applications start then and get their state back as they do
+    DtnSnapshot warmSnapshot;
+    Time warmTime = Seconds(0.0);
+    if (!warmStart.empty()) {
+        std::string warmPath = warmStart + (rank == 0 ? std::string() : "-rank" + std::to_string(rank));
+        NS_ABORT_MSG_UNLESS(warmSnapshot.Load(warmPath), "Cannot read snapshot " << warmPath);
+        warmTime = warmSnapshot.GetTime();
+        NS_ABORT_MSG_UNLESS(warmTime < Seconds(simulationTime), "Snapshot " << warmPath << " is past simTime");
+        NS_ABORT_MSG_IF(Seconds(disasterTime) < warmTime,
+                        "disasterTime is before the snapshot; failures up to it are part of the snapshot");
+        Simulator::Schedule(warmTime, &DtnSnapshot::Restore, &warmSnapshot, localNodes);
+        NS_LOG_INFO("Warm start from " << warmPath << " at " << warmTime.GetSeconds() << " s ("
+                    << warmSnapshot.GetBundleCount() << " bundles)");
+    }
+    apps.Start(std::max(Seconds(1.0), warmTime));
+    apps.Stop(Seconds(simulationTime));
+    
+    // Contacts as the applications saw them, for later --contactPlan runs
+    DtnContactPlan recordedPlan;
+    if (!recordContacts.empty()) {
+        recordedPlan.Record(apps);
+    }
+    
+    // Measured per-node counters, latencies and 30 s time series
+    Ptr<DtnStatsCollector> collector = CreateObject<DtnStatsCollector>();
+    collector->SetAttribute("Interval", TimeValue(Seconds(30.0)));
+    if (warmTime.IsStrictlyPositive()) {
+        Simulator::Schedule(warmTime, &DtnStatsCollector::Install, collector, apps);
+    } else {
+        collector->Install(apps);
+    }
+    
+    // Generate some emergency traffic, unless a warm start's snapshot already holds it
+    if (warmTime < Seconds(10.0)) {
+        Simulator::Schedule(Seconds(10.0), [&]() {
+            uint32_t commandCenter = regions.GetMobileNodes(0).Get(0)->GetId();
+            for (uint32_t r = 0; r < regions.GetNRegions(); ++r) {
+                if (!regions.IsLocal(r)) {
+                    continue;
+                }
+                NodeContainer mobileNodes = regions.GetMobileNodes(r);
+            
+                // Emergency responder sends alert to command center (region 0's, across the gateways)
+                Ptr<DtnApplication> responder = DynamicCast<DtnApplication>(mobileNodes.Get(1)->GetApplication(0));
+                responder->SendBundle(commandCenter, 0, "EMERGENCY: Building collapse at coordinates (500,300)");
+            
+                // Civilian device sends help request
+                Ptr<DtnApplication> civilian = DynamicCast<DtnApplication>(mobileNodes.Get(5)->GetApplication(0));
+                civilian->SendBundle(mobileNodes.Get(6)->GetId(), 1, "MEDICAL: Injured person needs immediate assistance");
+            }
+        });
+    }
+    
+    // Simulate disaster scenario - disable some nodes
+    Simulator::Schedule(Seconds(disasterTime), [&]() {
+        if (!regions.IsLocal(0)) {
+            return;
+        }
+        NS_LOG_INFO("DISASTER EVENT: Network infrastructure partially damaged");
+        // Disable some static nodes of region 0 to simulate infrastructure damage
+        for (uint32_t i : failedNodes) {
+            regions.GetStaticNodes(0).Get(i)->GetApplication(0)->SetStopTime(Seconds(disasterTime));
+            // Routes through them are recomputed on their next use
+            if (contactGraph) {
+                contactGraph->RemoveNode(regions.GetStaticNodes(0).Get(i)->GetId());
+            }
+        }
+    });
+    
+    // Shared prefix for --warmStart variants, taken after this instant's traffic and failures
+    DtnSnapshot snapshot;
+    std::string snapshotPath = outputDir + "/" + snapshotFile
+                               + (rank == 0 ? std::string() : "-rank" + std::to_string(rank));
+    if (snapshotAt > 0.0) {
+        NS_ABORT_MSG_UNLESS(Seconds(snapshotAt) > warmTime && snapshotAt <= simulationTime,
+                            "snapshotAt must fall after the start and by simTime");
+        Simulator::Schedule(Seconds(snapshotAt), [&]() {
+            snapshot.Capture(localNodes);
+            NS_ABORT_MSG_UNLESS(snapshot.Write(snapshotPath), "Cannot write snapshot " << snapshotPath);
+            NS_LOG_INFO("Snapshot saved to " << snapshotPath);
+        });
+    }
+    
+    // Enable flow monitor for performance analysis
+    FlowMonitorHelper flowmon;
+    Ptr<FlowMonitor> monitor = flowmon.Install(localNodes);
+    
+    // Enable NetAnim; the trace cannot be split over ranks, so single-process runs only
+    std::unique_ptr<AnimationInterface> anim;
+    if (ranks == 1 && animMode == "NetAnim") {
+        DTN_PROFILE_SCOPE(DTN_PROFILE_ANIMATION_SETUP);
+        anim.reset(new AnimationInterface(outputDir + "/" + animFile));
+        anim->SetMaxPktsPerTraceFile(500000);
+        
+        // Set node descriptions for animation
+        for (uint32_t r = 0; r < regions.GetNRegions(); ++r) {
+            std::string prefix = regions.GetNRegions() > 1 ? "R" + std::to_string(r) + "-" : "";
+            for (uint32_t i = 0; i < nMobileNodes; ++i) {
+                anim->UpdateNodeDescription(regions.GetMobileNodes(r).Get(i), prefix + "Mobile-" + std::to_string(i));
+                anim->UpdateNodeColor(regions.GetMobileNodes(r).Get(i), 255, 0, 0); // Red for mobile
+            }
+            
+            for (uint32_t i = 0; i < nStaticNodes; ++i) {
+                anim->UpdateNodeDescription(regions.GetStaticNodes(r).Get(i), prefix + "Static-" + std::to_string(i));
+                anim->UpdateNodeColor(regions.GetStaticNodes(r).Get(i), 0, 0, 255); // Blue for static
+            }
+        }
+    }
+    
+    // Decimated animation: sampled positions and bundle events, one file per rank
+    Ptr<DtnAnimationRecorder> recorder;
+    std::string animPath = outputDir + "/dtn-animation"
+                           + (rank == 0 ? std::string() : "-rank" + std::to_string(rank)) + ".dtna";
+    if (animMode == "Decimated") {
+        recorder = CreateObject<DtnAnimationRecorder>();
+        recorder->SetAttribute("Interval", TimeValue(animInterval));
+        NS_ABORT_MSG_UNLESS(recorder->Open(animPath), "Cannot write animation " << animPath);
+        if (warmTime.IsStrictlyPositive()) {
+            Simulator::Schedule(warmTime, &DtnAnimationRecorder::Install, recorder, apps);
+        } else {
+            recorder->Install(apps);
+        }
+    }
+    
+    NS_LOG_INFO("Starting simulation for " << simulationTime << " seconds");
+    
+    if (profiling) {
+        DtnHelper::EnableProfiling(outputDir + "/dtn-profile"
+                                   + (rank == 0 ? std::string() : "-rank" + std::to_string(rank)) + ".csv");
+    }
+    
+    // Run simulation
+    Simulator::Stop(Seconds(simulationTime));
+    DtnRunProfile profile = DtnHelper::Run();
+    
+    if (!recordContacts.empty()) {
+        std::string planPath = outputDir + "/" + recordContacts
+                               + (rank == 0 ? std::string() : "-rank" + std::to_string(rank));
+        NS_ABORT_MSG_UNLESS(recordedPlan.Write(planPath), "Cannot write contact plan " << planPath);
+        NS_LOG_INFO("Contact plan saved to " << planPath);
+    }
+    
+    // Generate comprehensive performance statistics
+    Ptr<Ipv4FlowClassifier> classifier = DynamicCast<Ipv4FlowClassifier>(flowmon.GetClassifier());
+    
+    // Each rank reports its own regions; rank 0 keeps the single-process file name
+    std::string statsPath = outputDir + "/dtn-performance-stats"
+                            + (rank == 0 ? std::string() : "-rank" + std::to_string(rank)) + ".txt";
+    std::ofstream statsFile(statsPath);
+    statsFile << "DTN Disaster System Performance Statistics\n";
+    statsFile << "==========================================\n";
+    
+    DtnFlowSummary flows = DtnHelper::WriteFlowStatistics(monitor, classifier, statsFile, DTN_MBPS);
+    uint32_t totalFlows = flows.flows;
+    double avgDelay = flows.avgDelayMs;
+    double avgThroughput = flows.avgThroughput;
+    double avgPacketLoss = flows.avgPacketLoss;
+    
+    statsFile << "\nSUMMARY_STATISTICS\n";
+    statsFile << "TotalFlows," << totalFlows << "\n";
+    statsFile << "AverageDelay(ms)," << avgDelay << "\n";
+    statsFile << "AverageThroughput(Mbps)," << avgThroughput << "\n";
+    statsFile << "AveragePacketLoss(%)," << avgPacketLoss << "\n";
+    DtnApplicationStats totals = collector->GetTotals();
+    statsFile << "BundlesCreated," << totals.bundlesCreated << "\n";
+    statsFile << "BundlesDelivered," << totals.bundlesDelivered << "\n";
+    statsFile << "BundlesDropped," << totals.bundlesDropped << "\n";
+    statsFile << "BundlesEvicted," << totals.bundlesEvicted << "\n";
+    statsFile << "BundlesPurged," << totals.bundlesPurged << "\n";
+    statsFile << "BundleFrames," << totals.framesSent << "\n";
+    statsFile << "BundleFragments," << totals.fragmentsSent << "\n";
+    statsFile << "CustodyReleased," << totals.custodyReleased << "\n";
+    statsFile << "CustodyAcks," << totals.custodyAcksSent << "\n";
+    statsFile << "MedianLatency(s)," << collector->GetLatency().GetQuantile(0.5) << "\n";
+    statsFile << "P95Latency(s)," << collector->GetLatency().GetQuantile(0.95) << "\n";
+    statsFile << "DeliveryRatio(%)," << collector->GetDeliveryRatio() << "\n";
+    statsFile << "CarriedOverDeliveries," << collector->GetCarriedOverDeliveries() << "\n";
+    statsFile << "OverheadRatio," << collector->GetOverheadRatio() << "\n";
+    statsFile << "ForwardsSuppressed," << totals.forwardsSuppressed << "\n";
+    statsFile << "FirstNodeDepleted(s)," << collector->GetFirstDepletion().GetSeconds() << "\n";
+    statsFile << "SleepPeriods," << totals.sleepPeriods << "\n";
+    statsFile << "EmergencyWakeups," << totals.emergencyWakeups << "\n";
+    DtnHelper::WriteRunProfile(profile, statsFile);
+    
+    // Node performance metrics
+    statsFile << "\nNODE_PERFORMANCE\n";
+    collector->WriteNodePerformance(statsFile);
+    
+    statsFile << "\n";
+    collector->WriteLatency(statsFile);
+    
+    // Bundle-level end-to-end metrics across every hop
+    statsFile << "\n";
+    collector->WriteEndToEnd(statsFile);
+    
+    // Network lifetime, and what the duty cycles traded for it
+    statsFile << "\n";
+    collector->WriteEnergy(statsFile);
+    statsFile << "\n";
+    collector->WriteDutyCycle(statsFile);
+    
+    // Time series data for performance over time; kept last for the plotting scripts
+    statsFile << "\nTIME_SERIES_DATA\n";
+    collector->WriteTimeSeries(statsFile);
+    
+    statsFile.close();
+    
+    NS_LOG_INFO("Simulation completed. Results saved to " << statsPath);
+    if (anim) {
+        NS_LOG_INFO("Animation file: " << animFile);
+    }
+    if (recorder) {
+        uint64_t animRecords = recorder->GetRecordCount();
+        recorder->Close();
+        NS_LOG_INFO("Animation file: " << animPath << " (" << animRecords << " records)");
+    }
+    
+    Simulator::Destroy();
+#ifdef NS3_MPI
+    if (distributed) {
+        MpiInterface::Disable();
+    }
+#endif
+    return 0;
+}
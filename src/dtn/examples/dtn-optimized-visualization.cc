@@ -0,0 +1,340 @@
+/*
+ * Optimized DTN System with Node Movement and Message Visualization
+ * High-performance simulation with large node count and real-time tracking
+ * 
+ * Author: Krishnendu
+ * Project: Advanced DTN Visualization System
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/flow-monitor-module.h"
+#include "ns3/netanim-module.h"
+#include "ns3/dtn-module.h"
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <memory>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("DTNOptimizedVisualization");
+
+// Node types for visualization
+enum VisualNodeType {
+    MOBILE_EMERGENCY = 0,
+    MOBILE_CIVILIAN = 1,
+    MOBILE_VEHICLE = 2,
+    MOBILE_DRONE = 3,
+    STATIC_TOWER = 4,
+    STATIC_GATEWAY = 5,
+    STATIC_SENSOR = 6,
+    STATIC_RELAY = 7
+};
+
+int main(int argc, char *argv[]) {
+    LogComponentEnable("DTNOptimizedVisualization", LOG_LEVEL_INFO);
+    
+    // Optimized parameters for performance
+    uint32_t nMobileNodes = 80;
+    uint32_t nStaticNodes = 40;
+    double simulationTime = 300.0;  // 5 minutes; scripts/dtn-benchmark.py scales the node counts
+    std::string routing = "Epidemic";
+    uint32_t sprayCopies = 8;
+    uint32_t seed = 1;
+    uint64_t run = 1;
+    std::string outputDir = ".";
+    bool verbose = true;
+    bool spatialIndex = false;
+    uint32_t traceLevel = DTN_TRACE_DETAIL;
+    uint32_t traceCategories = DTN_TRACE_ALL;
+    std::string dropPolicy = "DropTail";
+    std::string scheduling = "Strict";
+    std::string contactPlanFile = "";
+    std::string recordContacts = "";
+    std::string linkRate = "11Mbps";
+    Time linkDelay = MilliSeconds(2);
+    uint32_t bufferSize = 50;
+    bool profiling = false;
+    std::string animMode = "NetAnim";
+    Time animInterval = Seconds(1.0);
+    
+    CommandLine cmd;
+    cmd.AddValue("mobileNodes", "Number of mobile nodes", nMobileNodes);
+    cmd.AddValue("staticNodes", "Number of static nodes", nStaticNodes);
+    cmd.AddValue("simTime", "Simulation time", simulationTime);
+    cmd.AddValue("routing", "Routing strategy (Epidemic, Prophet, SprayAndWait)", routing);
+    cmd.AddValue("sprayCopies", "Initial copies per bundle for SprayAndWait", sprayCopies);
+    cmd.AddValue("seed", "Global random seed (RngSeedManager)", seed);
+    cmd.AddValue("run", "Run number: independent replication under the same seed", run);
+    cmd.AddValue("outputDir", "Existing directory for the result files", outputDir);
+    cmd.AddValue("verbose", "Log every bundle event of the DTN applications", verbose);
+    cmd.AddValue("traceLevel", "Message flow trace level (0=off, 1=created/delivered, 2=every hop)", traceLevel);
+    cmd.AddValue("traceCategories", "Message flow trace category mask (1=bundles, 2=contacts)", traceCategories);
+    cmd.AddValue("spatialIndex", "Skip receivers beyond the 250 m range before any PHY work (large node counts)", spatialIndex);
+    cmd.AddValue("dropPolicy", "Full-buffer drop policy (DropTail, LowestPriority, LeastRetention)", dropPolicy);
+    cmd.AddValue("scheduling", "Contact transmit order (Strict, WeightedFair)", scheduling);
+    cmd.AddValue("contactPlan", "Replay this contact plan over an abstract link instead of simulating Wi-Fi", contactPlanFile);
+    cmd.AddValue("recordContacts", "Write the contacts of this run to outputDir as a contact plan", recordContacts);
+    cmd.AddValue("linkRate", "Per-node data rate of the contact-plan link", linkRate);
+    cmd.AddValue("linkDelay", "Frame latency of the contact-plan link", linkDelay);
+    cmd.AddValue("bufferSize", "Bundles each node can buffer", bufferSize);
+    cmd.AddValue("animMode", "Animation output (NetAnim: full XML trace, Decimated: sampled positions and bundle events, None)", animMode);
+    cmd.AddValue("animInterval", "Position sampling interval of the Decimated animation", animInterval);
+    cmd.AddValue("profile", "Write a per-phase timing table to outputDir/dtn-profile.csv (DTN_PROFILING builds)", profiling);
+    cmd.Parse(argc, argv);
+    NS_ABORT_MSG_UNLESS(animMode == "NetAnim" || animMode == "Decimated" || animMode == "None",
+                        "Unknown animMode " << animMode);
+    
+    if (verbose) {
+        LogComponentEnable("DtnApplication", LOG_LEVEL_INFO);
+    }
+    
+    RngSeedManager::SetSeed(seed);
+    RngSeedManager::SetRun(run);
+    
+    // Lean nodes: small buffer, frequent beacons, short TTL and at most
+    // five bundles per contact per pass so no single contact floods the channel
+    DtnHelper dtn;
+    dtn.SetRoutingStrategy(routing, sprayCopies);
+    dtn.SetAttribute("BufferCapacity", UintegerValue(bufferSize));
+    dtn.SetAttribute("BeaconInterval", TimeValue(Seconds(2.0)));
+    dtn.SetAttribute("BundleTtl", TimeValue(Seconds(300.0)));
+    dtn.SetAttribute("MaxForwardsPerContact", UintegerValue(5));
+    dtn.SetAttribute("DropPolicy", StringValue(dropPolicy));
+    dtn.SetAttribute("TransmitScheduling", StringValue(scheduling));
+    
+    NS_LOG_INFO("Starting Optimized DTN Visualization");
+    NS_LOG_INFO("Mobile nodes: " << nMobileNodes << ", Static nodes: " << nStaticNodes);
+    NS_LOG_INFO("Simulation time: " << simulationTime << " seconds");
+    NS_LOG_INFO("Routing strategy: " << routing << ", drop policy: " << dropPolicy
+                << ", scheduling: " << scheduling);
+    NS_LOG_INFO("Seed: " << seed << ", Run: " << run);
+    
+    // Binary trace; scripts/dtn-trace-to-csv.py converts it for the visualizers
+    DtnHelper::EnableMessageFlowTrace(outputDir + "/message-flow-tracking.dtnt", traceCategories,
+                                      static_cast<DtnTraceLevel>(std::min<uint32_t>(traceLevel, DTN_TRACE_DETAIL)));
+    
+    // Create nodes
+    NodeContainer mobileNodes, staticNodes, allNodes;
+    mobileNodes.Create(nMobileNodes);
+    staticNodes.Create(nStaticNodes);
+    allNodes.Add(mobileNodes);
+    allNodes.Add(staticNodes);
+    
+    // Optimized WiFi configuration: 250 m hard range at 15 dBm, or a replayed contact plan
+    NetDeviceContainer wifiDevices;
+    if (contactPlanFile.empty()) {
+        wifiDevices = DtnHelper::InstallAdhocWifi(allNodes, WIFI_STANDARD_80211n, 15.0, 250.0, spatialIndex);
+    } else {
+        DtnContactPlan contactPlan;
+        NS_ABORT_MSG_UNLESS(contactPlan.Load(contactPlanFile), "Cannot read contact plan " << contactPlanFile);
+        NS_LOG_INFO("Contact plan: " << contactPlan.GetSize() << " contacts over a " << linkRate << " link");
+        wifiDevices = DtnHelper::InstallContactPlan(allNodes, contactPlan, linkRate, linkDelay);
+    }
+    
+    // Mobile nodes with realistic movement patterns, static nodes in strategic positions
+    DtnHelper::InstallRandomWaypoint(mobileNodes, 1500.0, 2.0, 20.0, 2.0);
+    DtnHelper::InstallGrid(staticNodes, 250.0, 8);
+    
+    // Explicit stream numbers keep draws stable when unrelated code adds random variables
+    MobilityHelper::AssignStreams(allNodes, 0);
+    
+    Ipv4InterfaceContainer interfaces = DtnHelper::InstallInternet(allNodes, wifiDevices, "192.168.1.0");
+    
+    // Install optimized DTN applications
+    ApplicationContainer apps = dtn.Install(allNodes);
+    for (uint32_t i = 0; i < apps.GetN(); ++i) {
+        Ptr<DtnApplication> app = DynamicCast<DtnApplication>(apps.Get(i));
+        
+        VisualNodeType nodeType;
+        if (i < nMobileNodes) {
+            nodeType = static_cast<VisualNodeType>(i % 4);  // Mobile types 0-3
+        } else {
+            nodeType = static_cast<VisualNodeType>(4 + (i % 4));  // Static types 4-7
+        }
+        app->SetNodeType(nodeType);
+    }
+    apps.Start(Seconds(1.0));
+    apps.Stop(Seconds(simulationTime));
+    
+    // Contacts as the applications saw them, for later --contactPlan runs
+    DtnContactPlan recordedPlan;
+    if (!recordContacts.empty()) {
+        recordedPlan.Record(apps);
+    }
+    
+    // Bundle-level end-to-end metrics
+    Ptr<DtnStatsCollector> collector = CreateObject<DtnStatsCollector>();
+    collector->Install(apps);
+    
+    // Generate realistic message traffic
+    for (uint32_t i = 0; i < 30; ++i) {  // Reduced message count for performance
+        Simulator::Schedule(Seconds(5.0 + i * 8.0), [&, i]() {
+            uint32_t source = i % allNodes.GetN();
+            uint32_t dest = (i + allNodes.GetN()/2) % allNodes.GetN();
+            
+            Ptr<DtnApplication> app = DynamicCast<DtnApplication>(allNodes.Get(source)->GetApplication(0));
+            app->SendBundle(dest, 2, "Emergency message " + std::to_string(i));
+        });
+    }
+    
+    // Enhanced NetAnim configuration: every frame and course change, so small runs only
+    std::string animFile = outputDir + "/dtn-optimized-animation.xml";
+    std::unique_ptr<AnimationInterface> anim;
+    if (animMode == "NetAnim") {
+        DTN_PROFILE_SCOPE(DTN_PROFILE_ANIMATION_SETUP);
+        anim.reset(new AnimationInterface(animFile));
+        
+        // Set node descriptions and colors for better visualization
+        for (uint32_t i = 0; i < nMobileNodes; ++i) {
+            VisualNodeType nodeType = static_cast<VisualNodeType>(i % 4);
+            switch(nodeType) {
+                case MOBILE_EMERGENCY:
+                    anim->UpdateNodeDescription(mobileNodes.Get(i), "Emergency-" + std::to_string(i));
+                    anim->UpdateNodeColor(mobileNodes.Get(i), 255, 0, 0);  // Red
+                    anim->UpdateNodeSize(i, 8.0, 8.0);
+                    break;
+                case MOBILE_CIVILIAN:
+                    anim->UpdateNodeDescription(mobileNodes.Get(i), "Civilian-" + std::to_string(i));
+                    anim->UpdateNodeColor(mobileNodes.Get(i), 0, 255, 0);  // Green
+                    anim->UpdateNodeSize(i, 6.0, 6.0);
+                    break;
+                case MOBILE_VEHICLE:
+                    anim->UpdateNodeDescription(mobileNodes.Get(i), "Vehicle-" + std::to_string(i));
+                    anim->UpdateNodeColor(mobileNodes.Get(i), 255, 165, 0);  // Orange
+                    anim->UpdateNodeSize(i, 10.0, 6.0);
+                    break;
+                case MOBILE_DRONE:
+                    anim->UpdateNodeDescription(mobileNodes.Get(i), "Drone-" + std::to_string(i));
+                    anim->UpdateNodeColor(mobileNodes.Get(i), 128, 0, 128);  // Purple
+                    anim->UpdateNodeSize(i, 5.0, 5.0);
+                    break;
+            }
+        }
+    
+        for (uint32_t i = 0; i < nStaticNodes; ++i) {
+            VisualNodeType nodeType = static_cast<VisualNodeType>(4 + (i % 4));
+            uint32_t nodeIndex = nMobileNodes + i;
+            switch(nodeType) {
+                case STATIC_TOWER:
+                    anim->UpdateNodeDescription(staticNodes.Get(i), "Tower-" + std::to_string(i));
+                    anim->UpdateNodeColor(staticNodes.Get(i), 0, 0, 255);  // Blue
+                    anim->UpdateNodeSize(nodeIndex, 15.0, 15.0);
+                    break;
+                case STATIC_GATEWAY:
+                    anim->UpdateNodeDescription(staticNodes.Get(i), "Gateway-" + std::to_string(i));
+                    anim->UpdateNodeColor(staticNodes.Get(i), 0, 255, 255);  // Cyan
+                    anim->UpdateNodeSize(nodeIndex, 12.0, 12.0);
+                    break;
+                case STATIC_SENSOR:
+                    anim->UpdateNodeDescription(staticNodes.Get(i), "Sensor-" + std::to_string(i));
+                    anim->UpdateNodeColor(staticNodes.Get(i), 255, 255, 0);  // Yellow
+                    anim->UpdateNodeSize(nodeIndex, 4.0, 4.0);
+                    break;
+                case STATIC_RELAY:
+                    anim->UpdateNodeDescription(staticNodes.Get(i), "Relay-" + std::to_string(i));
+                    anim->UpdateNodeColor(staticNodes.Get(i), 255, 192, 203);  // Pink
+                    anim->UpdateNodeSize(nodeIndex, 8.0, 8.0);
+                    break;
+            }
+        }
+    }
+    
+    // Decimated alternative: positions every animInterval and bundle events only
+    Ptr<DtnAnimationRecorder> recorder;
+    std::string animPath = outputDir + "/dtn-animation.dtna";
+    if (animMode == "Decimated") {
+        recorder = CreateObject<DtnAnimationRecorder>();
+        recorder->SetAttribute("Interval", TimeValue(animInterval));
+        // Node types here are VisualNodeType values, not DTN NodeType
+        recorder->SetAttribute("NodeTypes", EnumValue<DtnAnimationTypeSpace>(DTN_ANIM_TYPES_VISUAL));
+        NS_ABORT_MSG_UNLESS(recorder->Open(animPath), "Cannot write animation " << animPath);
+        recorder->Install(apps);
+    }
+    
+    // Enable flow monitoring for performance analysis
+    FlowMonitorHelper flowmon;
+    Ptr<FlowMonitor> monitor = flowmon.InstallAll();
+    
+    NS_LOG_INFO("Starting optimized simulation...");
+    
+    if (profiling) {
+        DtnHelper::EnableProfiling(outputDir + "/dtn-profile.csv");
+    }
+    
+    // Run simulation
+    Simulator::Stop(Seconds(simulationTime));
+    DtnRunProfile profile = DtnHelper::Run();
+    
+    if (!recordContacts.empty()) {
+        NS_ABORT_MSG_UNLESS(recordedPlan.Write(outputDir + "/" + recordContacts),
+                            "Cannot write contact plan " << recordContacts);
+    }
+    
+    // Generate comprehensive performance report
+    Ptr<Ipv4FlowClassifier> classifier = DynamicCast<Ipv4FlowClassifier>(flowmon.GetClassifier());
+    
+    std::ofstream statsFile(outputDir + "/dtn-optimized-performance.txt");
+    statsFile << "DTN Optimized Visualization Performance Report\n";
+    statsFile << "============================================\n";
+    statsFile << "Total Nodes: " << allNodes.GetN() << " (Mobile: " << nMobileNodes << ", Static: " << nStaticNodes << ")\n";
+    statsFile << "Simulation Time: " << simulationTime << " seconds\n\n";
+    
+    // Flow statistics
+    DtnFlowSummary flows = DtnHelper::WriteFlowStatistics(monitor, classifier, statsFile);
+    
+    // Summary statistics
+    statsFile << "\nSUMMARY_STATISTICS\n";
+    statsFile << "AverageDelay(ms)," << flows.avgDelayMs << "\n";
+    statsFile << "AverageThroughput(Kbps)," << flows.avgThroughput << "\n";
+    statsFile << "TotalFlows," << flows.flows << "\n";
+    statsFile << "DeliveryRatio(%)," << collector->GetDeliveryRatio() << "\n";
+    statsFile << "OverheadRatio," << collector->GetOverheadRatio() << "\n";
+    statsFile << "MedianLatency(s)," << collector->GetLatency().GetQuantile(0.5) << "\n";
+    DtnHelper::WriteRunProfile(profile, statsFile);
+    
+    statsFile << "\n";
+    collector->WriteEndToEnd(statsFile);
+    
+    // Node position tracking for visualization; kept last for the visualizer
+    statsFile << "\nNODE_POSITIONS\n";
+    statsFile << "NodeID,NodeType,X,Y,Z\n";
+    
+    for (uint32_t i = 0; i < allNodes.GetN(); ++i) {
+        Ptr<MobilityModel> mobility = allNodes.Get(i)->GetObject<MobilityModel>();
+        Vector pos = mobility->GetPosition();
+        
+        VisualNodeType nodeType;
+        if (i < nMobileNodes) {
+            nodeType = static_cast<VisualNodeType>(i % 4);
+        } else {
+            nodeType = static_cast<VisualNodeType>(4 + ((i - nMobileNodes) % 4));
+        }
+        
+        statsFile << i << "," << nodeType << "," << pos.x << "," << pos.y << "," << pos.z << "\n";
+    }
+    
+    statsFile.close();
+    
+    // Write out the buffered tail of the message flow trace
+    uint64_t traceRecords = DtnApplication::GetTrace().GetRecordCount();
+    DtnApplication::GetTrace().Close();
+    
+    NS_LOG_INFO("Optimized simulation completed successfully!");
+    NS_LOG_INFO("Results saved to: " << outputDir << "/dtn-optimized-performance.txt");
+    NS_LOG_INFO("Message flow: " << outputDir << "/message-flow-tracking.dtnt (" << traceRecords << " records)");
+    if (anim) {
+        NS_LOG_INFO("Animation file: " << animFile);
+    }
+    if (recorder) {
+        uint64_t animRecords = recorder->GetRecordCount();
+        recorder->Close();
+        NS_LOG_INFO("Animation file: " << animPath << " (" << animRecords << " records)");
+    }
+    
+    Simulator::Destroy();
+    return 0;
+}
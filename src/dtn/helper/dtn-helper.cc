@@ -0,0 +1,303 @@
+/*
+ * DTN Helper
+ * Installs DTN applications and the scenario plumbing shared by the simulation programs
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "dtn-helper.h"
+#include "ns3/dtn-routing-strategy.h"
+#include "ns3/dtn-contact-channel.h"
+#include "ns3/dtn-spatial-filter.h"
+#include "ns3/dtn-profiler.h"
+#include <chrono>
+#include <map>
+#include <sys/resource.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("DtnHelper");
+
+DtnHelper::DtnHelper(std::string typeId)
+    : m_routing("Epidemic"),
+      m_sprayCopies(8) {
+    m_factory.SetTypeId(typeId);
+}
+
+void DtnHelper::SetAttribute(std::string name, const AttributeValue& value) {
+    m_factory.Set(name, value);
+}
+
+void DtnHelper::SetRoutingStrategy(std::string name, uint32_t sprayCopies) {
+    if (name != "Intelligent" && !CreateRoutingStrategy(name, sprayCopies)) {
+        NS_FATAL_ERROR("Unknown routing strategy: " << name);
+    }
+    m_routing = name;
+    m_sprayCopies = sprayCopies;
+}
+
+void DtnHelper::SetContactGraph(Ptr<DtnContactGraph> graph) {
+    NS_ABORT_MSG_IF(graph && m_routing == "Intelligent", "Contact Graph Routing needs a fallback routing strategy");
+    m_contactGraph = graph;
+}
+
+ApplicationContainer DtnHelper::Install(NodeContainer nodes) const {
+    ApplicationContainer apps;
+    for (NodeContainer::Iterator i = nodes.Begin(); i != nodes.End(); ++i) {
+        apps.Add(Install(*i));
+    }
+    return apps;
+}
+
+ApplicationContainer DtnHelper::Install(Ptr<Node> node) const {
+    Ptr<DtnApplication> app = m_factory.Create<DtnApplication>();
+    app->SetNodeId(node->GetId());
+    // Strategies keep per-node state, so every application gets its own
+    Ptr<RoutingStrategy> strategy = m_routing == "Intelligent" ? Ptr<RoutingStrategy>(0)
+                                                               : CreateRoutingStrategy(m_routing, m_sprayCopies);
+    if (strategy && m_contactGraph) {
+        strategy = Create<ContactGraphStrategy>(m_contactGraph, strategy);
+    }
+    app->SetRoutingStrategy(strategy);
+    node->AddApplication(app);
+    return ApplicationContainer(app);
+}
+
+int64_t DtnHelper::AssignStreams(ApplicationContainer apps, int64_t stream) {
+    int64_t currentStream = stream;
+    for (ApplicationContainer::Iterator i = apps.Begin(); i != apps.End(); ++i) {
+        Ptr<DtnApplication> app = DynamicCast<DtnApplication>(*i);
+        if (app) {
+            currentStream += app->AssignStreams(currentStream);
+        }
+    }
+    return currentStream - stream;
+}
+
+NetDeviceContainer DtnHelper::InstallAdhocWifi(NodeContainer nodes, WifiStandard standard,
+                                               double txPowerDbm, double maxRange, bool spatialIndex) {
+    WifiHelper wifi;
+    wifi.SetStandard(standard);
+
+    WifiMacHelper wifiMac;
+    wifiMac.SetType("ns3::AdhocWifiMac");
+
+    if (spatialIndex) {
+        NS_ABORT_MSG_IF(maxRange <= 0.0, "The spatial index needs a maximum range");
+
+        // Same propagation as the Yans default plus the range cut-off
+        Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel>();
+        channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+        Ptr<RangePropagationLossModel> range = CreateObject<RangePropagationLossModel>();
+        range->SetAttribute("MaxRange", DoubleValue(maxRange));
+        channel->AddPropagationLossModel(range);
+        channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+        Ptr<DtnSpatialFilter> filter = CreateObject<DtnSpatialFilter>();
+        filter->SetAttribute("MaxRange", DoubleValue(maxRange));
+        filter->Add(nodes);
+        channel->AddSpectrumTransmitFilter(filter);
+
+        SpectrumWifiPhyHelper wifiPhy;
+        wifiPhy.SetChannel(channel);
+        if (txPowerDbm != 0.0) {
+            wifiPhy.Set("TxPowerStart", DoubleValue(txPowerDbm));
+            wifiPhy.Set("TxPowerEnd", DoubleValue(txPowerDbm));
+        }
+        return wifi.Install(wifiPhy, wifiMac, nodes);
+    }
+
+    YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default();
+    if (maxRange > 0.0) {
+        wifiChannel.SetPropagationDelay("ns3::ConstantSpeedPropagationDelayModel");
+        wifiChannel.AddPropagationLoss("ns3::RangePropagationLossModel", "MaxRange", DoubleValue(maxRange));
+    }
+
+    YansWifiPhyHelper wifiPhy;
+    wifiPhy.SetChannel(wifiChannel.Create());
+    if (txPowerDbm != 0.0) {
+        wifiPhy.Set("TxPowerStart", DoubleValue(txPowerDbm));
+        wifiPhy.Set("TxPowerEnd", DoubleValue(txPowerDbm));
+    }
+
+    return wifi.Install(wifiPhy, wifiMac, nodes);
+}
+
+NetDeviceContainer DtnHelper::InstallContactPlan(NodeContainer nodes, const DtnContactPlan& plan,
+                                                std::string dataRate, Time delay) {
+    Ptr<DtnContactChannel> channel = CreateObject<DtnContactChannel>();
+    channel->SetAttribute("Delay", TimeValue(delay));
+
+    SimpleNetDeviceHelper link;
+    link.SetDeviceAttribute("DataRate", DataRateValue(DataRate(dataRate)));
+    NetDeviceContainer devices = link.Install(nodes, channel);
+    channel->Replay(plan);
+    return devices;
+}
+
+energy::EnergySourceContainer DtnHelper::InstallEnergy(NodeContainer nodes, NetDeviceContainer devices,
+                                                       double initialJoules) {
+    BasicEnergySourceHelper battery;
+    battery.Set("BasicEnergySourceInitialEnergyJ", DoubleValue(initialJoules));
+    battery.Set("BasicEnergySourceLowBatteryThreshold", DoubleValue(0.0));
+    energy::EnergySourceContainer sources = battery.Install(nodes);
+
+    WifiRadioEnergyModelHelper radio;
+    uint32_t radios = 0;
+    for (uint32_t i = 0; i < devices.GetN(); ++i) {
+        Ptr<NetDevice> device = devices.Get(i);
+        Ptr<energy::EnergySourceContainer> own = device->GetNode()->GetObject<energy::EnergySourceContainer>();
+        if (DynamicCast<WifiNetDevice>(device) && own && own->GetN() > 0) {
+            radio.Install(device, own->Get(0));
+            radios++;
+        }
+    }
+    NS_LOG_INFO("Installed " << initialJoules << " J on " << sources.GetN() << " nodes, " << radios
+                << " radios drawing from them");
+    return sources;
+}
+
+Ipv4InterfaceContainer DtnHelper::InstallInternet(NodeContainer nodes, NetDeviceContainer devices,
+                                                  std::string network, std::string mask) {
+    InternetStackHelper internet;
+    internet.Install(nodes);
+
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase(network.c_str(), mask.c_str());
+    return ipv4.Assign(devices);
+}
+
+void DtnHelper::InstallRandomWaypoint(NodeContainer nodes, double area, double minSpeed,
+                                      double maxSpeed, double pause, Vector origin) {
+    std::string x = "ns3::UniformRandomVariable[Min=" + std::to_string(origin.x)
+                    + "|Max=" + std::to_string(origin.x + area) + "]";
+    std::string y = "ns3::UniformRandomVariable[Min=" + std::to_string(origin.y)
+                    + "|Max=" + std::to_string(origin.y + area) + "]";
+
+    // One allocator for initial positions and waypoints, so nodes keep
+    // roaming the whole area instead of the allocator's unit-square default
+    ObjectFactory positionFactory;
+    positionFactory.SetTypeId("ns3::RandomRectanglePositionAllocator");
+    positionFactory.Set("X", StringValue(x));
+    positionFactory.Set("Y", StringValue(y));
+    Ptr<PositionAllocator> positions = positionFactory.Create<PositionAllocator>();
+
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator(positions);
+    mobility.SetMobilityModel("ns3::RandomWaypointMobilityModel",
+                              "Speed", StringValue("ns3::UniformRandomVariable[Min=" + std::to_string(minSpeed)
+                                                   + "|Max=" + std::to_string(maxSpeed) + "]"),
+                              "Pause", StringValue("ns3::ConstantRandomVariable[Constant=" + std::to_string(pause) + "]"),
+                              "PositionAllocator", PointerValue(positions));
+    mobility.Install(nodes);
+}
+
+void DtnHelper::InstallGrid(NodeContainer nodes, double spacing, uint32_t width, Vector origin) {
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                  "MinX", DoubleValue(origin.x),
+                                  "MinY", DoubleValue(origin.y),
+                                  "DeltaX", DoubleValue(spacing),
+                                  "DeltaY", DoubleValue(spacing),
+                                  "GridWidth", UintegerValue(width),
+                                  "LayoutType", StringValue("RowFirst"));
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(nodes);
+}
+
+void DtnHelper::EnableMessageFlowTrace(std::string path, uint32_t categories, DtnTraceLevel level) {
+    DtnApplication::GetTrace().Open(path, categories, level);
+}
+
+void DtnHelper::EnableProfiling(std::string path) {
+    DtnProfiler::Get().ReportAtDestroy(path);
+}
+
+DtnRunProfile DtnHelper::Run(void) {
+    uint64_t eventsBefore = Simulator::GetEventCount();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+
+    DtnRunProfile profile;
+    profile.wallSeconds = wall.count();
+    profile.events = Simulator::GetEventCount() - eventsBefore;
+    DtnProfiler::Get().AddRunTime(profile.wallSeconds);
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+        profile.peakRssMb = usage.ru_maxrss / (1024.0 * 1024.0);  // Bytes
+#else
+        profile.peakRssMb = usage.ru_maxrss / 1024.0;  // KiB
+#endif
+    }
+    NS_LOG_INFO("Simulated " << profile.events << " events in " << profile.wallSeconds << " s ("
+                << profile.GetEventsPerSecond() << " events/s), peak RSS " << profile.peakRssMb << " MB");
+    return profile;
+}
+
+void DtnHelper::WriteRunProfile(const DtnRunProfile& profile, std::ostream& os) {
+    os << "WallClock(s)," << profile.wallSeconds << "\n";
+    os << "SimulatorEvents," << profile.events << "\n";
+    os << "EventsPerSecond," << profile.GetEventsPerSecond() << "\n";
+    os << "PeakRSS(MB)," << profile.peakRssMb << "\n";
+}
+
+DtnFlowSummary DtnHelper::WriteFlowStatistics(Ptr<FlowMonitor> monitor, Ptr<Ipv4FlowClassifier> classifier,
+                                              std::ostream& os, DtnThroughputUnit unit) {
+    monitor->CheckForLostPackets();
+    std::map<FlowId, FlowMonitor::FlowStats> stats = monitor->GetFlowStats();
+    double scale = unit == DTN_MBPS ? 1024.0 * 1024.0 : 1024.0;
+
+    os << "FLOW_STATISTICS\n";
+    os << "FlowID,Source,Destination,TxPackets,RxPackets,Throughput("
+       << (unit == DTN_MBPS ? "Mbps" : "Kbps") << "),Delay(ms),PacketLoss(%)\n";
+
+    double totalDelay = 0.0;
+    double totalThroughput = 0.0;
+    double totalPacketLoss = 0.0;
+    DtnFlowSummary summary;
+
+    for (std::map<FlowId, FlowMonitor::FlowStats>::const_iterator i = stats.begin(); i != stats.end(); ++i) {
+        Ipv4FlowClassifier::FiveTuple t = classifier->FindFlow(i->first);
+
+        double throughput = 0.0;
+        double delay = 0.0;
+        double packetLoss = 0.0;
+
+        if (i->second.rxPackets > 0) {
+            if (i->second.timeLastRxPacket.GetSeconds() > i->second.timeFirstTxPacket.GetSeconds()) {
+                throughput = i->second.rxBytes * 8.0 / (i->second.timeLastRxPacket.GetSeconds() - i->second.timeFirstTxPacket.GetSeconds()) / scale;
+            }
+            delay = i->second.delaySum.GetMilliSeconds() / i->second.rxPackets;
+        }
+
+        if (i->second.txPackets > 0) {
+            packetLoss = ((double)(i->second.txPackets - i->second.rxPackets) / i->second.txPackets) * 100.0;
+        }
+
+        os << i->first << ","
+           << t.sourceAddress << ","
+           << t.destinationAddress << ","
+           << i->second.txPackets << ","
+           << i->second.rxPackets << ","
+           << throughput << ","
+           << delay << ","
+           << packetLoss << "\n";
+
+        totalDelay += delay;
+        totalThroughput += throughput;
+        totalPacketLoss += packetLoss;
+        summary.flows++;
+    }
+
+    if (summary.flows > 0) {
+        summary.avgDelayMs = totalDelay / summary.flows;
+        summary.avgThroughput = totalThroughput / summary.flows;
+        summary.avgPacketLoss = totalPacketLoss / summary.flows;
+    }
+    return summary;
+}
+
+} // namespace ns3
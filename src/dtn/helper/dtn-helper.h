@@ -0,0 +1,142 @@
+/*
+ * DTN Helper
+ * Installs DTN applications and the scenario plumbing shared by the simulation programs
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#ifndef DTN_HELPER_H
+#define DTN_HELPER_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/spectrum-module.h"
+#include "ns3/flow-monitor-module.h"
+#include "ns3/energy-module.h"
+#include "ns3/dtn-application.h"
+#include "ns3/dtn-trace.h"
+#include "ns3/dtn-contact-plan.h"
+#include "ns3/dtn-contact-graph.h"
+#include <ostream>
+#include <string>
+
+namespace ns3 {
+
+// Per-flow averages of a FLOW_STATISTICS table
+struct DtnFlowSummary {
+    DtnFlowSummary()
+        : flows(0),
+          avgDelayMs(0.0),
+          avgThroughput(0.0),
+          avgPacketLoss(0.0) {
+    }
+
+    uint32_t flows;
+    double avgDelayMs;
+    double avgThroughput;  // In the unit the table was written in
+    double avgPacketLoss;  // %
+};
+
+// Cost of one Simulator::Run(), for the scalability benchmarks
+struct DtnRunProfile {
+    DtnRunProfile()
+        : wallSeconds(0.0),
+          events(0),
+          peakRssMb(0.0) {
+    }
+
+    double GetEventsPerSecond(void) const { return wallSeconds > 0.0 ? events / wallSeconds : 0.0; }
+
+    double wallSeconds;
+    uint64_t events;   // Simulator events executed
+    double peakRssMb;  // Of the whole process so far, setup included
+};
+
+enum DtnThroughputUnit {
+    DTN_KBPS,
+    DTN_MBPS
+};
+
+/*
+ * Installs one DtnApplication (or a subclass, by TypeId name) per node.
+ * Attributes set here apply to every application installed afterwards;
+ * each node gets its own routing strategy instance and its ns-3 node id
+ * as DTN node id. Node types and per-node settings stay with the driver.
+ *
+ * The static members wrap the channel, addressing, mobility and report
+ * boilerplate the scenario programs have in common.
+ */
+class DtnHelper {
+public:
+    DtnHelper(std::string typeId = "ns3::DtnApplication");
+
+    void SetAttribute(std::string name, const AttributeValue& value);
+    // Epidemic, Prophet, SprayAndWait, or Intelligent (no strategy: the
+    // application routes on its own, see EnhancedDTNApplication)
+    void SetRoutingStrategy(std::string name, uint32_t sprayCopies = 8);
+    // Contact Graph Routing over graph wherever it has a route, the routing
+    // strategy elsewhere; not with Intelligent. Null turns it off again
+    void SetContactGraph(Ptr<DtnContactGraph> graph);
+
+    ApplicationContainer Install(NodeContainer nodes) const;
+    ApplicationContainer Install(Ptr<Node> node) const;
+
+    // Fixes the random streams of every DTN application; returns how many
+    static int64_t AssignStreams(ApplicationContainer apps, int64_t stream);
+
+    // Ad hoc Wi-Fi on one shared channel; txPowerDbm 0 keeps the PHY
+    // default, maxRange > 0 adds a hard range cut-off in metres.
+    // spatialIndex (needs maxRange) switches to a spectrum channel whose
+    // DtnSpatialFilter skips receivers out of range before any PHY work
+    static NetDeviceContainer InstallAdhocWifi(NodeContainer nodes, WifiStandard standard,
+                                               double txPowerDbm = 0.0, double maxRange = 0.0,
+                                               bool spatialIndex = false);
+    // Abstract link in place of Wi-Fi: the nodes hear each other only
+    // during their contacts in plan, at dataRate per node after delay
+    static NetDeviceContainer InstallContactPlan(NodeContainer nodes, const DtnContactPlan& plan,
+                                                 std::string dataRate = "11Mbps", Time delay = MilliSeconds(2));
+    // A battery of initialJoules on every node, drained by the Wi-Fi radio
+    // of its device in devices (other devices draw nothing); the DTN
+    // applications started afterwards pick it up. The source fires no
+    // depletion of its own: the radio works until the battery is empty
+    // and the applications keep their own reserve (LowBatteryThreshold)
+    static energy::EnergySourceContainer InstallEnergy(NodeContainer nodes, NetDeviceContainer devices,
+                                                       double initialJoules);
+    static Ipv4InterfaceContainer InstallInternet(NodeContainer nodes, NetDeviceContainer devices,
+                                                  std::string network, std::string mask = "255.255.255.0");
+    // Random waypoint inside origin + [0, area]^2; waypoints are drawn from the same square
+    static void InstallRandomWaypoint(NodeContainer nodes, double area, double minSpeed,
+                                      double maxSpeed, double pause, Vector origin = Vector());
+    static void InstallGrid(NodeContainer nodes, double spacing, uint32_t width, Vector origin = Vector());
+
+    // Opens the message-flow trace shared by every DTN application
+    static void EnableMessageFlowTrace(std::string path, uint32_t categories, DtnTraceLevel level);
+    // Per-phase profile table (model/dtn-profiler.h), logged and written to
+    // path at Simulator::Destroy(); needs a DTN_PROFILING build and the
+    // devices installed
+    static void EnableProfiling(std::string path);
+
+    // Simulator::Run(), timed
+    static DtnRunProfile Run(void);
+    // WallClock(s), SimulatorEvents, EventsPerSecond and PeakRSS(MB) lines
+    // of a SUMMARY_STATISTICS section
+    static void WriteRunProfile(const DtnRunProfile& profile, std::ostream& os);
+
+    // Writes the FLOW_STATISTICS section and returns its per-flow averages
+    static DtnFlowSummary WriteFlowStatistics(Ptr<FlowMonitor> monitor, Ptr<Ipv4FlowClassifier> classifier,
+                                              std::ostream& os, DtnThroughputUnit unit = DTN_KBPS);
+
+private:
+    ObjectFactory m_factory;
+    std::string m_routing;
+    uint32_t m_sprayCopies;
+    Ptr<DtnContactGraph> m_contactGraph;
+};
+
+} // namespace ns3
+
+#endif // DTN_HELPER_H
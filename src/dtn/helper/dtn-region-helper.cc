@@ -0,0 +1,106 @@
+/*
+ * DTN Region Helper
+ * Partitions a disaster area into geographic regions for distributed (MPI) simulation
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "dtn-region-helper.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("DtnRegionHelper");
+
+DtnRegionHelper::DtnRegionHelper(uint32_t rows, uint32_t cols, double regionSize)
+    : m_rows(rows),
+      m_cols(cols),
+      m_regionSize(regionSize),
+      m_rank(0),
+      m_ranks(1) {
+    NS_ABORT_MSG_IF(rows == 0 || cols == 0, "DtnRegionHelper needs at least one region");
+}
+
+void DtnRegionHelper::SetPartition(uint32_t rank, uint32_t ranks) {
+    NS_ABORT_MSG_IF(ranks == 0 || rank >= ranks, "Invalid partition " << rank << "/" << ranks);
+    NS_ABORT_MSG_IF(ranks > GetNRegions(), ranks << " ranks for only " << GetNRegions() << " regions");
+    m_rank = rank;
+    m_ranks = ranks;
+}
+
+void DtnRegionHelper::Create(uint32_t mobilePerRegion, uint32_t staticPerRegion) {
+    // The gateway is a static node, and the links need one per region
+    NS_ABORT_MSG_IF(staticPerRegion == 0 && GetNRegions() > 1, "Regions need a static gateway node");
+
+    m_mobile.assign(GetNRegions(), NodeContainer());
+    m_static.assign(GetNRegions(), NodeContainer());
+    for (uint32_t region = 0; region < GetNRegions(); ++region) {
+        m_mobile[region].Create(mobilePerRegion, GetSystemId(region));
+        m_static[region].Create(staticPerRegion, GetSystemId(region));
+    }
+    NS_LOG_INFO(GetNRegions() << " regions of " << mobilePerRegion + staticPerRegion
+                << " nodes over " << m_ranks << " ranks");
+}
+
+Vector DtnRegionHelper::GetOrigin(uint32_t region) const {
+    return Vector((region % m_cols) * m_regionSize, (region / m_cols) * m_regionSize, 0.0);
+}
+
+NodeContainer DtnRegionHelper::GetNodes(uint32_t region) const {
+    return NodeContainer(m_mobile[region], m_static[region]);
+}
+
+NodeContainer DtnRegionHelper::GetLocalNodes(void) const {
+    NodeContainer nodes;
+    for (uint32_t region = 0; region < GetNRegions(); ++region) {
+        if (IsLocal(region)) {
+            nodes.Add(GetNodes(region));
+        }
+    }
+    return nodes;
+}
+
+NetDeviceContainer DtnRegionHelper::InstallGatewayLinks(std::string dataRate, Time delay,
+                                                        std::string network) {
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue(dataRate));
+    p2p.SetChannelAttribute("Delay", TimeValue(delay));
+
+    InternetStackHelper internet;
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase(network.c_str(), "255.255.255.252");
+
+    // Every rank builds every link, so link n gets the same subnet everywhere;
+    // links between two remote gateways are never simulated here
+    NetDeviceContainer devices;
+    for (uint32_t region = 0; region < GetNRegions(); ++region) {
+        std::vector<uint32_t> neighbors;
+        if (region % m_cols + 1 < m_cols) {
+            neighbors.push_back(region + 1);
+        }
+        if (region / m_cols + 1 < m_rows) {
+            neighbors.push_back(region + m_cols);
+        }
+
+        for (uint32_t neighbor : neighbors) {
+            Ptr<Node> a = GetGateway(region);
+            Ptr<Node> b = GetGateway(neighbor);
+            for (Ptr<Node> gateway : {a, b}) {
+                if (!gateway->GetObject<Ipv4>()) {
+                    internet.Install(gateway);
+                }
+            }
+
+            // Crossing ranks, the helper builds a remote channel
+            NetDeviceContainer link = p2p.Install(a, b);
+            ipv4.Assign(link);
+            ipv4.NewNetwork();
+            devices.Add(link);
+            NS_LOG_DEBUG("Gateway link region " << region << " (rank " << GetSystemId(region)
+                         << ") - region " << neighbor << " (rank " << GetSystemId(neighbor) << ")");
+        }
+    }
+    return devices;
+}
+
+} // namespace ns3
@@ -0,0 +1,77 @@
+/*
+ * DTN Region Helper
+ * Partitions a disaster area into geographic regions for distributed (MPI) simulation
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#ifndef DTN_REGION_HELPER_H
+#define DTN_REGION_HELPER_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/*
+ * Splits the area into a rows x cols grid of square regions, each owned by
+ * one simulation process (rank): regions are dealt round-robin over the
+ * ranks and every node of a region carries its rank as system id.
+ *
+ * Every process builds the same node list in the same order, so node ids
+ * (the DTN node ids) and addresses agree across ranks; only the nodes of
+ * local regions should get devices, mobility and applications. A wireless
+ * channel cannot span ranks, so each region gets its own Wi-Fi channel and
+ * static node 0 of each region, its gateway, is linked point-to-point to
+ * the gateways of the neighbouring regions. Those links are the only
+ * inter-region paths and, where they cross ranks, the distributed
+ * simulator's lookahead.
+ */
+class DtnRegionHelper {
+public:
+    DtnRegionHelper(uint32_t rows, uint32_t cols, double regionSize);
+
+    // This process's rank and the number of ranks; defaults to one process
+    void SetPartition(uint32_t rank, uint32_t ranks);
+
+    // Creates each region's mobile nodes, then its static nodes, region by region
+    void Create(uint32_t mobilePerRegion, uint32_t staticPerRegion);
+
+    uint32_t GetNRegions(void) const { return m_rows * m_cols; }
+    double GetRegionSize(void) const { return m_regionSize; }
+    uint32_t GetSystemId(uint32_t region) const { return region % m_ranks; }
+    bool IsLocal(uint32_t region) const { return GetSystemId(region) == m_rank; }
+    // South-west corner of the region
+    Vector GetOrigin(uint32_t region) const;
+
+    NodeContainer GetMobileNodes(uint32_t region) const { return m_mobile[region]; }
+    NodeContainer GetStaticNodes(uint32_t region) const { return m_static[region]; }
+    // Mobile nodes, then static nodes
+    NodeContainer GetNodes(uint32_t region) const;
+    Ptr<Node> GetGateway(uint32_t region) const { return m_static[region].Get(0); }
+    NodeContainer GetLocalNodes(void) const;
+
+    // Links every gateway to its east and south neighbour, one /30 per link
+    // from network. Gateways still without an Internet stack (those of
+    // remote regions) get one, so install the local regions' stacks first.
+    NetDeviceContainer InstallGatewayLinks(std::string dataRate, Time delay,
+                                           std::string network = "172.16.0.0");
+
+private:
+    uint32_t m_rows;
+    uint32_t m_cols;
+    double m_regionSize;
+    uint32_t m_rank;
+    uint32_t m_ranks;
+    std::vector<NodeContainer> m_mobile;
+    std::vector<NodeContainer> m_static;
+};
+
+} // namespace ns3
+
+#endif // DTN_REGION_HELPER_H
@@ -0,0 +1,1284 @@
+/*
+ * DTN Application
+ * Store-carry-forward node: beacons, summary-vector exchange, bundle buffer and routing passes
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "dtn-application.h"
+#include "dtn-profiler.h"
+#include "ns3/wifi-module.h"
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("DtnApplication");
+
+NS_OBJECT_ENSURE_REGISTERED(DtnApplication);
+
+TypeId DtnApplication::GetTypeId(void) {
+    static TypeId tid = TypeId("ns3::DtnApplication")
+        .SetParent<Application>()
+        .SetGroupName("Dtn")
+        .AddConstructor<DtnApplication>()
+        .AddAttribute("Port", "UDP port of the DTN socket",
+                      UintegerValue(9999),
+                      MakeUintegerAccessor(&DtnApplication::m_port),
+                      MakeUintegerChecker<uint16_t>())
+        .AddAttribute("BufferCapacity", "Bundles the store-and-forward buffer holds",
+                      UintegerValue(100),
+                      MakeUintegerAccessor(&DtnApplication::SetBufferCapacity,
+                                           &DtnApplication::GetBufferCapacity),
+                      MakeUintegerChecker<uint32_t>(1))
+        .AddAttribute("BeaconInterval", "Period of the neighbour discovery beacon",
+                      TimeValue(Seconds(10.0)),
+                      MakeTimeAccessor(&DtnApplication::m_beaconInterval),
+                      MakeTimeChecker(MilliSeconds(1)))
+        .AddAttribute("BundleTtl", "Lifetime of bundles created on this node",
+                      TimeValue(Seconds(3600.0)),
+                      MakeTimeAccessor(&DtnApplication::m_bundleTtl),
+                      MakeTimeChecker())
+        .AddAttribute("MaxForwardsPerContact",
+                      "Bundles pushed to one contact per routing pass (0 = unlimited); "
+                      "the rest follow in a pass one second later",
+                      UintegerValue(0),
+                      MakeUintegerAccessor(&DtnApplication::m_maxForwardsPerContact),
+                      MakeUintegerChecker<uint32_t>())
+        .AddAttribute("DropPolicy", "What a full buffer gives up for a new bundle",
+                      EnumValue<DtnDropPolicy>(DTN_DROP_TAIL),
+                      MakeEnumAccessor<DtnDropPolicy>(&DtnApplication::m_dropPolicy),
+                      MakeEnumChecker(DTN_DROP_TAIL, "DropTail",
+                                      DTN_DROP_LOWEST_PRIORITY, "LowestPriority",
+                                      DTN_DROP_LEAST_RETENTION, "LeastRetention"))
+        .AddAttribute("TransmitScheduling", "Order in which a contact's eligible bundles are sent",
+                      EnumValue<DtnTransmitScheduling>(DTN_SCHEDULE_STRICT),
+                      MakeEnumAccessor<DtnTransmitScheduling>(&DtnApplication::m_transmitScheduling),
+                      MakeEnumChecker(DTN_SCHEDULE_STRICT, "Strict",
+                                      DTN_SCHEDULE_WEIGHTED_FAIR, "WeightedFair"))
+        .AddAttribute("MaxFrameSize",
+                      "UDP payload bytes per bundle datagram; larger bundles are fragmented "
+                      "(default: 1500-byte IP MTU less IP and UDP headers); at least 128, "
+                      "above the largest fragment overhead",
+                      UintegerValue(1472),
+                      MakeUintegerAccessor(&DtnApplication::m_maxFrameSize),
+                      MakeUintegerChecker<uint32_t>(128, 65507))
+        .AddAttribute("Aggregation", "Pack bundles for the same contact into one datagram",
+                      BooleanValue(true),
+                      MakeBooleanAccessor(&DtnApplication::m_aggregation),
+                      MakeBooleanChecker())
+        .AddAttribute("Vaccination",
+                      "Drop held copies of bundles reported delivered and refuse new ones",
+                      BooleanValue(true),
+                      MakeBooleanAccessor(&DtnApplication::m_vaccination),
+                      MakeBooleanChecker())
+        .AddAttribute("CustodyTransfer",
+                      "Hand each bundle to one contact at a time and release it once custody is acknowledged",
+                      BooleanValue(false),
+                      MakeBooleanAccessor(&DtnApplication::m_custodyTransfer),
+                      MakeBooleanChecker())
+        .AddAttribute("CustodyTimeout", "Wait for a custody ACK before offering the bundle to other contacts",
+                      TimeValue(Seconds(10.0)),
+                      MakeTimeAccessor(&DtnApplication::m_custodyTimeout),
+                      MakeTimeChecker(MilliSeconds(1)))
+        .AddAttribute("CustodyAckDelay", "Custody accepted within this window is acknowledged in one ACK per peer",
+                      TimeValue(MilliSeconds(100)),
+                      MakeTimeAccessor(&DtnApplication::m_custodyAckDelay),
+                      MakeTimeChecker(Seconds(0.0)))
+        .AddAttribute("TxEnergyPerByte",
+                      "Radio energy a transmitted byte is expected to cost (J), the forwarding "
+                      "decisions' estimate; the energy model charges the real airtime",
+                      DoubleValue(2e-6),
+                      MakeDoubleAccessor(&DtnApplication::m_txEnergyPerByte),
+                      MakeDoubleChecker<double>(0.0))
+        .AddAttribute("LowBatteryThreshold",
+                      "Fraction of the initial energy below which a node only hands bundles to "
+                      "their destination and stops relaying",
+                      DoubleValue(0.1),
+                      MakeDoubleAccessor(&DtnApplication::m_lowBatteryThreshold),
+                      MakeDoubleChecker<double>(0.0, 1.0))
+        .AddAttribute("SleepGuard",
+                      "Under a wakeup schedule, how long the radio waits after its last beacon of "
+                      "an awake slot for a peer to answer before it sleeps",
+                      TimeValue(MilliSeconds(50)),
+                      MakeTimeAccessor(&DtnApplication::m_sleepGuard),
+                      MakeTimeChecker(Seconds(0.0)))
+        .AddAttribute("SleepLinger",
+                      "Under a wakeup schedule, how long the radio stays on after a contact opens "
+                      "or a bundle or summary vector is exchanged",
+                      TimeValue(Seconds(2.0)),
+                      MakeTimeAccessor(&DtnApplication::m_sleepLinger),
+                      MakeTimeChecker(Seconds(0.0)))
+        .AddTraceSource("BundleCreated", "A bundle was generated here, whether or not the buffer took it",
+                        MakeTraceSourceAccessor(&DtnApplication::m_createdTrace),
+                        "ns3::DtnApplication::BundleTracedCallback")
+        .AddTraceSource("BundleDelivered", "A bundle reached this node, its destination",
+                        MakeTraceSourceAccessor(&DtnApplication::m_deliveredTrace),
+                        "ns3::DtnApplication::BundleTracedCallback")
+        .AddTraceSource("BundleForwarded", "A copy of a bundle was sent from this node to a neighbour",
+                        MakeTraceSourceAccessor(&DtnApplication::m_forwardedTrace),
+                        "ns3::DtnApplication::ForwardTracedCallback")
+        .AddTraceSource("ContactUp", "A node entered this node's neighbour table",
+                        MakeTraceSourceAccessor(&DtnApplication::m_contactUpTrace),
+                        "ns3::DtnApplication::ContactTracedCallback")
+        .AddTraceSource("ContactDown", "A neighbour timed out of this node's neighbour table",
+                        MakeTraceSourceAccessor(&DtnApplication::m_contactDownTrace),
+                        "ns3::DtnApplication::ContactTracedCallback");
+    return tid;
+}
+
+DtnApplication::DtnApplication()
+    : m_nodeId(0),
+      m_nodeType(CIVILIAN_DEVICE),
+      m_bundleStore(100),
+      m_routingStrategy(Create<EpidemicStrategy>()),
+      m_beaconInterval(Seconds(10.0)),
+      m_port(9999),
+      m_bundleTtl(Seconds(3600.0)),
+      m_maxForwardsPerContact(0),
+      m_dropPolicy(DTN_DROP_TAIL),
+      m_transmitScheduling(DTN_SCHEDULE_STRICT),
+      m_maxFrameSize(1472),
+      m_aggregation(true),
+      m_vaccination(true),
+      m_custodyTransfer(false),
+      m_custodyTimeout(Seconds(10.0)),
+      m_custodyAckDelay(MilliSeconds(100)),
+      m_txEnergyPerByte(2e-6),
+      m_lowBatteryThreshold(0.1),
+      m_sleepGuard(MilliSeconds(50)),
+      m_sleepLinger(Seconds(2.0)),
+      m_bundleCounter(0),
+      m_statePending(false) {
+    m_rng = CreateObject<UniformRandomVariable>();
+}
+
+DtnApplication::~DtnApplication() {
+}
+
+void DtnApplication::DoDispose(void) {
+    m_socket = 0;
+    m_rng = 0;
+    m_energySource = 0;
+    m_phys.clear();
+    Application::DoDispose();
+}
+
+void DtnApplication::SetNodeId(uint32_t nodeId) {
+    m_nodeId = nodeId;
+    if (m_routingStrategy) {
+        m_routingStrategy->SetNodeId(nodeId);
+    }
+}
+
+void DtnApplication::SetRoutingStrategy(Ptr<RoutingStrategy> strategy) {
+    m_routingStrategy = strategy;
+    if (m_routingStrategy) {
+        m_routingStrategy->SetNodeId(m_nodeId);
+    }
+}
+
+int64_t DtnApplication::AssignStreams(int64_t stream) {
+    m_rng->SetStream(stream);
+    return 1;
+}
+
+DtnTraceWriter& DtnApplication::GetTrace(void) {
+    static DtnTraceWriter trace;
+    return trace;
+}
+
+DtnPayloadPool& DtnApplication::GetPayloadPool(void) {
+    static DtnPayloadPool pool;
+    static bool clearScheduled = false;
+    // Bundle keys restart with every simulation, so the pool goes with it
+    if (!clearScheduled) {
+        Simulator::ScheduleDestroy([]() {
+            pool.Clear();
+            clearScheduled = false;
+        });
+        clearScheduled = true;
+    }
+    return pool;
+}
+
+void DtnApplication::StartApplication(void) {
+    NS_LOG_FUNCTION(this);
+
+    // First source DtnHelper::InstallEnergy (or any EnergySourceHelper) aggregated to the node
+    if (!m_energySource) {
+        Ptr<energy::EnergySourceContainer> sources = GetNode()->GetObject<energy::EnergySourceContainer>();
+        if (sources && sources->GetN() > 0) {
+            m_energySource = sources->Get(0);
+        }
+    }
+
+    m_socket = Socket::CreateSocket(GetNode(), UdpSocketFactory::GetTypeId());
+    InetSocketAddress local = InetSocketAddress(Ipv4Address::GetAny(), m_port);
+    m_socket->Bind(local);
+    m_socket->SetAllowBroadcast(true);
+    m_socket->SetRecvCallback(MakeCallback(&DtnApplication::HandleRead, this));
+
+    // Routing runs on contact changes and buffer changes only; the beacon is
+    // the one periodic event, staggered by node id within one interval to
+    // avoid collisions
+    m_neighbors.SetContactUpCallback(MakeCallback(&DtnApplication::ContactUp, this));
+    m_neighbors.SetContactDownCallback(MakeCallback(&DtnApplication::ContactDown, this));
+    int64_t intervalMs = std::max<int64_t>(1, m_beaconInterval.GetMilliSeconds());
+    m_beaconEvent = Simulator::Schedule(MilliSeconds((m_nodeId * 100) % intervalMs),
+                                        &DtnApplication::SendBeacon, this);
+    ScheduleExpiry();
+
+    // Duty-cycled radio: a random slot phase per node, there is no common clock
+    if (!m_wakeupSchedule.IsAlwaysOn()) {
+        m_phys.clear();
+        for (uint32_t i = 0; i < GetNode()->GetNDevices(); ++i) {
+            Ptr<WifiNetDevice> wifi = DynamicCast<WifiNetDevice>(GetNode()->GetDevice(i));
+            if (wifi) {
+                m_phys.push_back(wifi->GetPhy());
+            }
+        }
+        m_sleepScheduler.SetWakeCallback(MakeCallback(&DtnApplication::RadioWake, this));
+        m_sleepScheduler.SetSleepCallback(MakeCallback(&DtnApplication::RadioSleep, this));
+        m_sleepScheduler.SetSlotEdgeCallback(MakeCallback(&DtnApplication::SlotEdge, this));
+        m_sleepScheduler.SetHoldCallback(MakeCallback(&DtnApplication::HoldAwake, this));
+        double cycle = m_wakeupSchedule.GetSlot().GetSeconds() * m_wakeupSchedule.GetPrimeA()
+                       * m_wakeupSchedule.GetPrimeB();
+        m_sleepScheduler.Start(m_wakeupSchedule, Seconds(cycle * m_rng->GetValue()), m_sleepGuard);
+    }
+
+    if (m_statePending) {
+        m_statePending = false;
+        ApplyState(m_pendingState);
+        m_pendingState = DtnApplicationState();
+    }
+
+    NS_LOG_INFO("DTN Application started on node " << m_nodeId << " (Type: " << m_nodeType << ")");
+}
+
+void DtnApplication::StopApplication(void) {
+    NS_LOG_FUNCTION(this);
+
+    Simulator::Cancel(m_beaconEvent);
+    Simulator::Cancel(m_routingEvent);
+    Simulator::Cancel(m_expiryEvent);
+    Simulator::Cancel(m_flushEvent);
+    Simulator::Cancel(m_custodyAckEvent);
+    Simulator::Cancel(m_custodyRetryEvent);
+    Simulator::Cancel(m_phyEvent);
+    m_sleepScheduler.Stop();
+    m_neighbors.Clear();
+    m_pendingFrames.clear();
+    m_reassembly.clear();
+    m_pendingAcks.clear();
+
+    if (m_socket) {
+        m_socket->Close();
+        m_socket = 0;
+    }
+
+    NS_LOG_INFO("Node " << m_nodeId << " Final Stats - Sent: " << m_stats.bundlesCreated
+                << ", Received: " << m_stats.bundlesReceived
+                << ", Delivered: " << m_stats.bundlesDelivered
+                << ", Forwarded: " << m_stats.bundlesForwarded
+                << ", Dropped: " << m_stats.bundlesDropped
+                << ", Duplicates: " << m_stats.duplicatesDropped
+                << ", Frames: " << m_stats.framesSent
+                << ", Custody released: " << m_stats.custodyReleased
+                << ", Purged: " << m_stats.bundlesPurged
+                << ", Contacts: " << m_stats.contacts
+                << ", Awake: " << 100.0 * GetAwakeFraction() << "%");
+}
+
+void DtnApplication::HandleRead(Ptr<Socket> socket) {
+    NS_LOG_FUNCTION(this << socket);
+    DTN_PROFILE_SCOPE(DTN_PROFILE_HANDLE_READ);
+
+    Ptr<Packet> packet;
+    Address from;
+    while ((packet = socket->RecvFrom(from))) {
+        // Only a Wi-Fi PHY really sleeps; frames of any other device are ignored while asleep
+        if (!m_sleepScheduler.IsAwake()) {
+            continue;
+        }
+        DtnTypeHeader typeHeader;
+        if (packet->GetSize() < typeHeader.GetSerializedSize()) {
+            continue;
+        }
+        packet->RemoveHeader(typeHeader);
+        if (!typeHeader.IsValid()) {
+            NS_LOG_WARN("Unknown DTN message type at node " << m_nodeId);
+            continue;
+        }
+
+        switch (typeHeader.GetType()) {
+            case DTN_BUNDLE:
+                HandleBundle(packet, from);
+                break;
+            case DTN_SUMMARY_VECTOR:
+                HandleSummaryVector(packet, from);
+                break;
+            case DTN_BEACON:
+                HandleBeacon(packet, from);
+                break;
+            case DTN_BUNDLE_BATCH:
+                HandleBatch(packet, from);
+                break;
+            case DTN_BUNDLE_FRAGMENT:
+                HandleFragment(packet, from);
+                break;
+            case DTN_CUSTODY_ACK:
+                HandleCustodyAck(packet, from);
+                break;
+        }
+    }
+}
+
+void DtnApplication::HandleBundle(Ptr<Packet> packet, const Address& from) {
+    NS_LOG_FUNCTION(this << packet);
+
+    DtnBundleHeader header;
+    if (packet->GetSize() < header.GetSerializedSize()) {
+        NS_LOG_WARN("Malformed bundle of " << packet->GetSize() << " bytes at node " << m_nodeId);
+        return;
+    }
+
+    // Strip the bundle header; what remains in the packet is the payload
+    packet->RemoveHeader(header);
+    if (!header.IsValid()) {
+        NS_LOG_WARN("Malformed bundle route path at node " << m_nodeId);
+        return;
+    }
+    AcceptBundle(header, packet, from);
+}
+
+void DtnApplication::HandleBatch(Ptr<Packet> packet, const Address& from) {
+    NS_LOG_FUNCTION(this << packet);
+
+    DtnRecordHeader record;
+    while (packet->GetSize() >= record.GetSerializedSize()) {
+        packet->RemoveHeader(record);
+        if (record.GetLength() > packet->GetSize()) {
+            NS_LOG_WARN("Truncated bundle batch at node " << m_nodeId);
+            return;
+        }
+        // The fragment shares the frame's buffer, no payload copy
+        Ptr<Packet> bundle = packet->CreateFragment(0, record.GetLength());
+        packet->RemoveAtStart(record.GetLength());
+        HandleBundle(bundle, from);
+    }
+}
+
+void DtnApplication::HandleFragment(Ptr<Packet> packet, const Address& from) {
+    NS_LOG_FUNCTION(this << packet);
+
+    DtnBundleHeader header;
+    DtnFragmentHeader fragment;
+    if (packet->GetSize() < header.GetSerializedSize() + fragment.GetSerializedSize()) {
+        NS_LOG_WARN("Malformed bundle fragment of " << packet->GetSize() << " bytes at node " << m_nodeId);
+        return;
+    }
+    packet->RemoveHeader(header);
+    if (!header.IsValid() || packet->GetSize() < fragment.GetSerializedSize()) {
+        NS_LOG_WARN("Malformed bundle fragment route path at node " << m_nodeId);
+        return;
+    }
+    packet->RemoveHeader(fragment);
+
+    // Nothing to reassemble for a bundle already stored or delivered here;
+    // the sender still learns we hold it
+    uint64_t key = MakeBundleKey(header.GetSourceNode(), header.GetBundleId());
+    if (m_seenBundles.Contains(key)) {
+        DtnNeighbor* neighbor = m_neighbors.FindByAddress(InetSocketAddress::ConvertFrom(from).GetIpv4());
+        if (neighbor) {
+            neighbor->exchangedKeys.insert(key);
+        }
+        AcknowledgeCustody(header, from);
+        return;
+    }
+
+    auto it = m_reassembly.find(key);
+    if (it == m_reassembly.end()) {
+        ExpireReassemblies(Simulator::Now());
+        Reassembly& entry = m_reassembly[key];
+        entry.header = header;
+        entry.slices = DtnReassembly(fragment.GetTotalLength());
+        entry.expiry = header.GetCreationTime() + header.GetTtl();
+        it = m_reassembly.find(key);
+    }
+    Reassembly& entry = it->second;
+    if (fragment.GetTotalLength() != entry.slices.GetTotalLength()) {
+        NS_LOG_WARN("Bundle fragment length mismatch at node " << m_nodeId);
+        return;
+    }
+    if (!entry.slices.AddSlice(fragment.GetOffset(), packet)) {
+        NS_LOG_WARN("Bundle fragment past the end of its bundle at node " << m_nodeId);
+        return;
+    }
+    if (!entry.slices.IsComplete()) {
+        return;
+    }
+
+    Ptr<Packet> payload = entry.slices.Assemble();
+    DtnBundleHeader whole = entry.header;
+    m_reassembly.erase(it);
+    NS_LOG_DEBUG("Bundle " << whole.GetBundleId() << " from node " << whole.GetSourceNode()
+                 << " reassembled at node " << m_nodeId);
+    AcceptBundle(whole, payload, from);
+}
+
+void DtnApplication::ExpireReassemblies(Time now) {
+    for (auto it = m_reassembly.begin(); it != m_reassembly.end();) {
+        if (it->second.expiry <= now) {
+            it = m_reassembly.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void DtnApplication::AcceptBundle(const DtnBundleHeader& header, Ptr<Packet> payload, const Address& from) {
+    // The previous hop holds this bundle, never offer it back
+    uint64_t key = MakeBundleKey(header.GetSourceNode(), header.GetBundleId());
+    DtnNeighbor* neighbor = m_neighbors.FindByAddress(InetSocketAddress::ConvertFrom(from).GetIpv4());
+    if (neighbor) {
+        neighbor->exchangedKeys.insert(key);
+    }
+
+    // Drop copies of bundles already stored or delivered here
+    if (m_seenBundles.Contains(key)) {
+        m_stats.duplicatesDropped++;
+        NS_LOG_DEBUG("Duplicate bundle " << header.GetBundleId() << " from node " << header.GetSourceNode()
+                     << " dropped at node " << m_nodeId);
+        AcknowledgeCustody(header, from);
+        return;
+    }
+
+    DtnBundle bundle;
+    bundle.bundleId = header.GetBundleId();
+    bundle.sourceNode = header.GetSourceNode();
+    bundle.destinationNode = header.GetDestinationNode();
+    bundle.priority = header.GetPriority();
+    bundle.creationTime = header.GetCreationTime();
+    bundle.ttl = header.GetTtl();
+    bundle.hopCount = header.GetHopCount();
+    bundle.copies = header.GetCopies();
+    bundle.routePath = header.GetRoutePath();
+    bundle.routePath.Append(m_nodeId);
+
+    if ((Simulator::Now() - bundle.creationTime) >= bundle.ttl) {
+        NS_LOG_INFO("Bundle " << bundle.bundleId << " from node " << bundle.sourceNode
+                    << " expired in transit");
+        return;
+    }
+    bundle.payload = GetPayloadPool().Intern(key, payload, bundle.creationTime + bundle.ttl);
+    m_sleepScheduler.KeepAwake(m_sleepLinger);
+
+    InitializeBundle(bundle);
+    ReceiveBundle(bundle);
+    AcknowledgeCustody(header, from);
+}
+
+void DtnApplication::AcknowledgeCustody(const DtnBundleHeader& header, const Address& from) {
+    uint64_t key = MakeBundleKey(header.GetSourceNode(), header.GetBundleId());
+    if (!header.IsCustodyRequested() || !m_seenBundles.Contains(key)) {
+        return;
+    }
+
+    PendingAck* ack = 0;
+    for (PendingAck& pending : m_pendingAcks) {
+        if (pending.to == from) {
+            ack = &pending;
+            break;
+        }
+    }
+    if (!ack) {
+        m_pendingAcks.push_back(PendingAck());
+        ack = &m_pendingAcks.back();
+        ack->to = from;
+    }
+    std::vector<uint64_t>& keys = header.GetDestinationNode() == m_nodeId ? ack->delivered : ack->accepted;
+    if (std::find(keys.begin(), keys.end(), key) == keys.end()) {
+        keys.push_back(key);
+    }
+
+    if (!m_custodyAckEvent.IsPending()) {
+        m_custodyAckEvent = Simulator::Schedule(m_custodyAckDelay, &DtnApplication::SendCustodyAcks, this);
+    }
+}
+
+void DtnApplication::SendCustodyAcks(void) {
+    for (PendingAck& ack : m_pendingAcks) {
+        DtnCustodyAckHeader header;
+        header.SetSenderNode(m_nodeId);
+        header.SetAcceptedKeys(std::move(ack.accepted));
+        header.SetDeliveredKeys(std::move(ack.delivered));
+
+        // However many bundles one peer handed over, no datagram outgrows MaxFrameSize
+        for (const DtnCustodyAckHeader& part : header.Split(m_maxFrameSize - DtnTypeHeader().GetSerializedSize())) {
+            Ptr<Packet> packet = Create<Packet>();
+            packet->AddHeader(part);
+            SendFrame(packet, DTN_CUSTODY_ACK, ack.to);
+        }
+    }
+    m_pendingAcks.clear();
+}
+
+void DtnApplication::HandleCustodyAck(Ptr<Packet> packet, const Address& from) {
+    NS_LOG_FUNCTION(this << packet);
+
+    if (packet->GetSize() < DtnCustodyAckHeader::GetMinimumSize()) {
+        NS_LOG_WARN("Malformed custody ACK at node " << m_nodeId);
+        return;
+    }
+    DtnCustodyAckHeader ack;
+    packet->RemoveHeader(ack);
+    if (!ack.IsValid()) {
+        NS_LOG_WARN("Custody ACK key counts run past the datagram at node " << m_nodeId);
+        return;
+    }
+    for (uint64_t key : ack.GetAcceptedKeys()) {
+        ReleaseCustody(key, ack.GetSenderNode(), false);
+    }
+    for (uint64_t key : ack.GetDeliveredKeys()) {
+        ReleaseCustody(key, ack.GetSenderNode(), true);
+    }
+}
+
+void DtnApplication::ReleaseCustody(uint64_t key, uint32_t peer, bool delivered) {
+    NotifyCustodyAccepted(key, peer, delivered);
+
+    // Only copies we offered with custody; the key stays seen, so the
+    // released bundle is not taken back from a later contact
+    const DtnBundle* bundle = m_bundleStore.Find(key);
+    Time expiry = bundle ? bundle->creationTime + bundle->ttl : Simulator::Now() + m_bundleTtl;
+    if (bundle && bundle->custodyDeadline.IsStrictlyPositive()) {
+        DTN_TRACE(GetTrace(), DTN_TRACE_BUNDLE, DTN_TRACE_DETAIL,
+                  bundle->bundleId, m_nodeId, peer, DTN_TRACE_RELEASED, m_nodeType);
+        NS_LOG_INFO("Bundle " << bundle->bundleId << " from node " << bundle->sourceNode
+                    << " released by node " << m_nodeId << ", custody taken by node " << peer);
+        m_bundleStore.Remove(key);
+        m_stats.custodyReleased++;
+    }
+    if (delivered && !m_deliveryReports.Contains(key)) {
+        LearnDelivery(key, expiry);
+    }
+}
+
+void DtnApplication::LearnDelivery(uint64_t key, Time expiry) {
+    m_deliveryReports.Insert(key, expiry);
+    NotifyDeliveryReport(key);
+    if (!m_vaccination) {
+        return;
+    }
+
+    // Seen keys are advertised as held, so no contact offers it again
+    m_seenBundles.Insert(key, expiry);
+    const DtnBundle* held = m_bundleStore.Find(key);
+    if (held) {
+        DTN_TRACE(GetTrace(), DTN_TRACE_BUNDLE, DTN_TRACE_DETAIL,
+                  held->bundleId, held->sourceNode, m_nodeId, DTN_TRACE_PURGED, m_nodeType);
+        NS_LOG_INFO("Bundle " << held->bundleId << " from node " << held->sourceNode
+                    << " purged at node " << m_nodeId << ", delivered elsewhere");
+        m_bundleStore.Remove(key);
+        m_stats.bundlesPurged++;
+    }
+}
+
+void DtnApplication::CustodyRetry(void) {
+    RoutingPass();
+
+    // Re-arm for the next offer still waiting for its ACK. Offers made
+    // during the pass armed the retry at their own, later deadline, so
+    // it is moved to the earliest one whatever is pending
+    Time now = Simulator::Now();
+    Time next = Time::Max();
+    m_bundleStore.ForEach([&](DtnBundle& bundle) {
+        if (AwaitingCustody(bundle, now)) {
+            next = std::min(next, bundle.custodyDeadline);
+        }
+        return true;
+    });
+    Simulator::Cancel(m_custodyRetryEvent);
+    if (next != Time::Max()) {
+        m_nextCustodyRetry = next;
+        m_custodyRetryEvent = Simulator::Schedule(next - now, &DtnApplication::CustodyRetry, this);
+    }
+}
+
+void DtnApplication::ScheduleCustodyRetry(Time deadline) {
+    if (m_custodyRetryEvent.IsPending() && m_nextCustodyRetry <= deadline) {
+        return;
+    }
+    Simulator::Cancel(m_custodyRetryEvent);
+    m_nextCustodyRetry = deadline;
+    m_custodyRetryEvent = Simulator::Schedule(deadline - Simulator::Now(), &DtnApplication::CustodyRetry, this);
+}
+
+void DtnApplication::ReceiveBundle(DtnBundle& bundle) {
+    NS_LOG_FUNCTION(this);
+
+    uint64_t key = MakeBundleKey(bundle.sourceNode, bundle.bundleId);
+    m_stats.bundlesReceived++;
+
+    // Check if bundle is for this node
+    if (bundle.destinationNode == m_nodeId) {
+        bundle.delivered = true;
+        m_seenBundles.Insert(key, bundle.creationTime + bundle.ttl);
+        m_deliveryReports.Insert(key, bundle.creationTime + bundle.ttl);
+        m_stats.bundlesDelivered++;
+        DTN_TRACE(GetTrace(), DTN_TRACE_BUNDLE, DTN_TRACE_SUMMARY,
+                  bundle.bundleId, bundle.routePath.GetPreviousHop(bundle.sourceNode), m_nodeId,
+                  DTN_TRACE_DELIVERED, m_nodeType);
+        for (uint32_t k = 1; k < bundle.routePath.GetSize(); ++k) {
+            DTN_TRACE(GetTrace(), DTN_TRACE_BUNDLE, DTN_TRACE_SUMMARY, bundle.bundleId,
+                      bundle.routePath.Get(k - 1), bundle.routePath.Get(k), DTN_TRACE_ROUTE, m_nodeType);
+        }
+        NS_LOG_INFO("Bundle " << bundle.bundleId << " from node " << bundle.sourceNode
+                    << " delivered to node " << m_nodeId << " after "
+                    << (Simulator::Now() - bundle.creationTime).GetSeconds() << " s");
+        m_deliveredTrace(bundle);
+        NotifyBundleDelivered(bundle);
+        return;
+    }
+
+    // Store bundle for forwarding; only stored bundles are advertised as seen,
+    // so a neighbour can offer a dropped one again later
+    if (StoreBundle(bundle)) {
+        m_seenBundles.Insert(key, bundle.creationTime + bundle.ttl);
+        DTN_TRACE(GetTrace(), DTN_TRACE_BUNDLE, DTN_TRACE_DETAIL,
+                  bundle.bundleId, bundle.routePath.GetPreviousHop(bundle.sourceNode), m_nodeId,
+                  DTN_TRACE_RECEIVED, m_nodeType);
+        NS_LOG_INFO("Bundle " << bundle.bundleId << " stored in node " << m_nodeId);
+        BufferChanged();
+    } else {
+        m_stats.bundlesDropped++;
+        NS_LOG_WARN("Bundle " << bundle.bundleId << " dropped - buffer full at node " << m_nodeId);
+    }
+}
+
+bool DtnApplication::StoreBundle(const DtnBundle& bundle) {
+    uint64_t key = MakeBundleKey(bundle.sourceNode, bundle.bundleId);
+    if (m_bundleStore.IsFull() && !m_bundleStore.Contains(key)) {
+        Time now = Simulator::Now();
+        const DtnBundle* victim = m_bundleStore.SelectVictim(bundle, m_dropPolicy,
+            [this, now](const DtnBundle& held) { return GetRetentionScore(held, now); });
+        if (victim) {
+            // The victim stays in the seen set: re-accepting it from the next
+            // contact would only evict something else
+            DTN_TRACE(GetTrace(), DTN_TRACE_BUNDLE, DTN_TRACE_SUMMARY,
+                      victim->bundleId, victim->sourceNode, m_nodeId, DTN_TRACE_EVICTED, m_nodeType);
+            NS_LOG_INFO("Bundle " << victim->bundleId << " from node " << victim->sourceNode
+                        << " evicted at node " << m_nodeId << " for bundle " << bundle.bundleId);
+            m_bundleStore.Remove(MakeBundleKey(victim->sourceNode, victim->bundleId));
+            m_stats.bundlesEvicted++;
+        }
+    }
+    if (!m_bundleStore.Insert(bundle)) {
+        return false;
+    }
+    UpdatePeakBuffered();
+    return true;
+}
+
+void DtnApplication::SendBundle(uint32_t destination, uint32_t priority, std::string payload) {
+    NS_LOG_FUNCTION(this << destination << priority);
+
+    DtnBundle bundle;
+    bundle.bundleId = m_bundleCounter++;
+    bundle.sourceNode = m_nodeId;
+    bundle.destinationNode = destination;
+    bundle.priority = priority;
+    bundle.creationTime = Simulator::Now();
+    bundle.ttl = m_bundleTtl;
+    bundle.hopCount = 0;
+    bundle.copies = m_routingStrategy ? m_routingStrategy->GetInitialCopies() : 1;
+    bundle.payload = GetPayloadPool().Intern(MakeBundleKey(m_nodeId, bundle.bundleId),
+                                             Create<Packet>((uint8_t*)payload.c_str(), payload.length()),
+                                             bundle.creationTime + bundle.ttl);
+    bundle.routePath.Append(m_nodeId);
+    bundle.lastForwardTime = Simulator::Now();
+    InitializeBundle(bundle);
+    m_createdTrace(bundle);
+
+    if (!StoreBundle(bundle)) {
+        m_stats.bundlesDropped++;
+        NS_LOG_WARN("Bundle " << bundle.bundleId << " dropped at creation - buffer full at node " << m_nodeId);
+        return;
+    }
+    m_seenBundles.Insert(MakeBundleKey(m_nodeId, bundle.bundleId), bundle.creationTime + bundle.ttl);
+    m_stats.bundlesCreated++;
+
+    DTN_TRACE(GetTrace(), DTN_TRACE_BUNDLE, DTN_TRACE_SUMMARY,
+              bundle.bundleId, m_nodeId, m_nodeId, DTN_TRACE_CREATED, m_nodeType);
+    NS_LOG_INFO("Bundle " << bundle.bundleId << " created at node " << m_nodeId
+                << " for destination " << destination);
+    if (priority == 0 && !m_sleepScheduler.IsAwake()) {
+        m_stats.emergencyWakeups++;
+        m_sleepScheduler.WakeNow();
+    }
+    BufferChanged();
+}
+
+void DtnApplication::HandleSummaryVector(Ptr<Packet> packet, const Address& from) {
+    NS_LOG_FUNCTION(this << packet);
+    DTN_PROFILE_SCOPE(DTN_PROFILE_ROUTING);
+
+    if (packet->GetSize() < DtnSummaryVectorHeader::GetMinimumSize()) {
+        NS_LOG_WARN("Malformed summary vector at node " << m_nodeId);
+        return;
+    }
+
+    DtnSummaryVectorHeader peerVector;
+    packet->RemoveHeader(peerVector);
+    uint32_t peerNode = peerVector.GetSenderNode();
+    if (peerNode == m_nodeId) {
+        return;
+    }
+
+    // A vector can beat the peer's beacon to us; open the contact with our
+    // own hold time until the beacon reports the peer's interval
+    DtnNeighbor* neighbor = m_neighbors.Find(peerNode);
+    if (!neighbor) {
+        InetSocketAddress peer = InetSocketAddress(InetSocketAddress::ConvertFrom(from).GetIpv4(), m_port);
+        neighbor = m_neighbors.Heard(peerNode, peer, BeaconHoldTime(m_beaconInterval));
+    }
+    m_sleepScheduler.KeepAwake(m_sleepLinger);
+
+    // Delivery reports are passed on until the bundle's TTL (or the bundle
+    // TTL used here), whatever the derived application does with the vector;
+    // each part's are learnt as it arrives, so a lost part costs no others
+    for (uint64_t key : peerVector.GetDeliveredKeys()) {
+        if (!m_deliveryReports.Contains(key)) {
+            const DtnBundle* held = m_bundleStore.Find(key);
+            LearnDelivery(key, held ? held->creationTime + held->ttl : Simulator::Now() + m_bundleTtl);
+        }
+    }
+
+    if (peerVector.GetPart() == 0) {
+        neighbor->pendingVector = peerVector;
+    } else {
+        neighbor->pendingVector.Merge(peerVector);
+    }
+    if (!peerVector.IsLastPart()) {
+        return;
+    }
+    // A lost part only costs the peer offers of bundles it already holds
+    neighbor->vector = neighbor->pendingVector;
+    neighbor->pendingVector = DtnSummaryVectorHeader();
+    neighbor->hasVector = true;
+    ReceiveSummaryVector(*neighbor, neighbor->vector);
+}
+
+void DtnApplication::ReceiveSummaryVector(DtnNeighbor& neighbor, const DtnSummaryVectorHeader& vector) {
+    if (!m_routingStrategy) {
+        return;
+    }
+    // One summary vector per contact, so one encounter for the routing strategy
+    m_routingStrategy->NotifyContact(neighbor.nodeId, vector.GetPredictabilities());
+    RouteToNeighbor(neighbor);
+}
+
+void DtnApplication::HandleBeacon(Ptr<Packet> packet, const Address& from) {
+    DtnBeaconHeader beacon;
+    if (packet->GetSize() < beacon.GetSerializedSize()) {
+        return;
+    }
+    packet->RemoveHeader(beacon);
+    if (beacon.GetSenderNode() == m_nodeId) {
+        return;
+    }
+    if (beacon.GetInterval().IsZero()) {
+        m_neighbors.Remove(beacon.GetSenderNode());
+        return;
+    }
+
+    InetSocketAddress peer = InetSocketAddress(InetSocketAddress::ConvertFrom(from).GetIpv4(), m_port);
+    m_neighbors.Heard(beacon.GetSenderNode(), peer, BeaconHoldTime(beacon.GetInterval()));
+    ReceiveBeacon(beacon);
+}
+
+void DtnApplication::SendBeacon(void) {
+    BroadcastBeacon(m_beaconInterval);
+    m_beaconEvent = Simulator::Schedule(m_beaconInterval, &DtnApplication::SendBeacon, this);
+}
+
+void DtnApplication::BroadcastBeacon(Time interval) {
+    DtnBeaconHeader beacon;
+    beacon.SetSenderNode(m_nodeId);
+    beacon.SetInterval(interval);
+    if (!interval.IsZero()) {
+        PrepareBeacon(beacon);
+    }
+
+    Ptr<Packet> packet = Create<Packet>();
+    packet->AddHeader(beacon);
+    packet->AddHeader(DtnTypeHeader(DTN_BEACON));
+
+    InetSocketAddress remote = InetSocketAddress(Ipv4Address("255.255.255.255"), m_port);
+    m_socket->SendTo(packet, 0, remote);
+}
+
+void DtnApplication::ContactUp(uint32_t peer) {
+    m_stats.contacts++;
+    m_sleepScheduler.KeepAwake(m_sleepLinger);
+    NS_LOG_DEBUG("Contact up: node " << m_nodeId << " <-> node " << peer);
+    DTN_TRACE(GetTrace(), DTN_TRACE_CONTACT, DTN_TRACE_DETAIL, 0, m_nodeId, peer, DTN_TRACE_CONTACT_UP, m_nodeType);
+    m_contactUpTrace(m_nodeId, peer);
+    NotifyContactUp(peer);
+
+    // Advertise what we hold; the peer answers with the bundles we lack
+    SendSummaryVector(m_neighbors.Find(peer)->address);
+}
+
+void DtnApplication::ContactDown(uint32_t peer) {
+    NS_LOG_DEBUG("Contact down: node " << m_nodeId << " <-> node " << peer);
+    DTN_TRACE(GetTrace(), DTN_TRACE_CONTACT, DTN_TRACE_DETAIL, 0, m_nodeId, peer, DTN_TRACE_CONTACT_DOWN, m_nodeType);
+    m_contactDownTrace(m_nodeId, peer);
+    NotifyContactDown(peer);
+}
+
+void DtnApplication::UpdatePeakBuffered(void) {
+    m_stats.peakBuffered = std::max(m_stats.peakBuffered, m_bundleStore.GetSize());
+}
+
+void DtnApplication::SaveState(DtnApplicationState& state) const {
+    Time now = Simulator::Now();
+    state = DtnApplicationState();
+    state.bundleCounter = m_bundleCounter;
+    m_bundleStore.ForEach([&](const DtnBundle& bundle) {
+        if (IsLive(bundle, now)) {
+            state.bundles.push_back(bundle);
+        }
+        return true;
+    });
+    state.seenBundles = m_seenBundles.GetEntries();
+    state.deliveryReports = m_deliveryReports.GetEntries();
+    if (m_routingStrategy) {
+        std::ostringstream routing;
+        routing << std::setprecision(17);
+        m_routingStrategy->WriteState(routing);
+        state.routing = routing.str();
+    }
+    DoSaveState(state);
+}
+
+void DtnApplication::RestoreState(const DtnApplicationState& state) {
+    if (!IsRunning()) {
+        m_pendingState = state;
+        m_statePending = true;
+        return;
+    }
+    ApplyState(state);
+}
+
+void DtnApplication::ApplyState(const DtnApplicationState& state) {
+    Time now = Simulator::Now();
+    m_bundleCounter = std::max(m_bundleCounter, state.bundleCounter);
+    for (const std::pair<uint64_t, Time>& entry : state.seenBundles) {
+        if (entry.second > now) {
+            m_seenBundles.Insert(entry.first, entry.second);
+        }
+    }
+    for (const std::pair<uint64_t, Time>& entry : state.deliveryReports) {
+        if (entry.second > now) {
+            m_deliveryReports.Insert(entry.first, entry.second);
+        }
+    }
+    uint32_t restored = 0;
+    for (const DtnBundle& saved : state.bundles) {
+        if (!IsLive(saved, now)) {
+            continue;
+        }
+        DtnBundle bundle = saved;
+        uint64_t key = MakeBundleKey(bundle.sourceNode, bundle.bundleId);
+        bundle.payload = GetPayloadPool().Intern(key, bundle.payload, bundle.creationTime + bundle.ttl);
+        // The contact it was offered to belongs to the old run
+        bundle.custodyDeadline = Time();
+        if (m_bundleStore.Insert(bundle)) {
+            m_seenBundles.Insert(key, bundle.creationTime + bundle.ttl);
+            ++restored;
+        }
+    }
+    if (m_routingStrategy && !state.routing.empty()) {
+        std::istringstream routing(state.routing);
+        if (!m_routingStrategy->ReadState(routing)) {
+            NS_LOG_WARN("Node " << m_nodeId << ": saved routing state does not fit "
+                        << m_routingStrategy->GetName() << ", starting it afresh");
+        }
+    }
+    DoRestoreState(state);
+    UpdatePeakBuffered();
+    NS_LOG_INFO("Node " << m_nodeId << " restored " << restored << " of " << state.bundles.size()
+                << " bundles");
+    BufferChanged();
+}
+
+void DtnApplication::SendSummaryVector(const Address& to) {
+    NS_LOG_FUNCTION(this);
+
+    m_seenBundles.ExpireBundles(Simulator::Now());
+
+    DtnSummaryVectorHeader summaryVector;
+    PrepareSummaryVector(summaryVector);
+
+    // However many bundles are advertised, no datagram outgrows MaxFrameSize
+    std::vector<DtnSummaryVectorHeader> parts =
+        summaryVector.Split(m_maxFrameSize - DtnTypeHeader().GetSerializedSize());
+    for (const DtnSummaryVectorHeader& part : parts) {
+        Ptr<Packet> packet = Create<Packet>();
+        packet->AddHeader(part);
+        packet->AddHeader(DtnTypeHeader(DTN_SUMMARY_VECTOR));
+        if (m_socket->SendTo(packet, 0, to) < 0) {
+            NS_LOG_WARN("Summary vector part " << part.GetPart() + 1 << "/" << parts.size() << " of node "
+                        << m_nodeId << " not sent, socket error " << m_socket->GetErrno());
+        }
+    }
+}
+
+void DtnApplication::PrepareSummaryVector(DtnSummaryVectorHeader& vector) {
+    vector.SetSenderNode(m_nodeId);
+    vector.SetBundleKeys(m_seenBundles.GetKeys());
+    m_deliveryReports.ExpireBundles(Simulator::Now());
+    vector.SetDeliveredKeys(m_deliveryReports.GetKeys());
+    if (m_routingStrategy) {
+        vector.SetPredictabilities(m_routingStrategy->GetPredictabilities());
+    }
+}
+
+void DtnApplication::BufferChanged(void) {
+    // Coalesce a burst of new bundles into one routing pass
+    if (!m_routingEvent.IsPending() && !m_neighbors.IsEmpty()) {
+        m_routingEvent = Simulator::ScheduleNow(&DtnApplication::RoutingPass, this);
+    }
+    ScheduleExpiry();
+}
+
+void DtnApplication::RoutingPass(void) {
+    NS_LOG_FUNCTION(this);
+    DTN_PROFILE_SCOPE(DTN_PROFILE_ROUTING);
+    DoRoutingPass();
+}
+
+void DtnApplication::DoRoutingPass(void) {
+    m_neighbors.ForEach([this](DtnNeighbor& neighbor) {
+        if (neighbor.hasVector) {
+            RouteToNeighbor(neighbor);
+        }
+    });
+}
+
+void DtnApplication::RouteToNeighbor(DtnNeighbor& neighbor) {
+    NS_LOG_FUNCTION(this);
+
+    if (!m_routingStrategy) {
+        return;
+    }
+
+    // Anti-entropy: only bundles the peer is not known to hold,
+    // filtered and copy-split by the routing strategy
+    Time now = Simulator::Now();
+    for (std::vector<DtnBundle*>& candidates : m_candidates) {
+        candidates.clear();
+    }
+    m_bundleStore.ForEach([&](DtnBundle& bundle) {
+        uint64_t key = MakeBundleKey(bundle.sourceNode, bundle.bundleId);
+        if (IsLive(bundle, now) && !AwaitingCustody(bundle, now) && !neighbor.Has(key) &&
+            m_routingStrategy->ShouldForward(bundle.destinationNode, bundle.copies, neighbor.nodeId)) {
+            m_candidates[BundleStore<DtnBundle>::PriorityClass(bundle.priority)].push_back(&bundle);
+        }
+        return true;
+    });
+
+    uint32_t limit = m_maxForwardsPerContact > 0 ? m_maxForwardsPerContact : std::numeric_limits<uint32_t>::max();
+    uint32_t forwards = 0;
+    // Queued sends are not drawn from the energy source yet
+    double passEnergy = 0.0;
+    auto forward = [&](DtnBundle* bundle) {
+        if (!CanAffordForward(*bundle, neighbor.nodeId, passEnergy)) {
+            return;
+        }
+        passEnergy += GetTransmitEnergy(*bundle);
+        // Custody moves the whole copy budget along with the bundle
+        uint32_t handedCopies = m_custodyTransfer ? bundle->copies : m_routingStrategy->OnForward(bundle->copies);
+        ForwardBundle(*bundle, handedCopies, neighbor);
+        forwards++;
+    };
+    if (m_transmitScheduling == DTN_SCHEDULE_STRICT) {
+        for (std::vector<DtnBundle*>& candidates : m_candidates) {
+            for (size_t i = 0; i < candidates.size() && forwards < limit; ++i) {
+                forward(candidates[i]);
+            }
+        }
+    } else {
+        // Weighted round robin: every round offers each class up to its
+        // weight, so a capped contact still carries some low-priority traffic
+        static const uint32_t WEIGHTS[BundleStore<DtnBundle>::PRIORITY_CLASSES] = {8, 4, 2, 1};
+        size_t next[BundleStore<DtnBundle>::PRIORITY_CLASSES] = {0};
+        bool pending = true;
+        while (pending && forwards < limit) {
+            pending = false;
+            for (uint32_t p = 0; p < BundleStore<DtnBundle>::PRIORITY_CLASSES; ++p) {
+                std::vector<DtnBundle*>& candidates = m_candidates[p];
+                for (uint32_t k = 0; k < WEIGHTS[p] && next[p] < candidates.size() && forwards < limit; ++k) {
+                    forward(candidates[next[p]++]);
+                }
+                pending = pending || next[p] < candidates.size();
+            }
+        }
+    }
+
+    // Capped pass: continue draining the backlog to this contact shortly
+    if (m_maxForwardsPerContact > 0 && forwards >= m_maxForwardsPerContact && !m_routingEvent.IsPending()) {
+        m_routingEvent = Simulator::Schedule(Seconds(1.0), &DtnApplication::RoutingPass, this);
+    }
+}
+
+double DtnApplication::GetBatteryLevel(void) const {
+    return m_energySource ? m_energySource->GetEnergyFraction() : 1.0;
+}
+
+double DtnApplication::GetEnergyConsumed(void) const {
+    return m_energySource ? m_energySource->GetInitialEnergy() - m_energySource->GetRemainingEnergy() : 0.0;
+}
+
+double DtnApplication::GetAwakeFraction(void) const {
+    Time running = m_sleepScheduler.GetRunningTime();
+    if (m_wakeupSchedule.IsAlwaysOn() || !running.IsStrictlyPositive()) {
+        return 1.0;
+    }
+    return m_sleepScheduler.GetAwakeTime().GetSeconds() / running.GetSeconds();
+}
+
+void DtnApplication::RadioWake(void) {
+    Simulator::Cancel(m_phyEvent);
+    for (const Ptr<WifiPhy>& phy : m_phys) {
+        if (phy->IsStateSleep()) {
+            phy->ResumeFromSleep();
+        }
+    }
+    NS_LOG_DEBUG("Node " << m_nodeId << " radio awake");
+}
+
+void DtnApplication::RadioSleep(void) {
+    m_stats.sleepPeriods++;
+    Simulator::Cancel(m_beaconEvent);
+    // Contacts cannot carry anything now; the peers close theirs on the goodbye
+    if (!m_neighbors.IsEmpty()) {
+        BroadcastBeacon(Seconds(0.0));
+        m_neighbors.RemoveAll();
+    }
+    m_phyEvent = Simulator::Schedule(m_sleepGuard, &DtnApplication::SleepPhys, this);
+    NS_LOG_DEBUG("Node " << m_nodeId << " radio asleep");
+}
+
+void DtnApplication::SleepPhys(void) {
+    for (const Ptr<WifiPhy>& phy : m_phys) {
+        phy->SetSleepMode();
+    }
+}
+
+void DtnApplication::SlotEdge(void) {
+    // The schedule's overlap guarantee needs a beacon at both edges of an awake slot
+    Simulator::Cancel(m_beaconEvent);
+    SendBeacon();
+}
+
+bool DtnApplication::HoldAwake(void) {
+    Time now = Simulator::Now();
+    bool held = false;
+    m_bundleStore.ForEach([&](DtnBundle& bundle) {
+        held = bundle.priority == 0 && bundle.retransmissionCount == 0 && IsLive(bundle, now);
+        return !held;
+    });
+    return held;
+}
+
+double DtnApplication::GetTransmitEnergy(const DtnBundle& bundle) const {
+    uint32_t bytes = (bundle.payload ? bundle.payload->GetSize() : 0) + DtnBundleHeader().GetSerializedSize();
+    return m_txEnergyPerByte * bytes;
+}
+
+bool DtnApplication::CanAffordForward(const DtnBundle& bundle, uint32_t peer, double committed) {
+    if (!m_energySource) {
+        return true;
+    }
+    double remaining = m_energySource->GetRemainingEnergy() - committed;
+    double cost = GetTransmitEnergy(bundle);
+    // Below the reserve only the last hop is worth the energy
+    double reserve = bundle.destinationNode == peer ? 0.0
+                                                    : m_lowBatteryThreshold * m_energySource->GetInitialEnergy();
+    if (remaining - cost > reserve) {
+        return true;
+    }
+    m_stats.forwardsSuppressed++;
+    return false;
+}
+
+double DtnApplication::GetRetentionScore(const DtnBundle& bundle, Time now) {
+    static const double WEIGHTS[BundleStore<DtnBundle>::PRIORITY_CLASSES] = {1.0, 0.8, 0.5, 0.2};
+    double remaining = bundle.ttl.IsStrictlyPositive()
+        ? (bundle.creationTime + bundle.ttl - now).GetSeconds() / bundle.ttl.GetSeconds() : 0.0;
+    return remaining * WEIGHTS[BundleStore<DtnBundle>::PriorityClass(bundle.priority)];
+}
+
+void DtnApplication::ForwardBundle(DtnBundle& bundle, uint32_t copies, DtnNeighbor& neighbor) {
+    NS_LOG_FUNCTION(this);
+
+    DtnBundleHeader header;
+    header.SetBundleId(bundle.bundleId);
+    header.SetSourceNode(bundle.sourceNode);
+    header.SetDestinationNode(bundle.destinationNode);
+    header.SetPriority(bundle.priority);
+    header.SetHopCount(std::min<uint32_t>(bundle.hopCount + 1, 255));
+    header.SetCopies(std::min<uint32_t>(copies, 0xFFFF));
+    header.SetCreationTime(bundle.creationTime);
+    header.SetTtl(bundle.ttl);
+    header.SetRoutePath(bundle.routePath);
+    if (m_custodyTransfer) {
+        header.SetFlags(DTN_BUNDLE_FLAG_CUSTODY);
+        bundle.custodyDeadline = Simulator::Now() + m_custodyTimeout;
+        ScheduleCustodyRetry(bundle.custodyDeadline);
+    }
+
+    if (DtnTypeHeader().GetSerializedSize() + header.GetSerializedSize() + bundle.payload->GetSize() > m_maxFrameSize) {
+        SendFragments(header, bundle.payload, neighbor.address);
+    } else {
+        // Copy() shares the payload buffer, the header is the only new data
+        Ptr<Packet> record = bundle.payload->Copy();
+        record->AddHeader(header);
+        QueueRecord(neighbor.address, record);
+    }
+
+    neighbor.exchangedKeys.insert(MakeBundleKey(bundle.sourceNode, bundle.bundleId));
+    m_sleepScheduler.KeepAwake(m_sleepLinger);
+    bundle.retransmissionCount++;
+    bundle.lastForwardTime = Simulator::Now();
+    m_stats.bundlesForwarded++;
+
+    DTN_TRACE(GetTrace(), DTN_TRACE_BUNDLE, DTN_TRACE_DETAIL,
+              bundle.bundleId, m_nodeId, neighbor.nodeId, DTN_TRACE_FORWARDED, m_nodeType);
+    m_forwardedTrace(bundle, m_nodeId, neighbor.nodeId);
+    NS_LOG_INFO("Bundle " << bundle.bundleId << " forwarded by node " << m_nodeId
+                << " to node " << neighbor.nodeId);
+}
+
+void DtnApplication::QueueRecord(const Address& to, Ptr<Packet> record) {
+    if (!m_aggregation) {
+        SendFrame(record, DTN_BUNDLE, to);
+        return;
+    }
+
+    PendingFrame* frame = 0;
+    for (PendingFrame& pending : m_pendingFrames) {
+        if (pending.to == to) {
+            frame = &pending;
+            break;
+        }
+    }
+    if (!frame) {
+        m_pendingFrames.push_back(PendingFrame());
+        frame = &m_pendingFrames.back();
+        frame->to = to;
+        frame->bytes = DtnTypeHeader().GetSerializedSize();
+    }
+
+    uint32_t recordSize = DtnRecordHeader().GetSerializedSize() + record->GetSize();
+    if (!frame->records.empty() && frame->bytes + recordSize > m_maxFrameSize) {
+        SendPending(*frame);
+    }
+    frame->records.push_back(record);
+    frame->bytes += recordSize;
+
+    // Everything forwarded in this event shares the frames
+    if (!m_flushEvent.IsPending()) {
+        m_flushEvent = Simulator::ScheduleNow(&DtnApplication::FlushFrames, this);
+    }
+}
+
+void DtnApplication::SendPending(PendingFrame& frame) {
+    if (frame.records.size() == 1) {
+        SendFrame(frame.records.front(), DTN_BUNDLE, frame.to);
+    } else if (!frame.records.empty()) {
+        Ptr<Packet> batch = Create<Packet>();
+        for (Ptr<Packet>& record : frame.records) {
+            record->AddHeader(DtnRecordHeader(record->GetSize()));
+            batch->AddAtEnd(record);
+        }
+        SendFrame(batch, DTN_BUNDLE_BATCH, frame.to);
+    }
+    frame.records.clear();
+    frame.bytes = DtnTypeHeader().GetSerializedSize();
+}
+
+void DtnApplication::FlushFrames(void) {
+    for (PendingFrame& frame : m_pendingFrames) {
+        SendPending(frame);
+    }
+    m_pendingFrames.clear();
+}
+
+void DtnApplication::SendFragments(const DtnBundleHeader& header, Ptr<Packet> payload, const Address& to) {
+    uint32_t overhead = DtnTypeHeader().GetSerializedSize() + header.GetSerializedSize() +
+                        DtnFragmentHeader().GetSerializedSize();
+    // Type, bundle header with a full route path and fragment header stay
+    // below the attribute's minimum, but a zero or wrapped slice would loop
+    // forever or send one oversized datagram
+    if (overhead >= m_maxFrameSize) {
+        NS_LOG_WARN("Bundle " << header.GetBundleId() << " not sent: " << overhead
+                    << " header bytes leave no room in a " << m_maxFrameSize << "-byte frame");
+        return;
+    }
+    uint32_t slice = m_maxFrameSize - overhead;
+    uint32_t total = payload->GetSize();
+    for (uint32_t offset = 0; offset < total; offset += slice) {
+        Ptr<Packet> fragment = payload->CreateFragment(offset, std::min(slice, total - offset));
+        fragment->AddHeader(DtnFragmentHeader(offset, total));
+        fragment->AddHeader(header);
+        SendFrame(fragment, DTN_BUNDLE_FRAGMENT, to);
+        m_stats.fragmentsSent++;
+    }
+}
+
+void DtnApplication::SendFrame(Ptr<Packet> frame, DtnMessageType type, const Address& to) {
+    if (!m_socket) {
+        return;
+    }
+    frame->AddHeader(DtnTypeHeader(type));
+    m_socket->SendTo(frame, 0, to);
+    if (type == DTN_CUSTODY_ACK) {
+        m_stats.custodyAcksSent++;
+    } else {
+        m_stats.framesSent++;
+    }
+}
+
+void DtnApplication::ScheduleExpiry(void) {
+    // One event at the earliest TTL instead of a sweep on every timer tick
+    Time next = m_bundleStore.GetNextExpiry();
+    if (next == Time::Max() || (m_expiryEvent.IsPending() && m_nextExpiry <= next)) {
+        return;
+    }
+    Simulator::Cancel(m_expiryEvent);
+    m_nextExpiry = next;
+    m_expiryEvent = Simulator::Schedule(std::max(next - Simulator::Now(), Seconds(0.0)),
+                                        &DtnApplication::ExpireBundles, this);
+}
+
+void DtnApplication::ExpireBundles(void) {
+    DTN_PROFILE_SCOPE(DTN_PROFILE_EXPIRY);
+    // Heap pops only for bundles whose TTL has actually run out
+    Time now = Simulator::Now();
+    m_bundleStore.ExpireBundles(now);
+    m_seenBundles.ExpireBundles(now);
+    m_deliveryReports.ExpireBundles(now);
+    GetPayloadPool().ExpireBundles(now);
+    ExpireReassemblies(now);
+    NotifyExpiry(now);
+    ScheduleExpiry();
+}
+
+} // namespace ns3
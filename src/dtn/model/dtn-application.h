@@ -0,0 +1,375 @@
+/*
+ * DTN Application
+ * Store-carry-forward node: beacons, summary-vector exchange, bundle buffer and routing passes
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#ifndef DTN_APPLICATION_H
+#define DTN_APPLICATION_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/energy-module.h"
+#include "dtn-bundle.h"
+#include "dtn-bundle-header.h"
+#include "dtn-summary-vector-header.h"
+#include "dtn-bundle-store.h"
+#include "dtn-routing-strategy.h"
+#include "dtn-neighbor-discovery.h"
+#include "dtn-sleep-scheduler.h"
+#include "dtn-trace.h"
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+class WifiPhy;
+
+// Per-node counters, read by the drivers' reports
+struct DtnApplicationStats {
+    DtnApplicationStats()
+        : bundlesCreated(0),
+          bundlesReceived(0),
+          bundlesDelivered(0),
+          bundlesForwarded(0),
+          bundlesDropped(0),
+          duplicatesDropped(0),
+          contacts(0),
+          peakBuffered(0),
+          bundlesEvicted(0),
+          framesSent(0),
+          fragmentsSent(0),
+          custodyReleased(0),
+          custodyAcksSent(0),
+          bundlesPurged(0),
+          forwardsSuppressed(0),
+          sleepPeriods(0),
+          emergencyWakeups(0) {
+    }
+
+    uint32_t bundlesCreated;
+    uint32_t bundlesReceived;    // New bundles accepted, including deliveries
+    uint32_t bundlesDelivered;   // Bundles that reached this node as destination
+    uint32_t bundlesForwarded;
+    uint32_t bundlesDropped;     // Refused, buffer full
+    uint32_t duplicatesDropped;
+    uint32_t contacts;
+    uint32_t peakBuffered;       // Most bundles held at once
+    uint32_t bundlesEvicted;     // Pushed out by the drop policy for a newcomer
+    uint32_t framesSent;         // Bundle datagrams: single, batch or fragment
+    uint32_t fragmentsSent;
+    uint32_t custodyReleased;    // Copies dropped once a next hop accepted custody
+    uint32_t custodyAcksSent;    // ACK datagrams; a large ACK is split into several
+    uint32_t bundlesPurged;      // Copies dropped because the bundle was delivered elsewhere
+    uint32_t forwardsSuppressed; // Forwards the battery could not afford
+    uint32_t sleepPeriods;       // Times the radio went to sleep
+    uint32_t emergencyWakeups;   // Schedule broken for an emergency bundle
+};
+
+// What a DtnSnapshot keeps of one application; see DtnApplication::SaveState()
+struct DtnApplicationState {
+    DtnApplicationState()
+        : bundleCounter(0),
+          modelSamples(0) {
+    }
+
+    uint32_t bundleCounter;  // Next bundle id of this node
+    std::vector<DtnBundle> bundles;  // Buffer, with payloads
+    std::vector<std::pair<uint64_t, Time> > seenBundles;  // Key, expiry
+    std::vector<std::pair<uint64_t, Time> > deliveryReports;  // Key, expiry
+    std::string routing;  // RoutingStrategy::WriteState(), empty without a strategy
+    std::vector<double> model;  // Learnt weights of a derived application, empty if none
+    uint32_t modelSamples;
+};
+
+// Order in which a contact's eligible bundles are sent
+enum DtnTransmitScheduling {
+    DTN_SCHEDULE_STRICT,        // Most urgent class first, FIFO within a class
+    DTN_SCHEDULE_WEIGHTED_FAIR  // Round robin over the classes, 8:4:2:1 bundles per round
+};
+
+/*
+ * DTN node over UDP broadcast/unicast. Control flow is event driven:
+ *
+ *   - one periodic beacon feeds the NeighborTable; contact-up unicasts our
+ *     summary vector, and the peer's vector triggers routing to that peer
+ *   - a buffer change schedules one coalesced routing pass over every
+ *     contact whose vector is known
+ *   - bundle expiry is a single event armed at the store's earliest TTL
+ *
+ * Forwarding decisions come from the RoutingStrategy; TransmitScheduling
+ * orders what a contact is sent and DropPolicy decides what a full buffer
+ * gives up (see BundleStore). Bundles forwarded to the same contact within
+ * one event are packed into batch frames up to MaxFrameSize, and a bundle
+ * larger than that goes out as fragments that receivers reassemble before
+ * storing it. With CustodyTransfer each bundle is handed to one contact
+ * at a time with its whole copy budget; the receiver acknowledges what it
+ * stored or was the destination of in one batched ACK per peer, and the
+ * sender then releases its copy. Deliveries are reported in every summary
+ * vector until the bundle's TTL; with Vaccination a node hearing of one
+ * drops its copy and refuses further ones. With a WakeupSchedule the
+ * radio sleeps between the schedule's awake slots unless a contact is
+ * busy (SleepLinger after the last exchange) or an emergency bundle is
+ * buffered that no contact has taken yet; creating one wakes the node at
+ * once, and a node going to sleep says goodbye so its contacts close.
+ * Derived applications customise the protected hooks (beacon
+ * and vector contents, routing pass, delivery feedback) and reuse the
+ * rest. Every bundle event is written to the shared message-flow trace
+ * when it is enabled.
+ */
+class DtnApplication : public Application {
+public:
+    static TypeId GetTypeId(void);
+    DtnApplication();
+    virtual ~DtnApplication();
+
+    void SetNodeId(uint32_t nodeId);
+    uint32_t GetNodeId(void) const { return m_nodeId; }
+    void SetNodeType(uint32_t nodeType) { m_nodeType = nodeType; }
+    uint32_t GetNodeType(void) const { return m_nodeType; }
+    // Null leaves forwarding to a derived application's DoRoutingPass()
+    void SetRoutingStrategy(Ptr<RoutingStrategy> strategy);
+    Ptr<RoutingStrategy> GetRoutingStrategy(void) const { return m_routingStrategy; }
+    void SetBufferCapacity(uint32_t capacity) { m_bundleStore.SetCapacity(capacity); }
+    uint32_t GetBufferCapacity(void) const { return m_bundleStore.GetCapacity(); }
+    void SetBeaconInterval(Time interval) { m_beaconInterval = interval; }
+    Time GetBeaconInterval(void) const { return m_beaconInterval; }
+    Time GetBundleTtl(void) const { return m_bundleTtl; }
+    // Fixes the random streams used by this application; returns how many
+    virtual int64_t AssignStreams(int64_t stream);
+
+    void SendBundle(uint32_t destination, uint32_t priority, std::string payload);
+
+    const DtnApplicationStats& GetStats(void) const { return m_stats; }
+    uint32_t GetBufferedBundles(void) const { return m_bundleStore.GetSize(); }
+    // Between StartApplication and StopApplication
+    bool IsRunning(void) const { return m_socket != 0; }
+
+    // Buffer, duplicate and delivery-report indexes, bundle ids and what the
+    // routing strategy (or a derived application's model) learnt. Contacts,
+    // frames in flight, custody offers, counters and energy are not kept:
+    // a restored node rediscovers its neighbours with its next beacons.
+    void SaveState(DtnApplicationState& state) const;
+    // Applied at once while running, otherwise at the end of StartApplication
+    // so a derived application's initialisation does not overwrite it
+    void RestoreState(const DtnApplicationState& state);
+
+    // Defaults to the first energy source aggregated to the node at start
+    void SetEnergySource(Ptr<energy::EnergySource> source) { m_energySource = source; }
+    Ptr<energy::EnergySource> GetEnergySource(void) const { return m_energySource; }
+    // Remaining fraction of the initial energy; 1 without an energy source
+    double GetBatteryLevel(void) const;
+    // J drawn from the energy source so far
+    double GetEnergyConsumed(void) const;
+
+    // Radio duty cycle, always on by default; takes effect at start
+    void SetWakeupSchedule(const DtnWakeupSchedule& schedule) { m_wakeupSchedule = schedule; }
+    const DtnWakeupSchedule& GetWakeupSchedule(void) const { return m_wakeupSchedule; }
+    bool IsAwake(void) const { return m_sleepScheduler.IsAwake(); }
+    // Fraction of the running time the radio was on; 1 without a schedule
+    double GetAwakeFraction(void) const;
+
+    typedef void (*BundleTracedCallback)(const DtnBundle& bundle);
+    typedef void (*ContactTracedCallback)(uint32_t node, uint32_t peer);
+    typedef void (*ForwardTracedCallback)(const DtnBundle& bundle, uint32_t node, uint32_t peer);
+
+    // Message flow trace shared by every DTN application of the run
+    static DtnTraceWriter& GetTrace(void);
+    // Payloads shared by every DTN application of the running simulation,
+    // cleared by Simulator::Destroy()
+    static DtnPayloadPool& GetPayloadPool(void);
+
+protected:
+    virtual void DoDispose(void);
+    virtual void StartApplication(void);
+    virtual void StopApplication(void);
+
+    // Created or received bundle, before it is delivered or stored
+    virtual void InitializeBundle(DtnBundle& bundle) {}
+    virtual void NotifyBundleDelivered(const DtnBundle& bundle) {}
+    // Contact opened; runs before our summary vector goes out
+    virtual void NotifyContactUp(uint32_t peer) {}
+    virtual void NotifyContactDown(uint32_t peer) {}
+    // Bundles and seen keys up to now have just been expired
+    virtual void NotifyExpiry(Time now) {}
+    virtual void PrepareBeacon(DtnBeaconHeader& beacon) {}
+    virtual void ReceiveBeacon(const DtnBeaconHeader& beacon) {}
+    virtual void PrepareSummaryVector(DtnSummaryVectorHeader& vector);
+    // Default: one encounter for the strategy, then route to the peer
+    virtual void ReceiveSummaryVector(DtnNeighbor& neighbor, const DtnSummaryVectorHeader& vector);
+    // Default: RouteToNeighbor() for every contact whose vector is known
+    virtual void DoRoutingPass(void);
+    // Strategy-driven anti-entropy push to one contact
+    virtual void RouteToNeighbor(DtnNeighbor& neighbor);
+    // Worth of keeping a bundle under DTN_DROP_LEAST_RETENTION, lowest evicted
+    // first. Default: fraction of TTL left x priority weight (1, 0.8, 0.5, 0.2)
+    virtual double GetRetentionScore(const DtnBundle& bundle, Time now);
+    // A custody ACK from peer covered key, before any copy held here is
+    // released; delivered when peer is the bundle's destination
+    virtual void NotifyCustodyAccepted(uint64_t key, uint32_t peer, bool delivered) {}
+    // First report (summary vector or custody ACK) that key was delivered elsewhere
+    virtual void NotifyDeliveryReport(uint64_t key) {}
+    // A derived application's own part of SaveState()/RestoreState()
+    virtual void DoSaveState(DtnApplicationState& state) const {}
+    virtual void DoRestoreState(const DtnApplicationState& state) {}
+
+    // Expected radio energy of sending bundle once (J), TxEnergyPerByte per header and payload byte
+    double GetTransmitEnergy(const DtnBundle& bundle) const;
+    // The energy source can pay for forwarding bundle to peer, on top of the
+    // energy committed to sends earlier in the same pass, and stay above the
+    // LowBatteryThreshold reserve, which only deliveries may dip into;
+    // counts forwardsSuppressed when it cannot. Call it for a forward about
+    // to be made, not to filter candidates
+    bool CanAffordForward(const DtnBundle& bundle, uint32_t peer, double committed);
+
+    // Schedules one routing pass for a burst of changes and re-arms expiry
+    void BufferChanged(void);
+    // Sends a copy carrying copies to the neighbour and records the exchange
+    void ForwardBundle(DtnBundle& bundle, uint32_t copies, DtnNeighbor& neighbor);
+    static bool IsLive(const DtnBundle& bundle, Time now) {
+        return !bundle.delivered && (now - bundle.creationTime) < bundle.ttl;
+    }
+    // Offered to a contact under custody transfer and not yet timed out
+    static bool AwaitingCustody(const DtnBundle& bundle, Time now) {
+        return bundle.custodyDeadline > now;
+    }
+
+    uint32_t m_nodeId;
+    uint32_t m_nodeType;
+    BundleStore<DtnBundle> m_bundleStore;
+    SeenBundleIndex m_seenBundles;  // Keys stored or delivered here, until TTL
+    SeenBundleIndex m_deliveryReports;  // Keys known delivered anywhere, gossiped in summary vectors
+    Ptr<RoutingStrategy> m_routingStrategy;  // Epidemic, PROPHET or Spray-and-Wait
+    NeighborTable m_neighbors;  // Nodes currently in contact
+    Ptr<UniformRandomVariable> m_rng;  // Every stochastic choice of this node draws from here
+    DtnApplicationStats m_stats;
+    Time m_beaconInterval;
+
+private:
+    void HandleRead(Ptr<Socket> socket);
+    void HandleBundle(Ptr<Packet> packet, const Address& from);
+    void HandleBatch(Ptr<Packet> packet, const Address& from);
+    void HandleFragment(Ptr<Packet> packet, const Address& from);
+    void HandleCustodyAck(Ptr<Packet> packet, const Address& from);
+    // Single, unbatched or reassembled bundle with its header removed
+    void AcceptBundle(const DtnBundleHeader& header, Ptr<Packet> payload, const Address& from);
+    void HandleSummaryVector(Ptr<Packet> packet, const Address& from);
+    void HandleBeacon(Ptr<Packet> packet, const Address& from);
+    void ReceiveBundle(DtnBundle& bundle);
+    // Inserts, evicting per the drop policy when full; false if refused
+    bool StoreBundle(const DtnBundle& bundle);
+    void SendBeacon(void);
+    // Interval 0 is the goodbye before sleeping
+    void BroadcastBeacon(Time interval);
+    void SendSummaryVector(const Address& to);
+    void ContactUp(uint32_t peer);
+    void ContactDown(uint32_t peer);
+    void UpdatePeakBuffered(void);
+    void ApplyState(const DtnApplicationState& state);
+    void RoutingPass(void);
+    void ScheduleExpiry(void);
+    void ExpireBundles(void);
+
+    // Frame a bundle record (header + payload) for a contact; batched frames
+    // go out at the end of the current event or when the next would overflow
+    void QueueRecord(const Address& to, Ptr<Packet> record);
+    void SendFragments(const DtnBundleHeader& header, Ptr<Packet> payload, const Address& to);
+    void SendFrame(Ptr<Packet> frame, DtnMessageType type, const Address& to);
+    void FlushFrames(void);
+    void ExpireReassemblies(Time now);
+
+    // Adds the bundle to the next ACK to its sender if custody was asked
+    // for and the bundle is now stored or delivered here
+    void AcknowledgeCustody(const DtnBundleHeader& header, const Address& from);
+    void SendCustodyAcks(void);
+    void ReleaseCustody(uint64_t key, uint32_t peer, bool delivered);
+    // Records a delivery heard of and, with vaccination, purges the copy here
+    void LearnDelivery(uint64_t key, Time expiry);
+    // Routing pass once the earliest custody offer has timed out
+    void CustodyRetry(void);
+    // Moves the retry to deadline if nothing earlier is pending
+    void ScheduleCustodyRetry(Time deadline);
+
+    // Sleep scheduler callbacks
+    void RadioWake(void);
+    void RadioSleep(void);
+    void SleepPhys(void);
+    void SlotEdge(void);
+    // A live emergency bundle is buffered that was never forwarded
+    bool HoldAwake(void);
+
+    // Keys waiting for the next custody ACK to one peer
+    struct PendingAck {
+        Address to;
+        std::vector<uint64_t> accepted;
+        std::vector<uint64_t> delivered;
+    };
+
+    // Records waiting to share one datagram to a contact
+    struct PendingFrame {
+        Address to;
+        std::vector<Ptr<Packet>> records;
+        uint32_t bytes;  // Frame size once sent
+    };
+    void SendPending(PendingFrame& frame);
+
+    // A fragmented bundle on its way in
+    struct Reassembly {
+        DtnBundleHeader header;
+        Time expiry;
+        DtnReassembly slices;
+    };
+
+    Ptr<Socket> m_socket;
+    uint16_t m_port;
+    Time m_bundleTtl;
+    uint32_t m_maxForwardsPerContact;  // 0 = unlimited
+    DtnDropPolicy m_dropPolicy;
+    DtnTransmitScheduling m_transmitScheduling;
+    uint32_t m_maxFrameSize;  // UDP payload bytes per bundle datagram
+    bool m_aggregation;
+    std::vector<PendingFrame> m_pendingFrames;
+    EventId m_flushEvent;
+    std::unordered_map<uint64_t, Reassembly> m_reassembly;  // By bundle key
+    bool m_vaccination;
+    bool m_custodyTransfer;
+    Time m_custodyTimeout;
+    Time m_custodyAckDelay;
+    Ptr<energy::EnergySource> m_energySource;  // Null: energy is not modelled
+    double m_txEnergyPerByte;
+    double m_lowBatteryThreshold;
+    DtnWakeupSchedule m_wakeupSchedule;
+    DtnSleepScheduler m_sleepScheduler;
+    Time m_sleepGuard;
+    Time m_sleepLinger;
+    std::vector<Ptr<WifiPhy>> m_phys;  // Wi-Fi PHYs of the node, put to sleep with the schedule
+    EventId m_phyEvent;  // PHYs sleep once the goodbye is out
+    std::vector<PendingAck> m_pendingAcks;
+    EventId m_custodyAckEvent;
+    EventId m_custodyRetryEvent;  // Armed at the earliest custody deadline
+    Time m_nextCustodyRetry;
+    // RouteToNeighbor scratch: eligible bundles per priority class
+    std::vector<DtnBundle*> m_candidates[BundleStore<DtnBundle>::PRIORITY_CLASSES];
+    uint32_t m_bundleCounter;
+    DtnApplicationState m_pendingState;  // Restored before start
+    bool m_statePending;
+    EventId m_beaconEvent;
+    EventId m_routingEvent;  // Pending routing pass after a buffer change
+    EventId m_expiryEvent;   // Armed at the earliest bundle expiry
+    Time m_nextExpiry;
+
+    TracedCallback<const DtnBundle&> m_createdTrace;
+    TracedCallback<const DtnBundle&> m_deliveredTrace;
+    TracedCallback<const DtnBundle&, uint32_t, uint32_t> m_forwardedTrace;
+    TracedCallback<uint32_t, uint32_t> m_contactUpTrace;
+    TracedCallback<uint32_t, uint32_t> m_contactDownTrace;
+};
+
+} // namespace ns3
+
+#endif // DTN_APPLICATION_H
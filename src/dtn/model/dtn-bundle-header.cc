@@ -0,0 +1,437 @@
+/*
+ * DTN Bundle Wire Format
+ * Bundle and message-type headers
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "dtn-bundle-header.h"
+#include <algorithm>
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED(DtnTypeHeader);
+NS_OBJECT_ENSURE_REGISTERED(DtnBundleHeader);
+NS_OBJECT_ENSURE_REGISTERED(DtnRecordHeader);
+NS_OBJECT_ENSURE_REGISTERED(DtnFragmentHeader);
+NS_OBJECT_ENSURE_REGISTERED(DtnCustodyAckHeader);
+
+void DtnRoutePath::Append(uint32_t node) {
+    if (m_size == MAX_HOPS) {
+        std::copy(m_nodes + 1, m_nodes + MAX_HOPS, m_nodes);
+        m_size--;
+        m_truncated = true;
+    }
+    m_nodes[m_size++] = node;
+}
+
+uint32_t DtnRoutePath::GetSerializedSize(void) const {
+    uint32_t size = 1;
+    for (uint32_t k = 0; k < m_size; ++k) {
+        uint32_t node = m_nodes[k];
+        do {
+            node >>= 7;
+            size++;
+        } while (node != 0);
+    }
+    return size;
+}
+
+void DtnRoutePath::Serialize(Buffer::Iterator& i) const {
+    i.WriteU8(m_size | (m_truncated ? 0x80 : 0));
+    for (uint32_t k = 0; k < m_size; ++k) {
+        uint32_t node = m_nodes[k];
+        while (node >= 0x80) {
+            i.WriteU8(static_cast<uint8_t>(node) | 0x80);
+            node >>= 7;
+        }
+        i.WriteU8(static_cast<uint8_t>(node));
+    }
+}
+
+bool DtnRoutePath::Deserialize(Buffer::Iterator& i) {
+    m_size = 0;
+    m_truncated = false;
+    if (i.GetRemainingSize() == 0) {
+        return false;
+    }
+    uint8_t count = i.ReadU8();
+    m_truncated = (count & 0x80) != 0;
+    count &= 0x7F;
+    for (uint8_t k = 0; k < count; ++k) {
+        uint32_t node = 0;
+        uint8_t byte;
+        uint32_t shift = 0;
+        do {
+            if (i.GetRemainingSize() == 0) {
+                return false;
+            }
+            byte = i.ReadU8();
+            if (shift < 32) {
+                node |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            }
+            shift += 7;
+        } while (byte & 0x80);
+        // A longer path than ours keeps its newest hops
+        if (m_size == MAX_HOPS) {
+            std::copy(m_nodes + 1, m_nodes + MAX_HOPS, m_nodes);
+            m_size--;
+            m_truncated = true;
+        }
+        m_nodes[m_size++] = node;
+    }
+    return true;
+}
+
+TypeId DtnTypeHeader::GetTypeId(void) {
+    static TypeId tid = TypeId("ns3::DtnTypeHeader")
+        .SetParent<Header>()
+        .SetGroupName("Dtn")
+        .AddConstructor<DtnTypeHeader>();
+    return tid;
+}
+
+DtnTypeHeader::DtnTypeHeader(DtnMessageType type)
+    : m_type(type),
+      m_valid(true) {
+}
+
+DtnTypeHeader::~DtnTypeHeader() {
+}
+
+TypeId DtnTypeHeader::GetInstanceTypeId(void) const {
+    return GetTypeId();
+}
+
+uint32_t DtnTypeHeader::GetSerializedSize(void) const {
+    return 1;
+}
+
+void DtnTypeHeader::Serialize(Buffer::Iterator start) const {
+    start.WriteU8(static_cast<uint8_t>(m_type));
+}
+
+uint32_t DtnTypeHeader::Deserialize(Buffer::Iterator start) {
+    Buffer::Iterator i = start;
+    uint8_t type = i.ReadU8();
+    m_valid = true;
+    switch (type) {
+        case DTN_BUNDLE:
+        case DTN_SUMMARY_VECTOR:
+        case DTN_BEACON:
+        case DTN_BUNDLE_BATCH:
+        case DTN_BUNDLE_FRAGMENT:
+        case DTN_CUSTODY_ACK:
+            m_type = static_cast<DtnMessageType>(type);
+            break;
+        default:
+            m_valid = false;
+    }
+    return i.GetDistanceFrom(start);
+}
+
+void DtnTypeHeader::Print(std::ostream& os) const {
+    switch (m_type) {
+        case DTN_BUNDLE: os << "BUNDLE"; break;
+        case DTN_SUMMARY_VECTOR: os << "SUMMARY_VECTOR"; break;
+        case DTN_BEACON: os << "BEACON"; break;
+        case DTN_BUNDLE_BATCH: os << "BUNDLE_BATCH"; break;
+        case DTN_BUNDLE_FRAGMENT: os << "BUNDLE_FRAGMENT"; break;
+        case DTN_CUSTODY_ACK: os << "CUSTODY_ACK"; break;
+        default: os << "UNKNOWN";
+    }
+}
+
+TypeId DtnBundleHeader::GetTypeId(void) {
+    static TypeId tid = TypeId("ns3::DtnBundleHeader")
+        .SetParent<Header>()
+        .SetGroupName("Dtn")
+        .AddConstructor<DtnBundleHeader>();
+    return tid;
+}
+
+DtnBundleHeader::DtnBundleHeader()
+    : m_bundleId(0),
+      m_sourceNode(0),
+      m_destinationNode(0),
+      m_priority(2),
+      m_hopCount(0),
+      m_copies(1),
+      m_creationTime(Seconds(0.0)),
+      m_ttl(Seconds(0.0)),
+      m_flags(0),
+      m_valid(true) {
+}
+
+DtnBundleHeader::~DtnBundleHeader() {
+}
+
+TypeId DtnBundleHeader::GetInstanceTypeId(void) const {
+    return GetTypeId();
+}
+
+uint32_t DtnBundleHeader::GetSerializedSize(void) const {
+    return 29 + m_routePath.GetSerializedSize();
+}
+
+void DtnBundleHeader::Serialize(Buffer::Iterator start) const {
+    start.WriteHtonU32(m_bundleId);
+    start.WriteHtonU32(m_sourceNode);
+    start.WriteHtonU32(m_destinationNode);
+    start.WriteU8(m_priority);
+    start.WriteU8(m_hopCount);
+    start.WriteHtonU16(m_copies);
+    start.WriteHtonU64(static_cast<uint64_t>(m_creationTime.GetNanoSeconds()));
+    start.WriteHtonU32(static_cast<uint32_t>(m_ttl.GetMilliSeconds()));
+    start.WriteU8(m_flags);
+    m_routePath.Serialize(start);
+}
+
+uint32_t DtnBundleHeader::Deserialize(Buffer::Iterator start) {
+    Buffer::Iterator i = start;
+    m_valid = false;
+    if (i.GetRemainingSize() < 29) {
+        return 0;
+    }
+    m_bundleId = i.ReadNtohU32();
+    m_sourceNode = i.ReadNtohU32();
+    m_destinationNode = i.ReadNtohU32();
+    m_priority = i.ReadU8();
+    m_hopCount = i.ReadU8();
+    m_copies = i.ReadNtohU16();
+    m_creationTime = NanoSeconds(i.ReadNtohU64());
+    m_ttl = MilliSeconds(i.ReadNtohU32());
+    m_flags = i.ReadU8();
+    m_valid = m_routePath.Deserialize(i);
+    return i.GetDistanceFrom(start);
+}
+
+void DtnBundleHeader::Print(std::ostream& os) const {
+    os << "bundle=" << m_bundleId
+       << " src=" << m_sourceNode
+       << " dst=" << m_destinationNode
+       << " prio=" << static_cast<uint32_t>(m_priority)
+       << " hops=" << static_cast<uint32_t>(m_hopCount)
+       << " copies=" << m_copies
+       << " created=" << m_creationTime.GetSeconds() << "s"
+       << " ttl=" << m_ttl.GetSeconds() << "s";
+    if (IsCustodyRequested()) {
+        os << " custody";
+    }
+    os << " path=";
+    for (uint32_t k = 0; k < m_routePath.GetSize(); ++k) {
+        os << (k ? ">" : (m_routePath.IsTruncated() ? "..>" : "")) << m_routePath.Get(k);
+    }
+}
+
+TypeId DtnRecordHeader::GetTypeId(void) {
+    static TypeId tid = TypeId("ns3::DtnRecordHeader")
+        .SetParent<Header>()
+        .SetGroupName("Dtn")
+        .AddConstructor<DtnRecordHeader>();
+    return tid;
+}
+
+DtnRecordHeader::DtnRecordHeader(uint16_t length)
+    : m_length(length) {
+}
+
+DtnRecordHeader::~DtnRecordHeader() {
+}
+
+TypeId DtnRecordHeader::GetInstanceTypeId(void) const {
+    return GetTypeId();
+}
+
+uint32_t DtnRecordHeader::GetSerializedSize(void) const {
+    return 2;
+}
+
+void DtnRecordHeader::Serialize(Buffer::Iterator start) const {
+    start.WriteHtonU16(m_length);
+}
+
+uint32_t DtnRecordHeader::Deserialize(Buffer::Iterator start) {
+    Buffer::Iterator i = start;
+    m_length = i.ReadNtohU16();
+    return i.GetDistanceFrom(start);
+}
+
+void DtnRecordHeader::Print(std::ostream& os) const {
+    os << "record=" << m_length << "B";
+}
+
+TypeId DtnFragmentHeader::GetTypeId(void) {
+    static TypeId tid = TypeId("ns3::DtnFragmentHeader")
+        .SetParent<Header>()
+        .SetGroupName("Dtn")
+        .AddConstructor<DtnFragmentHeader>();
+    return tid;
+}
+
+DtnFragmentHeader::DtnFragmentHeader(uint32_t offset, uint32_t totalLength)
+    : m_offset(offset),
+      m_totalLength(totalLength) {
+}
+
+DtnFragmentHeader::~DtnFragmentHeader() {
+}
+
+TypeId DtnFragmentHeader::GetInstanceTypeId(void) const {
+    return GetTypeId();
+}
+
+uint32_t DtnFragmentHeader::GetSerializedSize(void) const {
+    return 8;
+}
+
+void DtnFragmentHeader::Serialize(Buffer::Iterator start) const {
+    start.WriteHtonU32(m_offset);
+    start.WriteHtonU32(m_totalLength);
+}
+
+uint32_t DtnFragmentHeader::Deserialize(Buffer::Iterator start) {
+    Buffer::Iterator i = start;
+    m_offset = i.ReadNtohU32();
+    m_totalLength = i.ReadNtohU32();
+    return i.GetDistanceFrom(start);
+}
+
+void DtnFragmentHeader::Print(std::ostream& os) const {
+    os << "offset=" << m_offset << " total=" << m_totalLength;
+}
+
+bool DtnReassembly::AddSlice(uint32_t offset, Ptr<Packet> slice) {
+    if (static_cast<uint64_t>(offset) + slice->GetSize() > m_totalLength) {
+        return false;
+    }
+    m_slices.emplace(offset, slice);
+    return true;
+}
+
+bool DtnReassembly::IsComplete(void) const {
+    uint32_t covered = 0;
+    for (const auto& slice : m_slices) {
+        if (slice.first > covered) {
+            return false;
+        }
+        covered = std::max(covered, slice.first + slice.second->GetSize());
+    }
+    return covered >= m_totalLength;
+}
+
+Ptr<Packet> DtnReassembly::Assemble(void) const {
+    Ptr<Packet> payload = Create<Packet>();
+    uint32_t covered = 0;
+    for (const auto& slice : m_slices) {
+        uint32_t end = slice.first + slice.second->GetSize();
+        if (end > covered) {
+            payload->AddAtEnd(slice.second->CreateFragment(covered - slice.first, end - covered));
+            covered = end;
+        }
+    }
+    return payload;
+}
+
+
+TypeId DtnCustodyAckHeader::GetTypeId(void) {
+    static TypeId tid = TypeId("ns3::DtnCustodyAckHeader")
+        .SetParent<Header>()
+        .SetGroupName("Dtn")
+        .AddConstructor<DtnCustodyAckHeader>();
+    return tid;
+}
+
+DtnCustodyAckHeader::DtnCustodyAckHeader()
+    : m_senderNode(0),
+      m_valid(true) {
+}
+
+DtnCustodyAckHeader::~DtnCustodyAckHeader() {
+}
+
+std::vector<DtnCustodyAckHeader> DtnCustodyAckHeader::Split(uint32_t maxSize) const {
+    // Keys are 8 bytes, so no part can hold more than a 16-bit count
+    NS_ASSERT(maxSize <= 0xFFFF && maxSize >= GetMinimumSize() + 8);
+    std::vector<DtnCustodyAckHeader> parts(1);
+    parts[0].m_senderNode = m_senderNode;
+    uint32_t size = GetMinimumSize();
+    auto room = [&]() -> DtnCustodyAckHeader& {
+        if (size + 8 > maxSize) {
+            parts.push_back(DtnCustodyAckHeader());
+            parts.back().m_senderNode = m_senderNode;
+            size = GetMinimumSize();
+        }
+        size += 8;
+        return parts.back();
+    };
+    for (uint64_t key : m_acceptedKeys) {
+        room().m_acceptedKeys.push_back(key);
+    }
+    for (uint64_t key : m_deliveredKeys) {
+        room().m_deliveredKeys.push_back(key);
+    }
+    return parts;
+}
+
+TypeId DtnCustodyAckHeader::GetInstanceTypeId(void) const {
+    return GetTypeId();
+}
+
+uint32_t DtnCustodyAckHeader::GetSerializedSize(void) const {
+    return 4 + 2 + 8 * m_acceptedKeys.size() + 2 + 8 * m_deliveredKeys.size();
+}
+
+void DtnCustodyAckHeader::Serialize(Buffer::Iterator start) const {
+    NS_ASSERT_MSG(m_acceptedKeys.size() <= 0xFFFF && m_deliveredKeys.size() <= 0xFFFF,
+                  "Split() a custody ACK of " << m_acceptedKeys.size() << " + " << m_deliveredKeys.size()
+                  << " keys");
+    start.WriteHtonU32(m_senderNode);
+    start.WriteHtonU16(static_cast<uint16_t>(m_acceptedKeys.size()));
+    for (uint64_t key : m_acceptedKeys) {
+        start.WriteHtonU64(key);
+    }
+    start.WriteHtonU16(static_cast<uint16_t>(m_deliveredKeys.size()));
+    for (uint64_t key : m_deliveredKeys) {
+        start.WriteHtonU64(key);
+    }
+}
+
+uint32_t DtnCustodyAckHeader::Deserialize(Buffer::Iterator start) {
+    Buffer::Iterator i = start;
+    m_valid = false;
+    m_acceptedKeys.clear();
+    m_deliveredKeys.clear();
+    if (i.GetRemainingSize() < GetMinimumSize()) {
+        return 0;
+    }
+    m_senderNode = i.ReadNtohU32();
+    uint16_t acceptedCount = i.ReadNtohU16();
+    // The delivered count follows the accepted keys
+    if (i.GetRemainingSize() < 8u * acceptedCount + 2) {
+        return i.GetDistanceFrom(start);
+    }
+    m_acceptedKeys.reserve(acceptedCount);
+    for (uint16_t k = 0; k < acceptedCount; ++k) {
+        m_acceptedKeys.push_back(i.ReadNtohU64());
+    }
+    uint16_t deliveredCount = i.ReadNtohU16();
+    if (i.GetRemainingSize() < 8u * deliveredCount) {
+        m_acceptedKeys.clear();
+        return i.GetDistanceFrom(start);
+    }
+    m_deliveredKeys.reserve(deliveredCount);
+    for (uint16_t k = 0; k < deliveredCount; ++k) {
+        m_deliveredKeys.push_back(i.ReadNtohU64());
+    }
+    m_valid = true;
+    return i.GetDistanceFrom(start);
+}
+
+void DtnCustodyAckHeader::Print(std::ostream& os) const {
+    os << "sender=" << m_senderNode << " accepted=" << m_acceptedKeys.size()
+       << " delivered=" << m_deliveredKeys.size();
+}
+
+} // namespace ns3
@@ -0,0 +1,288 @@
+/*
+ * DTN Bundle Wire Format
+ * Compact binary bundle header
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#ifndef DTN_BUNDLE_HEADER_H
+#define DTN_BUNDLE_HEADER_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include <iostream>
+#include <map>
+#include <vector>
+
+namespace ns3 {
+
+// Globally unique bundle key: (source node, per-source bundle id)
+inline uint64_t MakeBundleKey(uint32_t sourceNode, uint32_t bundleId) {
+    return (static_cast<uint64_t>(sourceNode) << 32) | bundleId;
+}
+
+// DTN control and data message types
+enum DtnMessageType {
+    DTN_BUNDLE = 1,          // DtnBundleHeader + payload
+    DTN_SUMMARY_VECTOR = 2,  // DtnSummaryVectorHeader
+    DTN_BEACON = 3,          // DtnBeaconHeader
+    DTN_BUNDLE_BATCH = 4,    // (DtnRecordHeader + DtnBundleHeader + payload)*
+    DTN_BUNDLE_FRAGMENT = 5, // DtnBundleHeader + DtnFragmentHeader + payload slice
+    DTN_CUSTODY_ACK = 6      // DtnCustodyAckHeader
+};
+
+// DtnBundleHeader flags
+enum DtnBundleFlags {
+    DTN_BUNDLE_FLAG_CUSTODY = 0x01  // Sender hands over custody and waits for a DtnCustodyAckHeader
+};
+
+/*
+ * Bounded provenance of a bundle copy: the newest MAX_HOPS nodes that held
+ * it, oldest first, ending with the current holder. Kept inline (no heap
+ * per copy) and carried in DtnBundleHeader as one LEB128 varint per node,
+ * so each hop through a node id below 128 costs one byte.
+ *
+ * Wire layout: count(1, bit 7 = older hops dropped) node(varint)*
+ */
+class DtnRoutePath {
+public:
+    static const uint32_t MAX_HOPS = 16;
+
+    DtnRoutePath()
+        : m_size(0),
+          m_truncated(false) {
+    }
+
+    // Drops the oldest hop once MAX_HOPS are held
+    void Append(uint32_t node);
+    uint32_t GetSize(void) const { return m_size; }
+    uint32_t Get(uint32_t index) const { return m_nodes[index]; }
+    bool IsTruncated(void) const { return m_truncated; }
+    // Holder before the current one, fallback if it is the first known
+    uint32_t GetPreviousHop(uint32_t fallback) const {
+        return m_size > 1 ? m_nodes[m_size - 2] : fallback;
+    }
+
+    uint32_t GetSerializedSize(void) const;
+    void Serialize(Buffer::Iterator& i) const;
+    // False if the buffer ends inside the path; nothing past it is read
+    bool Deserialize(Buffer::Iterator& i);
+
+private:
+    uint32_t m_nodes[MAX_HOPS];
+    uint8_t m_size;
+    bool m_truncated;
+};
+
+/*
+ * One-byte message type prepended to every DTN datagram so receivers can
+ * dispatch before parsing the rest of the packet.
+ */
+class DtnTypeHeader : public Header {
+public:
+    static TypeId GetTypeId(void);
+    DtnTypeHeader(DtnMessageType type = DTN_BUNDLE);
+    virtual ~DtnTypeHeader();
+
+    DtnMessageType GetType(void) const { return m_type; }
+    bool IsValid(void) const { return m_valid; }
+
+    virtual TypeId GetInstanceTypeId(void) const;
+    virtual uint32_t GetSerializedSize(void) const;
+    virtual void Serialize(Buffer::Iterator start) const;
+    virtual uint32_t Deserialize(Buffer::Iterator start);
+    virtual void Print(std::ostream& os) const;
+
+private:
+    DtnMessageType m_type;
+    bool m_valid;
+};
+
+/*
+ * Bundle header prepended to the payload of every forwarded bundle.
+ * The payload itself stays in the Packet behind the header, so receivers
+ * can keep it as a packet fragment instead of copying it out.
+ *
+ * Wire layout (network byte order, 30 bytes and up):
+ *   bundleId(4) source(4) destination(4) priority(1) hopCount(1)
+ *   copies(2) creationTime(8, ns) ttl(4, ms) flags(1) routePath(1+)
+ *
+ * copies is the Spray-and-Wait budget handed to the receiver; flags are
+ * DtnBundleFlags; routePath ends with the sender. A datagram that ends
+ * before the header does (the path's hop count and varints come off the
+ * wire) deserializes as !IsValid() instead of reading past the buffer.
+ */
+class DtnBundleHeader : public Header {
+public:
+    static TypeId GetTypeId(void);
+    DtnBundleHeader();
+    virtual ~DtnBundleHeader();
+
+    void SetBundleId(uint32_t bundleId) { m_bundleId = bundleId; }
+    uint32_t GetBundleId(void) const { return m_bundleId; }
+    void SetSourceNode(uint32_t source) { m_sourceNode = source; }
+    uint32_t GetSourceNode(void) const { return m_sourceNode; }
+    void SetDestinationNode(uint32_t destination) { m_destinationNode = destination; }
+    uint32_t GetDestinationNode(void) const { return m_destinationNode; }
+    void SetPriority(uint8_t priority) { m_priority = priority; }
+    uint8_t GetPriority(void) const { return m_priority; }
+    void SetHopCount(uint8_t hopCount) { m_hopCount = hopCount; }
+    uint8_t GetHopCount(void) const { return m_hopCount; }
+    void SetCopies(uint16_t copies) { m_copies = copies; }
+    uint16_t GetCopies(void) const { return m_copies; }
+    void SetCreationTime(Time creationTime) { m_creationTime = creationTime; }
+    Time GetCreationTime(void) const { return m_creationTime; }
+    void SetTtl(Time ttl) { m_ttl = ttl; }
+    Time GetTtl(void) const { return m_ttl; }
+    void SetFlags(uint8_t flags) { m_flags = flags; }
+    uint8_t GetFlags(void) const { return m_flags; }
+    bool IsCustodyRequested(void) const { return (m_flags & DTN_BUNDLE_FLAG_CUSTODY) != 0; }
+    void SetRoutePath(const DtnRoutePath& path) { m_routePath = path; }
+    const DtnRoutePath& GetRoutePath(void) const { return m_routePath; }
+    bool IsValid(void) const { return m_valid; }
+
+    virtual TypeId GetInstanceTypeId(void) const;
+    virtual uint32_t GetSerializedSize(void) const;
+    virtual void Serialize(Buffer::Iterator start) const;
+    virtual uint32_t Deserialize(Buffer::Iterator start);
+    virtual void Print(std::ostream& os) const;
+
+private:
+    uint32_t m_bundleId;
+    uint32_t m_sourceNode;
+    uint32_t m_destinationNode;
+    uint8_t m_priority;  // 0=Emergency, 1=Medical, 2=General, 3=Low
+    uint8_t m_hopCount;
+    uint16_t m_copies;
+    Time m_creationTime;
+    Time m_ttl;
+    uint8_t m_flags;
+    DtnRoutePath m_routePath;
+    bool m_valid;
+};
+
+/*
+ * Length prefix of one bundle inside a DTN_BUNDLE_BATCH frame, so small
+ * bundles for the same contact share one datagram (and one MAC exchange).
+ *
+ * Wire layout: length(2) of the DtnBundleHeader + payload that follows.
+ */
+class DtnRecordHeader : public Header {
+public:
+    static TypeId GetTypeId(void);
+    DtnRecordHeader(uint16_t length = 0);
+    virtual ~DtnRecordHeader();
+
+    uint16_t GetLength(void) const { return m_length; }
+
+    virtual TypeId GetInstanceTypeId(void) const;
+    virtual uint32_t GetSerializedSize(void) const;
+    virtual void Serialize(Buffer::Iterator start) const;
+    virtual uint32_t Deserialize(Buffer::Iterator start);
+    virtual void Print(std::ostream& os) const;
+
+private:
+    uint16_t m_length;
+};
+
+/*
+ * Position of a DTN_BUNDLE_FRAGMENT's payload slice in the whole payload.
+ * Every fragment repeats the bundle header, so a receiver can reassemble
+ * slices from any mix of senders and hand on the bundle unchanged.
+ *
+ * Wire layout: offset(4) totalLength(4), payload bytes.
+ */
+class DtnFragmentHeader : public Header {
+public:
+    static TypeId GetTypeId(void);
+    DtnFragmentHeader(uint32_t offset = 0, uint32_t totalLength = 0);
+    virtual ~DtnFragmentHeader();
+
+    uint32_t GetOffset(void) const { return m_offset; }
+    uint32_t GetTotalLength(void) const { return m_totalLength; }
+
+    virtual TypeId GetInstanceTypeId(void) const;
+    virtual uint32_t GetSerializedSize(void) const;
+    virtual void Serialize(Buffer::Iterator start) const;
+    virtual uint32_t Deserialize(Buffer::Iterator start);
+    virtual void Print(std::ostream& os) const;
+
+private:
+    uint32_t m_offset;
+    uint32_t m_totalLength;
+};
+
+/*
+ * Payload slices of one fragmented bundle, by offset, until they cover
+ * it. Slices from senders with another frame size may overlap; each byte
+ * of the reassembled payload comes from the first slice holding it.
+ */
+class DtnReassembly {
+public:
+    explicit DtnReassembly(uint32_t totalLength = 0)
+        : m_totalLength(totalLength) {
+    }
+
+    uint32_t GetTotalLength(void) const { return m_totalLength; }
+
+    // False if the slice runs past the end; a second slice at an offset already held is ignored
+    bool AddSlice(uint32_t offset, Ptr<Packet> slice);
+    // True once the slices cover the payload without a gap
+    bool IsComplete(void) const;
+    // The whole payload; only valid once IsComplete()
+    Ptr<Packet> Assemble(void) const;
+
+private:
+    uint32_t m_totalLength;
+    std::map<uint32_t, Ptr<Packet>> m_slices;
+};
+
+/*
+ * Cumulative custody acknowledgement: every custody-requested bundle a
+ * node took from one peer during the ACK delay. Keys the acknowledging
+ * node is the destination of are listed as delivered, the rest as
+ * accepted into its buffer; either way the peer may release its copy.
+ * An ACK too large for one datagram goes out as several (see Split());
+ * each part releases its own keys, so parts need no reassembly. A
+ * datagram shorter than its key counts deserializes as !IsValid().
+ *
+ * Wire layout (network byte order):
+ *   sender(4) acceptedCount(2) key(8)* deliveredCount(2) key(8)*
+ */
+class DtnCustodyAckHeader : public Header {
+public:
+    static TypeId GetTypeId(void);
+    DtnCustodyAckHeader();
+    virtual ~DtnCustodyAckHeader();
+
+    void SetSenderNode(uint32_t sender) { m_senderNode = sender; }
+    uint32_t GetSenderNode(void) const { return m_senderNode; }
+    // A list of more than 65535 keys must be Split() before serializing
+    void SetAcceptedKeys(std::vector<uint64_t> keys) { m_acceptedKeys.swap(keys); }
+    const std::vector<uint64_t>& GetAcceptedKeys(void) const { return m_acceptedKeys; }
+    void SetDeliveredKeys(std::vector<uint64_t> keys) { m_deliveredKeys.swap(keys); }
+    const std::vector<uint64_t>& GetDeliveredKeys(void) const { return m_deliveredKeys; }
+    bool IsValid(void) const { return m_valid; }
+
+    // Parts of at most maxSize serialized bytes, accepted keys first
+    std::vector<DtnCustodyAckHeader> Split(uint32_t maxSize) const;
+
+    static uint32_t GetMinimumSize(void) { return 8; }
+
+    virtual TypeId GetInstanceTypeId(void) const;
+    virtual uint32_t GetSerializedSize(void) const;
+    virtual void Serialize(Buffer::Iterator start) const;
+    virtual uint32_t Deserialize(Buffer::Iterator start);
+    virtual void Print(std::ostream& os) const;
+
+private:
+    uint32_t m_senderNode;
+    std::vector<uint64_t> m_acceptedKeys;
+    std::vector<uint64_t> m_deliveredKeys;
+    bool m_valid;
+};
+
+} // namespace ns3
+
+#endif // DTN_BUNDLE_HEADER_H
@@ -0,0 +1,435 @@
+/*
+ * DTN Bundle Store
+ * Indexed, TTL-ordered store-and-forward buffer
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#ifndef DTN_BUNDLE_STORE_H
+#define DTN_BUNDLE_STORE_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "dtn-bundle-header.h"
+#include <algorithm>
+#include <functional>
+#include <deque>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+// What a full store gives up for a newcomer
+enum DtnDropPolicy {
+    DTN_DROP_TAIL,             // Refuse the newcomer
+    DTN_DROP_LOWEST_PRIORITY,  // Evict the oldest bundle of the lowest class no more urgent than the newcomer
+    DTN_DROP_LEAST_RETENTION   // Evict the bundle with the lowest retention score, if below the newcomer's
+};
+
+/*
+ * Store-and-forward buffer keyed by MakeBundleKey(sourceNode, bundleId).
+ *
+ *   - lookup, insert and remove by key are O(1) (hash index onto slots)
+ *   - bundles live in a pool of slots that grows to the peak occupancy and
+ *     is recycled through a free list, so a replicated bundle costs no heap
+ *     allocation beyond its index entry; the priority queues are linked
+ *     through the slots as well
+ *   - expiry pops a min-heap keyed on creationTime + ttl, O(log n) per
+ *     expired bundle instead of a full sweep per routing tick
+ *   - bundles sit in one FIFO queue per priority class (0=Emergency ... 3=Low),
+ *     so ForEach() visits them most urgent first
+ *   - when full, SelectVictim() names the bundle a drop policy would evict;
+ *     the caller removes it and inserts the newcomer
+ *
+ * Bundle must provide bundleId, sourceNode, priority, creationTime and ttl,
+ * and be default constructible (a freed slot is reset to Bundle()).
+ * Pointers from Find() and ForEach() stay valid until that bundle is
+ * removed. Removed bundles leave stale heap entries behind; they are
+ * skipped when popped and the heap is rebuilt once they outnumber the
+ * live bundles.
+ */
+template <typename Bundle>
+class BundleStore {
+public:
+    static const uint32_t PRIORITY_CLASSES = 4;
+
+    // Queue of a bundle priority; values past 3 share the Low class
+    static uint32_t PriorityClass(uint32_t priority) {
+        return std::min(priority, PRIORITY_CLASSES - 1);
+    }
+
+    explicit BundleStore(uint32_t capacity = 100);
+
+    void SetCapacity(uint32_t capacity) {
+        m_capacity = capacity;
+        m_index.reserve(capacity);
+    }
+    uint32_t GetCapacity(void) const { return m_capacity; }
+    uint32_t GetSize(void) const { return m_index.size(); }
+    bool IsEmpty(void) const { return m_index.empty(); }
+    bool IsFull(void) const { return m_index.size() >= m_capacity; }
+
+    bool Contains(uint64_t key) const { return m_index.find(key) != m_index.end(); }
+    Bundle* Find(uint64_t key);
+    const Bundle* Find(uint64_t key) const;
+
+    // Returns false if the store is full or already holds the bundle
+    bool Insert(const Bundle& bundle);
+    // Bundle to evict for incoming under policy, 0 to refuse it instead.
+    // score(bundle) ranks retention for DTN_DROP_LEAST_RETENTION (O(n) scan).
+    template <typename Score>
+    const Bundle* SelectVictim(const Bundle& incoming, DtnDropPolicy policy, Score score) const;
+    bool Remove(uint64_t key);
+
+    // Drops every bundle whose TTL has run out by now; returns how many
+    uint32_t ExpireBundles(Time now);
+    // Expiry time of the oldest live bundle, Time::Max() when empty
+    Time GetNextExpiry(void);
+
+    // Visits bundles most urgent priority class first, FIFO within a class.
+    // The callback returns false to stop early and must not insert or remove.
+    template <typename F>
+    void ForEach(F callback);
+    template <typename F>
+    void ForEach(F callback) const;
+
+    std::vector<uint64_t> GetKeys(void) const;
+
+private:
+    static const uint32_t NO_SLOT = 0xFFFFFFFF;
+
+    struct Slot {
+        Bundle bundle;
+        Time expiry;
+        uint32_t priorityClass;
+        uint32_t prev;  // Neighbours in the priority queue
+        uint32_t next;  // (next also chains the free list)
+    };
+    struct Queue {
+        uint32_t head;
+        uint32_t tail;
+    };
+    typedef std::pair<Time, uint64_t> ExpiryItem;
+
+    // Unlinks a live slot, resets it and returns it to the free list
+    void Release(uint32_t slot);
+    void DiscardStaleExpiries(void);
+    void CompactExpiryHeap(void);
+
+    uint32_t m_capacity;
+    std::deque<Slot> m_slots;  // Deque: growing never moves a stored bundle
+    uint32_t m_freeSlots;      // Head of the free list
+    std::unordered_map<uint64_t, uint32_t> m_index;  // Key -> slot
+    Queue m_queues[PRIORITY_CLASSES];
+    std::priority_queue<ExpiryItem, std::vector<ExpiryItem>, std::greater<ExpiryItem> > m_expiryHeap;
+};
+
+template <typename Bundle>
+BundleStore<Bundle>::BundleStore(uint32_t capacity)
+    : m_capacity(capacity),
+      m_freeSlots(NO_SLOT) {
+    for (Queue& queue : m_queues) {
+        queue.head = queue.tail = NO_SLOT;
+    }
+    m_index.reserve(capacity);
+}
+
+template <typename Bundle>
+Bundle* BundleStore<Bundle>::Find(uint64_t key) {
+    auto it = m_index.find(key);
+    return it == m_index.end() ? nullptr : &m_slots[it->second].bundle;
+}
+
+template <typename Bundle>
+const Bundle* BundleStore<Bundle>::Find(uint64_t key) const {
+    auto it = m_index.find(key);
+    return it == m_index.end() ? nullptr : &m_slots[it->second].bundle;
+}
+
+template <typename Bundle>
+bool BundleStore<Bundle>::Insert(const Bundle& bundle) {
+    uint64_t key = MakeBundleKey(bundle.sourceNode, bundle.bundleId);
+    if (IsFull() || Contains(key)) {
+        return false;
+    }
+
+    uint32_t slot = m_freeSlots;
+    if (slot != NO_SLOT) {
+        m_freeSlots = m_slots[slot].next;
+    } else {
+        slot = m_slots.size();
+        m_slots.emplace_back();
+    }
+    m_index[key] = slot;
+
+    Slot& entry = m_slots[slot];
+    entry.bundle = bundle;
+    entry.expiry = bundle.creationTime + bundle.ttl;
+    entry.priorityClass = PriorityClass(bundle.priority);
+
+    Queue& queue = m_queues[entry.priorityClass];
+    entry.prev = queue.tail;
+    entry.next = NO_SLOT;
+    if (queue.tail != NO_SLOT) {
+        m_slots[queue.tail].next = slot;
+    } else {
+        queue.head = slot;
+    }
+    queue.tail = slot;
+
+    m_expiryHeap.push(ExpiryItem(entry.expiry, key));
+    return true;
+}
+
+template <typename Bundle>
+template <typename Score>
+const Bundle* BundleStore<Bundle>::SelectVictim(const Bundle& incoming, DtnDropPolicy policy, Score score) const {
+    if (m_index.empty()) {
+        return nullptr;
+    }
+
+    switch (policy) {
+        case DTN_DROP_LOWEST_PRIORITY:
+            for (uint32_t p = PRIORITY_CLASSES; p-- > PriorityClass(incoming.priority);) {
+                if (m_queues[p].head != NO_SLOT) {
+                    return &m_slots[m_queues[p].head].bundle;
+                }
+            }
+            return nullptr;
+
+        case DTN_DROP_LEAST_RETENTION: {
+            const Bundle* victim = nullptr;
+            double lowest = score(incoming);
+            for (const auto& entry : m_index) {
+                const Bundle& held = m_slots[entry.second].bundle;
+                double retention = score(held);
+                if (retention < lowest) {
+                    lowest = retention;
+                    victim = &held;
+                }
+            }
+            return victim;
+        }
+
+        case DTN_DROP_TAIL:
+        default:
+            return nullptr;
+    }
+}
+
+template <typename Bundle>
+void BundleStore<Bundle>::Release(uint32_t slot) {
+    Slot& entry = m_slots[slot];
+    Queue& queue = m_queues[entry.priorityClass];
+    if (entry.prev != NO_SLOT) {
+        m_slots[entry.prev].next = entry.next;
+    } else {
+        queue.head = entry.next;
+    }
+    if (entry.next != NO_SLOT) {
+        m_slots[entry.next].prev = entry.prev;
+    } else {
+        queue.tail = entry.prev;
+    }
+
+    // Drops the payload reference now rather than when the slot is reused
+    entry.bundle = Bundle();
+    entry.next = m_freeSlots;
+    m_freeSlots = slot;
+}
+
+template <typename Bundle>
+bool BundleStore<Bundle>::Remove(uint64_t key) {
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+        return false;
+    }
+    Release(it->second);
+    m_index.erase(it);
+
+    if (m_expiryHeap.size() > 2 * m_index.size() + 16) {
+        CompactExpiryHeap();
+    }
+    return true;
+}
+
+template <typename Bundle>
+uint32_t BundleStore<Bundle>::ExpireBundles(Time now) {
+    uint32_t expired = 0;
+    while (!m_expiryHeap.empty() && m_expiryHeap.top().first <= now) {
+        ExpiryItem item = m_expiryHeap.top();
+        m_expiryHeap.pop();
+
+        auto it = m_index.find(item.second);
+        if (it != m_index.end() && m_slots[it->second].expiry == item.first) {
+            Release(it->second);
+            m_index.erase(it);
+            expired++;
+        }
+    }
+    return expired;
+}
+
+template <typename Bundle>
+Time BundleStore<Bundle>::GetNextExpiry(void) {
+    DiscardStaleExpiries();
+    return m_expiryHeap.empty() ? Time::Max() : m_expiryHeap.top().first;
+}
+
+template <typename Bundle>
+template <typename F>
+void BundleStore<Bundle>::ForEach(F callback) {
+    for (uint32_t p = 0; p < PRIORITY_CLASSES; ++p) {
+        for (uint32_t slot = m_queues[p].head; slot != NO_SLOT; slot = m_slots[slot].next) {
+            if (!callback(m_slots[slot].bundle)) {
+                return;
+            }
+        }
+    }
+}
+
+template <typename Bundle>
+template <typename F>
+void BundleStore<Bundle>::ForEach(F callback) const {
+    for (uint32_t p = 0; p < PRIORITY_CLASSES; ++p) {
+        for (uint32_t slot = m_queues[p].head; slot != NO_SLOT; slot = m_slots[slot].next) {
+            if (!callback(m_slots[slot].bundle)) {
+                return;
+            }
+        }
+    }
+}
+
+template <typename Bundle>
+std::vector<uint64_t> BundleStore<Bundle>::GetKeys(void) const {
+    std::vector<uint64_t> keys;
+    keys.reserve(m_index.size());
+    for (const auto& entry : m_index) {
+        keys.push_back(entry.first);
+    }
+    return keys;
+}
+
+template <typename Bundle>
+void BundleStore<Bundle>::DiscardStaleExpiries(void) {
+    while (!m_expiryHeap.empty()) {
+        auto it = m_index.find(m_expiryHeap.top().second);
+        if (it != m_index.end() && m_slots[it->second].expiry == m_expiryHeap.top().first) {
+            return;
+        }
+        m_expiryHeap.pop();
+    }
+}
+
+template <typename Bundle>
+void BundleStore<Bundle>::CompactExpiryHeap(void) {
+    std::vector<ExpiryItem> items;
+    items.reserve(m_index.size());
+    for (const auto& entry : m_index) {
+        items.push_back(ExpiryItem(m_slots[entry.second].expiry, entry.first));
+    }
+    m_expiryHeap = std::priority_queue<ExpiryItem, std::vector<ExpiryItem>, std::greater<ExpiryItem> >(
+        std::greater<ExpiryItem>(), std::move(items));
+}
+
+/*
+ * Keys of every bundle a node has stored or delivered, kept until the
+ * bundle's TTL runs out. Used to drop duplicates on receive and to build
+ * summary vectors; expiry uses the same lazy min-heap as BundleStore.
+ */
+class SeenBundleIndex {
+public:
+    bool Contains(uint64_t key) const { return m_keys.find(key) != m_keys.end(); }
+    uint32_t GetSize(void) const { return m_keys.size(); }
+
+    void Insert(uint64_t key, Time expiry) {
+        if (m_keys.insert(key).second) {
+            m_expiryHeap.push(std::make_pair(expiry, key));
+        }
+    }
+
+    void ExpireBundles(Time now) {
+        while (!m_expiryHeap.empty() && m_expiryHeap.top().first <= now) {
+            m_keys.erase(m_expiryHeap.top().second);
+            m_expiryHeap.pop();
+        }
+    }
+
+    std::vector<uint64_t> GetKeys(void) const {
+        return std::vector<uint64_t>(m_keys.begin(), m_keys.end());
+    }
+
+    // Keys with their expiry, earliest first; for snapshots
+    std::vector<std::pair<uint64_t, Time> > GetEntries(void) const {
+        std::vector<std::pair<uint64_t, Time> > entries;
+        entries.reserve(m_keys.size());
+        std::priority_queue<ExpiryItem, std::vector<ExpiryItem>, std::greater<ExpiryItem> > heap(m_expiryHeap);
+        while (!heap.empty()) {
+            entries.push_back(std::make_pair(heap.top().second, heap.top().first));
+            heap.pop();
+        }
+        return entries;
+    }
+
+private:
+    typedef std::pair<Time, uint64_t> ExpiryItem;
+    std::unordered_set<uint64_t> m_keys;
+    std::priority_queue<ExpiryItem, std::vector<ExpiryItem>, std::greater<ExpiryItem> > m_expiryHeap;
+};
+
+/*
+ * Intern table of bundle payloads. A payload never changes after
+ * creation, so every copy of a bundle (each node's store, each forward)
+ * shares the first one interned instead of holding its own. The key is
+ * trusted: whatever arrives under a key already interned is taken to be
+ * that payload and is not compared, so a copy corrupted on the way in is
+ * replaced by the canonical one. Keys are only unique within one
+ * simulation, so a pool must be cleared between runs.
+ * Interned payloads are compacted into their own buffer, so a stored
+ * bundle does not keep the datagram it arrived in (headers, batch
+ * neighbours) alive. Entries go at the bundle's TTL; copies still held
+ * keep their reference.
+ */
+class DtnPayloadPool {
+public:
+    // Canonical payload of key; payload is the copy at hand
+    Ptr<Packet> Intern(uint64_t key, Ptr<Packet> payload, Time expiry) {
+        auto it = m_payloads.find(key);
+        if (it != m_payloads.end()) {
+            return it->second;
+        }
+        std::vector<uint8_t> bytes(payload->GetSize());
+        payload->CopyData(bytes.data(), bytes.size());
+        Ptr<Packet> compact = Create<Packet>(bytes.data(), bytes.size());
+        m_payloads[key] = compact;
+        m_expiryHeap.push(std::make_pair(expiry, key));
+        return compact;
+    }
+
+    void ExpireBundles(Time now) {
+        while (!m_expiryHeap.empty() && m_expiryHeap.top().first <= now) {
+            m_payloads.erase(m_expiryHeap.top().second);
+            m_expiryHeap.pop();
+        }
+    }
+
+    void Clear(void) {
+        m_payloads.clear();
+        m_expiryHeap = std::priority_queue<ExpiryItem, std::vector<ExpiryItem>, std::greater<ExpiryItem> >();
+    }
+
+    uint32_t GetSize(void) const { return m_payloads.size(); }
+
+private:
+    typedef std::pair<Time, uint64_t> ExpiryItem;
+    std::unordered_map<uint64_t, Ptr<Packet>> m_payloads;
+    std::priority_queue<ExpiryItem, std::vector<ExpiryItem>, std::greater<ExpiryItem> > m_expiryHeap;
+};
+
+} // namespace ns3
+
+#endif // DTN_BUNDLE_STORE_H
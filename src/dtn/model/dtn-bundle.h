@@ -0,0 +1,75 @@
+/*
+ * DTN Bundle
+ * The one in-memory bundle type held by every DTN application, and the node taxonomy
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#ifndef DTN_BUNDLE_H
+#define DTN_BUNDLE_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "dtn-bundle-header.h"
+#include <vector>
+
+namespace ns3 {
+
+// Node roles of the disaster-response scenarios
+enum NodeType {
+    MOBILE_COMMAND_CENTER = 0,
+    EMERGENCY_RESPONDER = 1,
+    CIVILIAN_DEVICE = 2,
+    RESCUE_VEHICLE = 3,
+    AUTONOMOUS_DRONE = 4,
+    EMERGENCY_SHELTER = 5,
+    HOSPITAL_CENTER = 6,
+    IOT_SENSOR = 7
+};
+
+/*
+ * A stored bundle. The first block mirrors DtnBundleHeader and travels on
+ * the wire; the rest is local bookkeeping of the node holding this copy.
+ * BundleStore keys it on MakeBundleKey(sourceNode, bundleId).
+ */
+struct DtnBundle {
+    DtnBundle()
+        : bundleId(0),
+          sourceNode(0),
+          destinationNode(0),
+          priority(2),
+          hopCount(0),
+          copies(1),
+          delivered(false),
+          urgencyScore(0.0),
+          deliveryProbability(0.5),
+          energyCost(0.0),
+          retransmissionCount(0) {
+    }
+
+    uint32_t bundleId;
+    uint32_t sourceNode;
+    uint32_t destinationNode;
+    uint32_t priority;  // 0=Emergency, 1=Medical, 2=General, 3=Low
+    Time creationTime;
+    Time ttl;
+    uint32_t hopCount;
+    uint32_t copies;  // Spray-and-Wait copy budget held by this node
+    Ptr<Packet> payload;  // Interned in DtnPayloadPool, shared by every copy of the bundle
+
+    bool delivered;
+    DtnRoutePath routePath;  // Holders so far, ending with this node (newest MAX_HOPS)
+    Time lastForwardTime;
+    Time custodyDeadline;  // Custody offered to a contact; held back from others until then
+
+    // Annotations of the ML router (EnhancedDTNApplication)
+    double urgencyScore;
+    double deliveryProbability;
+    double energyCost;
+    uint32_t retransmissionCount;
+};
+
+} // namespace ns3
+
+#endif // DTN_BUNDLE_H
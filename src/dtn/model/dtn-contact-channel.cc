@@ -0,0 +1,163 @@
+/*
+ * DTN Contact Channel
+ * Abstract link that replays a contact plan instead of simulating the Wi-Fi PHY
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "dtn-contact-channel.h"
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("DtnContactChannel");
+
+NS_OBJECT_ENSURE_REGISTERED(DtnContactChannel);
+
+namespace {
+
+void RemovePeer(std::vector<uint32_t>& peers, uint32_t peer) {
+    auto it = std::find(peers.begin(), peers.end(), peer);
+    if (it != peers.end()) {
+        *it = peers.back();
+        peers.pop_back();
+    }
+}
+
+} // namespace
+
+TypeId DtnContactChannel::GetTypeId(void) {
+    static TypeId tid = TypeId("ns3::DtnContactChannel")
+        .SetParent<SimpleChannel>()
+        .SetGroupName("Dtn")
+        .AddConstructor<DtnContactChannel>()
+        .AddAttribute("Delay", "Latency of every frame between nodes in contact",
+                      TimeValue(MilliSeconds(2)),
+                      MakeTimeAccessor(&DtnContactChannel::m_delay),
+                      MakeTimeChecker());
+    return tid;
+}
+
+DtnContactChannel::DtnContactChannel()
+    : m_delay(MilliSeconds(2)),
+      m_nextEvent(0),
+      m_framesCarried(0) {
+}
+
+DtnContactChannel::~DtnContactChannel() {
+}
+
+void DtnContactChannel::DoDispose(void) {
+    NS_LOG_INFO("Contact channel carried " << m_framesCarried << " frames, replayed " << m_nextEvent
+                << " of " << m_events.size() << " contact events");
+    m_replayEvent.Cancel();
+    m_devices.clear();
+    m_endpoints.clear();
+    m_events.clear();
+    SimpleChannel::DoDispose();
+}
+
+void DtnContactChannel::Add(Ptr<SimpleNetDevice> device) {
+    NS_ABORT_MSG_UNLESS(device->GetNode(), "Add the device to its node before attaching it");
+    m_devices.push_back(device);
+    m_endpoints[device->GetNode()->GetId()].device = device;
+}
+
+std::size_t DtnContactChannel::GetNDevices(void) const {
+    return m_devices.size();
+}
+
+Ptr<NetDevice> DtnContactChannel::GetDevice(std::size_t i) const {
+    return m_devices[i];
+}
+
+void DtnContactChannel::Replay(const DtnContactPlan& plan) {
+    Time now = Simulator::Now();
+    std::vector<ContactEvent> events(m_events.begin() + m_nextEvent, m_events.end());
+    uint32_t skipped = 0;
+    for (const DtnContact& contact : plan.GetContacts()) {
+        if (!m_endpoints.count(contact.nodeA) || !m_endpoints.count(contact.nodeB)
+            || contact.nodeA == contact.nodeB) {
+            ++skipped;
+            continue;
+        }
+        if (contact.end <= now) {
+            continue;
+        }
+        events.push_back({std::max(contact.start, now), contact.nodeA, contact.nodeB, true});
+        if (contact.end != Time::Max()) {
+            events.push_back({contact.end, contact.nodeA, contact.nodeB, false});
+        }
+    }
+    // Ups first at the same instant, so back-to-back contacts do not flap
+    std::stable_sort(events.begin(), events.end(), [](const ContactEvent& a, const ContactEvent& b) {
+        return a.time < b.time || (a.time == b.time && a.up && !b.up);
+    });
+    m_events.swap(events);
+    m_nextEvent = 0;
+    NS_LOG_INFO("Replaying " << m_events.size() << " contact events over " << m_devices.size()
+                << " devices, " << skipped << " contacts not on this channel");
+
+    m_replayEvent.Cancel();
+    if (!m_events.empty()) {
+        m_replayEvent = Simulator::Schedule(m_events.front().time - now, &DtnContactChannel::ReplayEvents, this);
+    }
+}
+
+void DtnContactChannel::ReplayEvents(void) {
+    Time now = Simulator::Now();
+    while (m_nextEvent < m_events.size() && m_events[m_nextEvent].time <= now) {
+        const ContactEvent& event = m_events[m_nextEvent++];
+        SetContact(event.nodeA, event.nodeB, event.up);
+    }
+    if (m_nextEvent < m_events.size()) {
+        m_replayEvent = Simulator::Schedule(m_events[m_nextEvent].time - now, &DtnContactChannel::ReplayEvents,
+                                            this);
+    }
+}
+
+void DtnContactChannel::SetContact(uint32_t nodeA, uint32_t nodeB, bool up) {
+    auto a = m_endpoints.find(nodeA);
+    auto b = m_endpoints.find(nodeB);
+    if (a == m_endpoints.end() || b == m_endpoints.end()) {
+        return;
+    }
+    uint64_t key = MakeContactKey(nodeA, nodeB);
+    if (up) {
+        if (m_open[key]++ == 0) {
+            NS_LOG_DEBUG("Contact up: node " << nodeA << " <-> node " << nodeB);
+            a->second.peers.push_back(nodeB);
+            b->second.peers.push_back(nodeA);
+        }
+        return;
+    }
+    auto open = m_open.find(key);
+    if (open == m_open.end() || --open->second > 0) {
+        return;
+    }
+    m_open.erase(open);
+    NS_LOG_DEBUG("Contact down: node " << nodeA << " <-> node " << nodeB);
+    RemovePeer(a->second.peers, nodeB);
+    RemovePeer(b->second.peers, nodeA);
+}
+
+void DtnContactChannel::Send(Ptr<Packet> p, uint16_t protocol, Mac48Address to, Mac48Address from,
+                             Ptr<SimpleNetDevice> sender) {
+    auto source = m_endpoints.find(sender->GetNode()->GetId());
+    if (source == m_endpoints.end()) {
+        return;
+    }
+    for (uint32_t peer : source->second.peers) {
+        Ptr<SimpleNetDevice> device = m_endpoints[peer].device;
+        // Unicast frames only reach their addressee; the device filters the rest anyway
+        if (!to.IsGroup() && Mac48Address::ConvertFrom(device->GetAddress()) != to) {
+            continue;
+        }
+        ++m_framesCarried;
+        Simulator::ScheduleWithContext(peer, m_delay, &SimpleNetDevice::Receive, device, p->Copy(), protocol,
+                                       to, from);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,85 @@
+/*
+ * DTN Contact Channel
+ * Abstract link that replays a contact plan instead of simulating the Wi-Fi PHY
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#ifndef DTN_CONTACT_CHANNEL_H
+#define DTN_CONTACT_CHANNEL_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "dtn-contact-plan.h"
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+/*
+ * SimpleChannel that carries a frame only to the nodes in contact with
+ * the sender, Delay after it was sent. The devices' DataRate paces each
+ * node's transmissions, so a contact has a bandwidth but nothing of the
+ * radio is simulated: no propagation, interference, contention or
+ * retries. The DTN applications run unchanged on top and still discover
+ * each contact by its beacons and time it out once the plan takes it
+ * down, which is what makes routing parameter sweeps cheap.
+ *
+ * Contacts are replayed from a plan by one event at a time; contacts of
+ * one pair may overlap, the link staying up until the last of them ends.
+ */
+class DtnContactChannel : public SimpleChannel {
+public:
+    static TypeId GetTypeId(void);
+    DtnContactChannel();
+    virtual ~DtnContactChannel();
+
+    // Schedules the contacts of plan between nodes attached here, so
+    // attach the devices first; contacts of other nodes are skipped
+    void Replay(const DtnContactPlan& plan);
+    // Opens or closes (one of) the contact(s) between two attached nodes
+    void SetContact(uint32_t nodeA, uint32_t nodeB, bool up);
+    bool IsInContact(uint32_t nodeA, uint32_t nodeB) const {
+        return m_open.count(MakeContactKey(nodeA, nodeB)) > 0;
+    }
+
+    uint64_t GetFramesCarried(void) const { return m_framesCarried; }
+
+    virtual void Send(Ptr<Packet> p, uint16_t protocol, Mac48Address to, Mac48Address from,
+                      Ptr<SimpleNetDevice> sender);
+    virtual void Add(Ptr<SimpleNetDevice> device);
+    virtual std::size_t GetNDevices(void) const;
+    virtual Ptr<NetDevice> GetDevice(std::size_t i) const;
+
+protected:
+    virtual void DoDispose(void);
+
+private:
+    struct Endpoint {
+        Ptr<SimpleNetDevice> device;
+        std::vector<uint32_t> peers;  // Nodes in contact, by node id
+    };
+
+    struct ContactEvent {
+        Time time;
+        uint32_t nodeA;
+        uint32_t nodeB;
+        bool up;
+    };
+
+    void ReplayEvents(void);
+
+    Time m_delay;
+    std::vector<Ptr<SimpleNetDevice>> m_devices;  // In attach order
+    std::unordered_map<uint32_t, Endpoint> m_endpoints;  // By node id
+    std::unordered_map<uint64_t, uint32_t> m_open;  // Open contacts per pair, by MakeContactKey
+    std::vector<ContactEvent> m_events;  // Time order
+    std::size_t m_nextEvent;
+    EventId m_replayEvent;
+    uint64_t m_framesCarried;
+};
+
+} // namespace ns3
+
+#endif // DTN_CONTACT_CHANNEL_H
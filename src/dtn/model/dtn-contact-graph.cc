@@ -0,0 +1,201 @@
+/*
+ * DTN Contact Graph Routing
+ * Earliest-arrival routes over scheduled contacts, cached per destination
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "dtn-contact-graph.h"
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("DtnContactGraph");
+
+DtnContactGraph::DtnContactGraph(Time hopDelay)
+    : m_hopDelay(hopDelay),
+      m_live(0) {
+}
+
+uint32_t DtnContactGraph::AddContact(const DtnContact& contact) {
+    uint32_t id = m_contacts.size();
+    m_contacts.push_back({contact, false});
+    m_adjacency[contact.nodeA].push_back(id);
+    m_adjacency[contact.nodeB].push_back(id);
+    m_changes.push_back({id, true});
+    m_live++;
+    return id;
+}
+
+void DtnContactGraph::AddContacts(const DtnContactPlan& plan) {
+    for (const DtnContact& contact : plan.GetContacts()) {
+        if (contact.nodeA != contact.nodeB && contact.start < contact.end) {
+            AddContact(contact);
+        }
+    }
+}
+
+void DtnContactGraph::AddStaticContacts(NodeContainer nodes, double range) {
+    uint32_t added = 0;
+    for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+        Ptr<MobilityModel> a = nodes.Get(i)->GetObject<MobilityModel>();
+        for (uint32_t j = i + 1; a && j < nodes.GetN(); ++j) {
+            Ptr<MobilityModel> b = nodes.Get(j)->GetObject<MobilityModel>();
+            if (b && a->GetDistanceFrom(b) <= range) {
+                AddContact(DtnContact(Seconds(0.0), Time::Max(), nodes.Get(i)->GetId(), nodes.Get(j)->GetId()));
+                added++;
+            }
+        }
+    }
+    NS_LOG_INFO("Added " << added << " permanent contacts among " << nodes.GetN() << " static nodes");
+}
+
+void DtnContactGraph::RemoveContact(uint32_t contact) {
+    if (contact >= m_contacts.size() || m_contacts[contact].removed) {
+        return;
+    }
+    m_contacts[contact].removed = true;
+    m_changes.push_back({contact, false});
+    m_live--;
+}
+
+void DtnContactGraph::RemoveNode(uint32_t node) {
+    auto it = m_adjacency.find(node);
+    if (it == m_adjacency.end()) {
+        return;
+    }
+    for (uint32_t contact : it->second) {
+        RemoveContact(contact);
+    }
+}
+
+DtnContactRoute DtnContactGraph::FindRoute(uint32_t source, uint32_t destination, Time now) const {
+    DtnContactRoute route;
+    route.version = GetVersion();
+    if (source == destination || !HasNode(source) || !HasNode(destination)) {
+        return route;
+    }
+
+    // Earliest arrival per node and the contact it came in on
+    struct Label {
+        Label()
+            : arrival(Time::Max()),
+              via(DtnContactRoute::NO_ROUTE),
+              done(false) {
+        }
+
+        Time arrival;
+        uint32_t via;
+        bool done;
+    };
+    typedef std::pair<Time, uint32_t> QueueEntry;
+    std::unordered_map<uint32_t, Label> labels;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    labels[source].arrival = now;
+    queue.push(QueueEntry(now, source));
+
+    while (!queue.empty()) {
+        QueueEntry top = queue.top();
+        queue.pop();
+        Label& label = labels[top.second];
+        if (label.done) {
+            continue;
+        }
+        label.done = true;
+        if (top.second == destination) {
+            break;
+        }
+        auto adjacent = m_adjacency.find(top.second);
+        for (uint32_t id : adjacent->second) {
+            const Entry& entry = m_contacts[id];
+            if (entry.removed || entry.contact.end <= top.first) {
+                continue;
+            }
+            // Wait for the contact if it has not started yet
+            Time arrival = std::max(entry.contact.start, top.first) + m_hopDelay;
+            uint32_t next = entry.contact.nodeA == top.second ? entry.contact.nodeB : entry.contact.nodeA;
+            Label& nextLabel = labels[next];
+            if (!nextLabel.done && arrival < nextLabel.arrival) {
+                nextLabel.arrival = arrival;
+                nextLabel.via = id;
+                queue.push(QueueEntry(arrival, next));
+            }
+        }
+    }
+
+    auto reached = labels.find(destination);
+    if (reached == labels.end() || !reached->second.done) {
+        return route;
+    }
+    route.arrival = reached->second.arrival;
+    uint32_t node = destination;
+    while (node != source) {
+        uint32_t id = labels[node].via;
+        const DtnContact& contact = m_contacts[id].contact;
+        route.contacts.push_back(id);
+        route.validUntil = std::min(route.validUntil, contact.end);
+        route.nextHop = node;
+        node = contact.nodeA == node ? contact.nodeB : contact.nodeA;
+    }
+    std::reverse(route.contacts.begin(), route.contacts.end());
+    return route;
+}
+
+bool DtnContactGraph::IsCurrent(const DtnContactRoute& route, Time now) const {
+    if (route.Exists() && now >= route.validUntil) {
+        return false;
+    }
+    for (uint64_t v = route.version; v < m_changes.size(); ++v) {
+        const Change& change = m_changes[v];
+        if (change.added) {
+            // Only a contact starting before we would arrive can get there earlier
+            if (m_contacts[change.contact].contact.start < route.arrival) {
+                return false;
+            }
+        } else if (std::find(route.contacts.begin(), route.contacts.end(), change.contact) != route.contacts.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ContactGraphStrategy::ContactGraphStrategy(Ptr<DtnContactGraph> graph, Ptr<RoutingStrategy> fallback)
+    : m_graph(graph),
+      m_fallback(fallback),
+      m_computations(0) {
+}
+
+void ContactGraphStrategy::SetNodeId(uint32_t nodeId) {
+    RoutingStrategy::SetNodeId(nodeId);
+    m_fallback->SetNodeId(nodeId);
+    m_routes.clear();
+}
+
+const DtnContactRoute& ContactGraphStrategy::GetRoute(uint32_t destination) {
+    Time now = Simulator::Now();
+    auto it = m_routes.find(destination);
+    if (it == m_routes.end()) {
+        it = m_routes.emplace(destination, m_graph->FindRoute(GetNodeId(), destination, now)).first;
+        m_computations++;
+    } else if (!m_graph->IsCurrent(it->second, now)) {
+        it->second = m_graph->FindRoute(GetNodeId(), destination, now);
+        m_computations++;
+    } else {
+        // The changes since did not touch it; skip them next time
+        it->second.version = m_graph->GetVersion();
+    }
+    return it->second;
+}
+
+bool ContactGraphStrategy::DoShouldForward(uint32_t destination, uint32_t copies, uint32_t peer) {
+    const DtnContactRoute& route = GetRoute(destination);
+    if (route.Exists()) {
+        return route.nextHop == peer;
+    }
+    return m_fallback->ShouldForward(destination, copies, peer);
+}
+
+} // namespace ns3
@@ -0,0 +1,136 @@
+/*
+ * DTN Contact Graph Routing
+ * Earliest-arrival routes over scheduled contacts, cached per destination
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#ifndef DTN_CONTACT_GRAPH_H
+#define DTN_CONTACT_GRAPH_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "dtn-contact-plan.h"
+#include "dtn-routing-strategy.h"
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+// Earliest-arrival route from one node, as of the graph version it was computed at
+struct DtnContactRoute {
+    static const uint32_t NO_ROUTE = 0xFFFFFFFF;
+
+    DtnContactRoute()
+        : nextHop(NO_ROUTE),
+          arrival(Time::Max()),
+          validUntil(Time::Max()),
+          version(0) {
+    }
+
+    bool Exists(void) const { return nextHop != NO_ROUTE; }
+
+    uint32_t nextHop;
+    Time arrival;     // At the destination, if the first departure is at once
+    Time validUntil;  // First end of a contact on the path
+    uint64_t version;
+    std::vector<uint32_t> contacts;  // Contact ids, first hop first
+};
+
+/*
+ * Scheduled contacts of the nodes whose movement is known in advance:
+ * static infrastructure in range of each other (permanent contacts),
+ * patrols, or a recorded DtnContactPlan. FindRoute() is Contact Graph
+ * Routing's earliest-arrival search: a Dijkstra over nodes where a
+ * contact can be taken from the later of its start and the arrival at its
+ * sender until it ends, and costs HopDelay. Contacts are symmetric.
+ *
+ * One graph is shared by every node of the run. It can change while the
+ * simulation runs (a node lost to the disaster, a new schedule); each
+ * change is logged so IsCurrent() can tell a cached route apart from one
+ * the change may have beaten or broken.
+ */
+class DtnContactGraph : public SimpleRefCount<DtnContactGraph> {
+public:
+    explicit DtnContactGraph(Time hopDelay = MilliSeconds(2));
+
+    // Returns the contact id
+    uint32_t AddContact(const DtnContact& contact);
+    void AddContacts(const DtnContactPlan& plan);
+    // Permanent contacts between every two nodes within range of each other
+    // at their current (mobility model) positions
+    void AddStaticContacts(NodeContainer nodes, double range);
+    void RemoveContact(uint32_t contact);
+    // Removes every contact of node
+    void RemoveNode(uint32_t node);
+
+    const DtnContact& GetContact(uint32_t contact) const { return m_contacts[contact].contact; }
+    uint32_t GetSize(void) const { return m_live; }
+    bool HasNode(uint32_t node) const { return m_adjacency.count(node) > 0; }
+    uint64_t GetVersion(void) const { return m_changes.size(); }
+
+    DtnContactRoute FindRoute(uint32_t source, uint32_t destination, Time now) const;
+    // No change since route was computed can have made it unusable or beaten it
+    bool IsCurrent(const DtnContactRoute& route, Time now) const;
+
+private:
+    struct Entry {
+        DtnContact contact;
+        bool removed;
+    };
+
+    struct Change {
+        uint32_t contact;
+        bool added;
+    };
+
+    Time m_hopDelay;
+    std::vector<Entry> m_contacts;  // By contact id
+    std::unordered_map<uint32_t, std::vector<uint32_t>> m_adjacency;  // Contact ids by node
+    std::vector<Change> m_changes;  // Version v is the state after the first v changes
+    uint32_t m_live;
+};
+
+/*
+ * Contact Graph Routing where the graph knows a route from this node to
+ * the destination: the bundle goes only to the route's next hop (and to
+ * the destination itself), one unicast path instead of a flood. Where it
+ * does not, for instance towards a civilian whose movement is random, the
+ * fallback strategy decides, and it also keeps the copy budget and the
+ * predictabilities. Routes are cached per destination and recomputed only
+ * once a contact on them has ended or the graph changed under them.
+ */
+class ContactGraphStrategy : public RoutingStrategy {
+public:
+    ContactGraphStrategy(Ptr<DtnContactGraph> graph, Ptr<RoutingStrategy> fallback);
+
+    virtual void SetNodeId(uint32_t nodeId);
+    virtual std::string GetName(void) const { return "CGR+" + m_fallback->GetName(); }
+    virtual uint32_t GetInitialCopies(void) const { return m_fallback->GetInitialCopies(); }
+    virtual void NotifyContact(uint32_t peer, const std::map<uint32_t, double>& peerPredictability) {
+        m_fallback->NotifyContact(peer, peerPredictability);
+    }
+    virtual std::map<uint32_t, double> GetPredictabilities(void) { return m_fallback->GetPredictabilities(); }
+    virtual uint32_t OnForward(uint32_t& copies) { return m_fallback->OnForward(copies); }
+    // Routes are recomputed from the graph; only the fallback learns
+    virtual void WriteState(std::ostream& os) const { m_fallback->WriteState(os); }
+    virtual bool ReadState(std::istream& is) { return m_fallback->ReadState(is); }
+
+    const DtnContactRoute& GetRoute(uint32_t destination);
+    uint64_t GetRouteComputations(void) const { return m_computations; }
+
+protected:
+    virtual bool DoShouldForward(uint32_t destination, uint32_t copies, uint32_t peer);
+
+private:
+    Ptr<DtnContactGraph> m_graph;
+    Ptr<RoutingStrategy> m_fallback;
+    std::unordered_map<uint32_t, DtnContactRoute> m_routes;  // By destination
+    uint64_t m_computations;
+};
+
+} // namespace ns3
+
+#endif // DTN_CONTACT_GRAPH_H
@@ -0,0 +1,189 @@
+/*
+ * DTN Contact Plan
+ * Contact intervals recorded from a full-fidelity run or imported from mobility traces
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "dtn-contact-plan.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("DtnContactPlan");
+
+namespace {
+
+bool ParseSeconds(const std::string& field, Time& time) {
+    char* end = 0;
+    double seconds = std::strtod(field.c_str(), &end);
+    if (end == field.c_str() || *end != '\0' || seconds < 0.0) {
+        return false;
+    }
+    time = Seconds(seconds);
+    return true;
+}
+
+bool ParseNode(const std::string& field, uint32_t& node) {
+    char* end = 0;
+    unsigned long value = std::strtoul(field.c_str(), &end, 10);
+    if (end == field.c_str() || *end != '\0') {
+        return false;
+    }
+    node = static_cast<uint32_t>(value);
+    return true;
+}
+
+} // namespace
+
+void DtnContactPlan::Record(ApplicationContainer apps) {
+    for (ApplicationContainer::Iterator i = apps.Begin(); i != apps.End(); ++i) {
+        (*i)->TraceConnectWithoutContext("ContactUp", MakeCallback(&DtnContactPlan::ContactUp, this));
+        (*i)->TraceConnectWithoutContext("ContactDown", MakeCallback(&DtnContactPlan::ContactDown, this));
+    }
+}
+
+void DtnContactPlan::ContactUp(uint32_t node, uint32_t peer) {
+    OpenContact& open = m_open[MakeContactKey(node, peer)];
+    uint8_t side = node < peer ? 0x01 : 0x02;
+    if (open.sides != 0x03 && (open.sides | side) == 0x03) {
+        open.start = Simulator::Now();
+    }
+    open.sides |= side;
+}
+
+void DtnContactPlan::ContactDown(uint32_t node, uint32_t peer) {
+    auto it = m_open.find(MakeContactKey(node, peer));
+    if (it == m_open.end()) {
+        return;
+    }
+    // The first side to time out ends the contact; a stopped node never does
+    if (it->second.sides == 0x03) {
+        Add(DtnContact(it->second.start, Simulator::Now(), std::min(node, peer), std::max(node, peer)));
+    }
+    it->second.sides &= node < peer ? 0x02 : 0x01;
+    if (it->second.sides == 0) {
+        m_open.erase(it);
+    }
+}
+
+bool DtnContactPlan::Write(std::string path) const {
+    struct Event {
+        Time time;
+        uint32_t nodeA;
+        uint32_t nodeB;
+        bool up;
+    };
+
+    Time now = Simulator::Now();
+    std::vector<Event> events;
+    events.reserve(2 * (m_contacts.size() + m_open.size()));
+    for (const DtnContact& contact : m_contacts) {
+        events.push_back({contact.start, contact.nodeA, contact.nodeB, true});
+        if (contact.end != Time::Max()) {
+            events.push_back({contact.end, contact.nodeA, contact.nodeB, false});
+        }
+    }
+    for (const auto& entry : m_open) {
+        if (entry.second.sides == 0x03) {
+            uint32_t nodeA = static_cast<uint32_t>(entry.first >> 32);
+            uint32_t nodeB = static_cast<uint32_t>(entry.first);
+            events.push_back({entry.second.start, nodeA, nodeB, true});
+            events.push_back({now, nodeA, nodeB, false});
+        }
+    }
+    // A pair going down and up at the same instant must reopen, not close
+    std::stable_sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+        return a.time < b.time || (a.time == b.time && !a.up && b.up);
+    });
+
+    std::ofstream file(path.c_str());
+    if (!file.is_open()) {
+        return false;
+    }
+    file << "# DTN contact plan: <time s> CONN <nodeA> <nodeB> up|down\n";
+    file << std::fixed << std::setprecision(6);
+    for (const Event& event : events) {
+        file << event.time.GetSeconds() << " CONN " << event.nodeA << " " << event.nodeB
+             << (event.up ? " up\n" : " down\n");
+    }
+    NS_LOG_INFO("Wrote " << events.size() << " contact events to " << path);
+    return true;
+}
+
+bool DtnContactPlan::Load(std::string path) {
+    std::ifstream file(path.c_str());
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // ONE "up" events waiting for their "down"
+    std::unordered_map<uint64_t, DtnContact> open;
+    std::string line;
+    uint32_t lineNumber = 0;
+    uint32_t skipped = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        std::string::size_type comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::istringstream stream(line);
+        std::vector<std::string> fields;
+        std::string field;
+        while (stream >> field) {
+            fields.push_back(field);
+        }
+        if (fields.empty()) {
+            continue;
+        }
+
+        DtnContact contact;
+        if (fields.size() >= 5 && fields[1] == "CONN") {
+            Time time;
+            if (!ParseSeconds(fields[0], time) || !ParseNode(fields[2], contact.nodeA)
+                || !ParseNode(fields[3], contact.nodeB) || (fields[4] != "up" && fields[4] != "down")) {
+                NS_LOG_WARN(path << ":" << lineNumber << ": unreadable connection event");
+                ++skipped;
+                continue;
+            }
+            uint64_t key = MakeContactKey(contact.nodeA, contact.nodeB);
+            if (fields[4] == "up") {
+                contact.start = time;
+                open.emplace(key, contact);
+            } else {
+                auto it = open.find(key);
+                if (it != open.end()) {
+                    it->second.end = time;
+                    Add(it->second);
+                    open.erase(it);
+                }
+            }
+        } else if (fields.size() >= 4 && ParseNode(fields[0], contact.nodeA)
+                   && ParseNode(fields[1], contact.nodeB) && ParseSeconds(fields[2], contact.start)
+                   && ParseSeconds(fields[3], contact.end)) {
+            if (contact.start < contact.end) {
+                Add(contact);
+            }
+        } else {
+            NS_LOG_WARN(path << ":" << lineNumber << ": not a contact");
+            ++skipped;
+        }
+    }
+
+    // Never went down: up until the end of the run
+    for (auto& entry : open) {
+        entry.second.end = Time::Max();
+        Add(entry.second);
+    }
+    NS_LOG_INFO("Loaded " << m_contacts.size() << " contacts from " << path << ", skipped "
+                << skipped << " lines");
+    return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,97 @@
+/*
+ * DTN Contact Plan
+ * Contact intervals recorded from a full-fidelity run or imported from mobility traces
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#ifndef DTN_CONTACT_PLAN_H
+#define DTN_CONTACT_PLAN_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "dtn-application.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+// Two nodes able to exchange frames during [start, end)
+struct DtnContact {
+    DtnContact()
+        : nodeA(0),
+          nodeB(0) {
+    }
+    DtnContact(Time start, Time end, uint32_t nodeA, uint32_t nodeB)
+        : start(start),
+          end(end),
+          nodeA(nodeA),
+          nodeB(nodeB) {
+    }
+
+    Time start;
+    Time end;  // Time::Max() if the contact never went down
+    uint32_t nodeA;
+    uint32_t nodeB;
+};
+
+// Order-independent key of a node pair
+inline uint64_t MakeContactKey(uint32_t nodeA, uint32_t nodeB) {
+    return nodeA < nodeB ? (static_cast<uint64_t>(nodeA) << 32) | nodeB
+                         : (static_cast<uint64_t>(nodeB) << 32) | nodeA;
+}
+
+/*
+ * Who could reach whom, and when. Recorded from the ContactUp/ContactDown
+ * traces of the DTN applications of a full-fidelity run, a pair counting
+ * as in contact while each side has the other in its neighbour table, or
+ * loaded from a mobility trace. Files are written in the ONE simulator's
+ * connection event format,
+ *
+ *   <time s> CONN <nodeA> <nodeB> up|down
+ *
+ * and Load() also takes CRAWDAD-style interval lines,
+ *
+ *   <nodeA> <nodeB> <start s> <end s> [ignored columns]
+ *
+ * Node ids are DTN node ids; '#' starts a comment. A DtnContactChannel
+ * replays the plan in place of the Wi-Fi channel.
+ */
+class DtnContactPlan {
+public:
+    DtnContactPlan() {}
+
+    // Records the contacts of apps from now on; the plan must outlive the run
+    void Record(ApplicationContainer apps);
+    // Contacts still open are written as going down now; false if path cannot be written
+    bool Write(std::string path) const;
+    // Adds the contacts of a file; false if it cannot be read
+    bool Load(std::string path);
+
+    void Add(const DtnContact& contact) { m_contacts.push_back(contact); }
+    const std::vector<DtnContact>& GetContacts(void) const { return m_contacts; }
+    uint32_t GetSize(void) const { return m_contacts.size(); }
+
+private:
+    void ContactUp(uint32_t node, uint32_t peer);
+    void ContactDown(uint32_t node, uint32_t peer);
+
+    // A pair one side (mask bit 0: lower id, bit 1: higher id) has in contact
+    struct OpenContact {
+        OpenContact()
+            : sides(0) {
+        }
+
+        uint8_t sides;
+        Time start;  // Both sides were up from here
+    };
+
+    std::vector<DtnContact> m_contacts;
+    std::unordered_map<uint64_t, OpenContact> m_open;  // By MakeContactKey
+};
+
+} // namespace ns3
+
+#endif // DTN_CONTACT_PLAN_H
@@ -0,0 +1,348 @@
+/*
+ * Enhanced DTN Application
+ * DtnApplication with ML-driven forwarding, beacon-borne node context and delivery-report feedback
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "dtn-enhanced-application.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("EnhancedDTNApplication");
+
+NS_OBJECT_ENSURE_REGISTERED(EnhancedDTNApplication);
+
+TypeId EnhancedDTNApplication::GetTypeId(void) {
+    static TypeId tid = TypeId("ns3::EnhancedDTNApplication")
+        .SetParent<DtnApplication>()
+        .SetGroupName("Dtn")
+        .AddConstructor<EnhancedDTNApplication>()
+        .AddAttribute("ModelAveraging",
+                      "Average ML models with neighbours on contact (ML routing only)",
+                      BooleanValue(true),
+                      MakeBooleanAccessor(&EnhancedDTNApplication::m_modelAveraging),
+                      MakeBooleanChecker());
+    return tid;
+}
+
+EnhancedDTNApplication::EnhancedDTNApplication()
+    : m_beaconsSinceFullContext(0),
+      m_fullContextDue(true),
+      m_modelAveraging(true),
+      m_intelligentForwards(0),
+      m_transmitEnergy(0.0) {
+
+    // ML-driven IntelligentRouting unless a strategy is set
+    SetRoutingStrategy(0);
+
+    // Initialize node context with default values
+    m_nodeContext.nodeId = 0;
+    m_nodeContext.nodeType = CIVILIAN_DEVICE;
+    m_nodeContext.batteryLevel = 1.0;
+    m_nodeContext.bufferOccupancy = 0;
+    m_nodeContext.socialWeight = 0.5;
+    m_nodeContext.trustScore = 0.8;
+    m_nodeContext.messagesSent = 0;
+    m_nodeContext.messagesReceived = 0;
+    m_nodeContext.averageDelay = 0.0;
+}
+
+EnhancedDTNApplication::~EnhancedDTNApplication() {}
+
+void EnhancedDTNApplication::StartApplication(void) {
+    m_mlEngine.InitializeWeights(m_rng);
+    DtnApplication::StartApplication();
+    UpdateNodeContext();
+}
+
+void EnhancedDTNApplication::DoSaveState(DtnApplicationState& state) const {
+    state.model = m_mlEngine.GetWeights();
+    state.modelSamples = m_mlEngine.GetTrainedSamples();
+}
+
+void EnhancedDTNApplication::DoRestoreState(const DtnApplicationState& state) {
+    if (!state.model.empty() && !m_mlEngine.SetWeights(state.model, state.modelSamples)) {
+        NS_LOG_WARN("Node " << m_nodeId << ": saved model has " << state.model.size()
+                    << " weights, keeping the initial ones");
+    }
+}
+
+void EnhancedDTNApplication::StopApplication(void) {
+    DtnApplication::StopApplication();
+
+    // Log enhanced statistics
+    double avgDelay = 0.0;
+    if (!m_deliveryDelays.empty()) {
+        avgDelay = std::accumulate(m_deliveryDelays.begin(), m_deliveryDelays.end(), 0.0) / m_deliveryDelays.size();
+    }
+
+    NS_LOG_INFO("Enhanced Node " << m_nodeId << " Final Stats:");
+    NS_LOG_INFO("  Intelligent Forwards: " << m_intelligentForwards);
+    NS_LOG_INFO("  Successful Deliveries: " << m_stats.bundlesDelivered);
+    NS_LOG_INFO("  Average Delay: " << avgDelay << " seconds");
+    NS_LOG_INFO("  Energy Consumed: " << GetEnergyConsumed() << " J (forwards estimated at "
+                << m_transmitEnergy << " J), battery " << GetBatteryLevel() * 100.0 << "%");
+    if (!m_routingStrategy) {
+        NS_LOG_INFO("  ML Decisions Resolved: " << m_mlEngine.GetResolvedDecisions()
+                    << " (Brier score " << m_mlEngine.GetBrierScore() << ")");
+    }
+}
+
+void EnhancedDTNApplication::InitializeBundle(DtnBundle& bundle) {
+    bundle.urgencyScore = m_mlEngine.CalculateUrgencyScore(bundle);
+}
+
+void EnhancedDTNApplication::NotifyBundleDelivered(const DtnBundle& bundle) {
+    double delay = (Simulator::Now() - bundle.creationTime).GetSeconds();
+    m_deliveryDelays.push_back(delay);
+
+    m_mlEngine.UpdateLearningModel(MakeBundleKey(bundle.sourceNode, bundle.bundleId), true);
+}
+
+void EnhancedDTNApplication::NotifyContactUp(uint32_t peer) {
+    m_nodeContext.encounterHistory[peer] += 1.0;
+    m_nodeContext.lastContactTime[peer] = Simulator::Now();
+
+    // The new neighbour has no baseline for our deltas yet
+    m_fullContextDue = true;
+}
+
+void EnhancedDTNApplication::NotifyContactDown(uint32_t peer) {
+    m_neighborContexts.erase(peer);
+}
+
+void EnhancedDTNApplication::NotifyExpiry(Time now) {
+    m_mlEngine.ExpireDecisions(now);
+    m_nodeContext.bufferOccupancy = m_bundleStore.GetSize();
+}
+
+void EnhancedDTNApplication::PrepareBeacon(DtnBeaconHeader& beacon) {
+    UpdateNodeContext();
+    beacon.SetContext(BuildContextDelta());
+}
+
+void EnhancedDTNApplication::ReceiveBeacon(const DtnBeaconHeader& beacon) {
+    ApplyContextDelta(beacon.GetSenderNode(), beacon.GetContext());
+}
+
+void EnhancedDTNApplication::PrepareSummaryVector(DtnSummaryVectorHeader& vector) {
+    DtnApplication::PrepareSummaryVector(vector);
+    if (!m_routingStrategy && m_modelAveraging && m_mlEngine.GetTrainedSamples() > 0) {
+        vector.SetModel(m_mlEngine.GetWeights(), m_mlEngine.GetTrainedSamples());
+    }
+}
+
+void EnhancedDTNApplication::ReceiveSummaryVector(DtnNeighbor& neighbor, const DtnSummaryVectorHeader& vector) {
+    if (!m_routingStrategy) {
+        if (m_modelAveraging && vector.HasModel()) {
+            m_mlEngine.AverageWith(vector.GetModelWeights(), vector.GetModelSamples());
+        }
+        BufferChanged();  // ML routing re-evaluates the whole neighbourhood
+        return;
+    }
+
+    DtnApplication::ReceiveSummaryVector(neighbor, vector);
+}
+
+void EnhancedDTNApplication::NotifyDeliveryReport(uint64_t key) {
+    // Positive feedback for our pending decisions on this bundle
+    m_mlEngine.UpdateLearningModel(key, true);
+}
+
+void EnhancedDTNApplication::DoRoutingPass(void) {
+    UpdateNodeContext();
+    if (!m_routingStrategy) {
+        IntelligentRouting();
+        return;
+    }
+    DtnApplication::DoRoutingPass();
+}
+
+DtnContextDelta EnhancedDTNApplication::BuildContextDelta(void) {
+    DtnContextDelta delta;
+    delta.batteryLevel = m_nodeContext.batteryLevel;
+    delta.bufferOccupancy = m_nodeContext.bufferOccupancy;
+    delta.socialWeight = m_nodeContext.socialWeight;
+    delta.trustScore = m_nodeContext.trustScore;
+    delta.position = m_nodeContext.position;
+    delta.nodeType = static_cast<uint8_t>(m_nodeContext.nodeType);
+
+    // Full context for new contacts and every 10th beacon (covers lost
+    // beacons); otherwise only the fields that moved past their tolerance
+    if (m_fullContextDue || ++m_beaconsSinceFullContext >= 10) {
+        delta.mask = DtnContextDelta::ALL;
+        m_fullContextDue = false;
+        m_beaconsSinceFullContext = 0;
+    } else {
+        const DtnContextDelta& last = m_advertisedContext;
+        if (std::abs(delta.batteryLevel - last.batteryLevel) >= 0.01) {
+            delta.mask |= DtnContextDelta::BATTERY;
+        }
+        if (std::abs(static_cast<int32_t>(delta.bufferOccupancy) - static_cast<int32_t>(last.bufferOccupancy)) >= 5) {
+            delta.mask |= DtnContextDelta::BUFFER;
+        }
+        if (std::abs(delta.socialWeight - last.socialWeight) >= 0.01) {
+            delta.mask |= DtnContextDelta::SOCIAL_WEIGHT;
+        }
+        if (std::abs(delta.trustScore - last.trustScore) >= 0.01) {
+            delta.mask |= DtnContextDelta::TRUST;
+        }
+        if (CalculateDistance(delta.position, last.position) >= 25.0) {
+            delta.mask |= DtnContextDelta::POSITION;
+        }
+    }
+
+    // Remember what is now on the air, field by field
+    if (delta.Has(DtnContextDelta::BATTERY)) m_advertisedContext.batteryLevel = delta.batteryLevel;
+    if (delta.Has(DtnContextDelta::BUFFER)) m_advertisedContext.bufferOccupancy = delta.bufferOccupancy;
+    if (delta.Has(DtnContextDelta::SOCIAL_WEIGHT)) m_advertisedContext.socialWeight = delta.socialWeight;
+    if (delta.Has(DtnContextDelta::TRUST)) m_advertisedContext.trustScore = delta.trustScore;
+    if (delta.Has(DtnContextDelta::POSITION)) m_advertisedContext.position = delta.position;
+    return delta;
+}
+
+void EnhancedDTNApplication::ApplyContextDelta(uint32_t peer, const DtnContextDelta& delta) {
+    auto it = m_neighborContexts.find(peer);
+    if (it == m_neighborContexts.end()) {
+        // Deltas are meaningless without a baseline; wait for a full context
+        if (delta.mask != DtnContextDelta::ALL) {
+            return;
+        }
+        NodeContext context;
+        context.nodeId = peer;
+        context.messagesSent = 0;
+        context.messagesReceived = 0;
+        context.averageDelay = 0.0;
+        it = m_neighborContexts.insert(std::make_pair(peer, context)).first;
+    }
+
+    NodeContext& context = it->second;
+    if (delta.Has(DtnContextDelta::BATTERY)) context.batteryLevel = delta.batteryLevel;
+    if (delta.Has(DtnContextDelta::BUFFER)) context.bufferOccupancy = delta.bufferOccupancy;
+    if (delta.Has(DtnContextDelta::SOCIAL_WEIGHT)) context.socialWeight = delta.socialWeight;
+    if (delta.Has(DtnContextDelta::TRUST)) context.trustScore = delta.trustScore;
+    if (delta.Has(DtnContextDelta::POSITION)) context.position = delta.position;
+    if (delta.Has(DtnContextDelta::NODE_TYPE)) context.nodeType = static_cast<NodeType>(delta.nodeType);
+
+    // A first or refreshed context can change the ML decisions
+    if (!m_routingStrategy && delta.mask == DtnContextDelta::ALL) {
+        BufferChanged();
+    }
+}
+
+void EnhancedDTNApplication::UpdateNodeContext(void) {
+    m_nodeContext.nodeId = m_nodeId;
+    m_nodeContext.nodeType = static_cast<NodeType>(m_nodeType);
+    m_nodeContext.bufferOccupancy = m_bundleStore.GetSize();
+    m_nodeContext.messagesSent = m_stats.bundlesCreated;
+    m_nodeContext.messagesReceived = m_stats.bundlesReceived;
+
+    // Update mobility information
+    Ptr<MobilityModel> mobility = GetNode()->GetObject<MobilityModel>();
+    if (mobility) {
+        m_nodeContext.position = mobility->GetPosition();
+        m_nodeContext.velocity = mobility->GetVelocity();
+    }
+
+    // Energy source of the node (1 while energy is not modelled)
+    m_nodeContext.batteryLevel = GetBatteryLevel();
+
+    // Update social weight based on encounters
+    double totalEncounters = 0;
+    for (const auto& encounter : m_nodeContext.encounterHistory) {
+        totalEncounters += encounter.second;
+    }
+    m_nodeContext.socialWeight = std::min(1.0, totalEncounters / 100.0);
+
+    // Update trust score based on successful message deliveries
+    if (m_nodeContext.messagesSent > 0) {
+        m_nodeContext.trustScore = (double)m_stats.bundlesDelivered / m_nodeContext.messagesSent;
+    }
+}
+
+double EnhancedDTNApplication::GetRetentionScore(const DtnBundle& bundle, Time now) {
+    // Same urgency the ML pass forwards by, scaled by the TTL left
+    double remaining = bundle.ttl.IsStrictlyPositive()
+        ? (bundle.creationTime + bundle.ttl - now).GetSeconds() / bundle.ttl.GetSeconds() : 0.0;
+    return remaining * m_mlEngine.CalculateUrgencyScore(bundle, now);
+}
+
+void EnhancedDTNApplication::IntelligentRouting(void) {
+    NS_LOG_FUNCTION(this);
+
+    // Neighbours in contact whose context we know, one feature row each
+    m_neighborBatch.Clear();
+    m_batchContacts.clear();
+    for (const auto& neighbor : m_neighborContexts) {
+        DtnNeighbor* contact = m_neighbors.Find(neighbor.first);
+        if (contact) {
+            m_mlEngine.AppendNeighbor(m_neighborBatch, neighbor.second);
+            m_batchContacts.push_back(contact);
+        }
+    }
+    if (m_batchContacts.empty()) {
+        return;
+    }
+
+    // Live bundles, one feature row each
+    Time now = Simulator::Now();
+    m_bundleBatch.Clear();
+    m_batchBundles.clear();
+    m_bundleStore.ForEach([&](DtnBundle& bundle) {
+        if (IsLive(bundle, now) && !AwaitingCustody(bundle, now)) {
+            bundle.urgencyScore = m_mlEngine.CalculateUrgencyScore(bundle, now);
+            m_mlEngine.AppendBundle(m_bundleBatch, bundle, now);
+            m_batchBundles.push_back(&bundle);
+        }
+        return true;
+    });
+
+    // Score the whole buffer against the whole neighbourhood in one call
+    m_mlEngine.ScoreBatch(m_bundleBatch, m_neighborBatch, m_batchLogits);
+
+    uint32_t nNeighbors = m_batchContacts.size();
+    // Queued sends are not drawn from the energy source yet
+    double passEnergy = 0.0;
+    for (uint32_t b = 0; b < m_batchBundles.size(); ++b) {
+        DtnBundle& bundle = *m_batchBundles[b];
+        uint64_t key = MakeBundleKey(bundle.sourceNode, bundle.bundleId);
+        double thresholdLogit = m_mlEngine.GetForwardThresholdLogit(bundle.urgencyScore);
+        const double* logits = m_batchLogits.data() + static_cast<size_t>(b) * nNeighbors;
+
+        for (uint32_t n = 0; n < nNeighbors; ++n) {
+            DtnNeighbor* contact = m_batchContacts[n];
+            if (contact->Has(key)) {
+                continue;
+            }
+            bool forDestination = bundle.destinationNode == contact->nodeId;
+            if ((forDestination || logits[n] > thresholdLogit) &&
+                CanAffordForward(bundle, contact->nodeId, passEnergy)) {
+                // Forward bundle intelligently
+                ForwardBundle(bundle, bundle.copies, *contact);
+
+                // Model-driven forwards are kept for delivery/expiry feedback
+                if (!forDestination) {
+                    m_mlEngine.RecordDecision(key, m_mlEngine.GetPairFeatures(m_bundleBatch, b, m_neighborBatch, n),
+                                              m_mlEngine.LogitToProbability(logits[n]), bundle.creationTime + bundle.ttl);
+                }
+                double energyCost = GetTransmitEnergy(bundle);
+                bundle.energyCost += energyCost;
+                m_transmitEnergy += energyCost;
+                passEnergy += energyCost;
+                m_intelligentForwards++;
+
+                NS_LOG_INFO("Intelligent forward of bundle " << bundle.bundleId
+                            << " to neighbor " << contact->nodeId
+                            << " (urgency: " << bundle.urgencyScore << ")");
+                break; // Forward to one neighbor per cycle
+            }
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,154 @@
+/*
+ * DTN ML Routing Engine
+ * Online logistic delivery model scoring (bundle, neighbour) pairs for EnhancedDTNApplication
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#ifndef DTN_ML_ROUTING_ENGINE_H
+#define DTN_ML_ROUTING_ENGINE_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "dtn-bundle.h"
+#include <array>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+// Node Context Information for AI/ML
+struct NodeContext {
+    uint32_t nodeId;
+    NodeType nodeType;
+    Vector position;
+    Vector velocity;
+    double batteryLevel;
+    uint32_t bufferOccupancy;
+    double socialWeight;
+    std::map<uint32_t, double> encounterHistory;
+    std::map<uint32_t, Time> lastContactTime;
+    double trustScore;
+    uint32_t messagesSent;
+    uint32_t messagesReceived;
+    double averageDelay;
+};
+
+// AI/ML Routing Decision Engine
+//
+// The model is a single logistic unit over 8 normalised features. The first
+// five describe the neighbour, the last three the bundle, so a pair's logit
+// is neighbourPart + bundlePart and a whole buffer can be scored against a
+// whole neighbourhood with O(bundles + neighbours) feature work.
+static const uint32_t ML_FEATURE_COUNT = 8;
+static const uint32_t ML_NEIGHBOR_FEATURES = 5;  // distance, battery, buffer, social, trust
+typedef std::array<double, ML_FEATURE_COUNT> MLFeatureVector;
+
+// Structure-of-arrays feature matrix: one contiguous column per feature.
+// Clear() keeps capacity, so a reused batch stops allocating once warm.
+template <uint32_t Columns>
+class MLFeatureColumns {
+public:
+    void Clear() {
+        for (auto& column : m_columns) {
+            column.clear();
+        }
+    }
+    uint32_t GetRows() const { return m_columns[0].size(); }
+    void AppendRow(const std::array<double, Columns>& row) {
+        for (uint32_t c = 0; c < Columns; ++c) {
+            m_columns[c].push_back(row[c]);
+        }
+    }
+    const double* Column(uint32_t c) const { return m_columns[c].data(); }
+    
+private:
+    std::array<std::vector<double>, Columns> m_columns;
+};
+
+typedef MLFeatureColumns<ML_NEIGHBOR_FEATURES> MLNeighborBatch;
+typedef MLFeatureColumns<ML_FEATURE_COUNT - ML_NEIGHBOR_FEATURES> MLBundleBatch;
+
+// Online learning: forwarding decisions awaiting feedback live in a fixed
+// ring; resolved decisions are trained on in mini-batches
+static const uint32_t ML_DECISION_HISTORY = 256;
+static const uint32_t ML_MINI_BATCH = 16;
+
+struct MLDecisionRecord {
+    uint64_t bundleKey;
+    MLFeatureVector features;
+    double prediction;  // Model output when the decision was taken
+    Time expiry;        // No delivery report by then counts as a failure
+    bool pending;
+};
+
+class MLRoutingEngine {
+public:
+    MLRoutingEngine();
+    ~MLRoutingEngine();
+    
+    void InitializeWeights(Ptr<UniformRandomVariable> rng);
+    
+    double CalculateDeliveryProbability(const DtnBundle& bundle, const NodeContext& currentNode, const NodeContext& neighborNode);
+    double CalculateUrgencyScore(const DtnBundle& bundle);
+    double CalculateUrgencyScore(const DtnBundle& bundle, Time now);
+    bool ShouldForwardBundle(const DtnBundle& bundle, const NodeContext& currentNode, const NodeContext& neighborNode);
+    
+    // Remembers a forward so delivery/expiry feedback can train on it
+    void RecordDecision(uint64_t bundleKey, const MLFeatureVector& features, double prediction, Time expiry);
+    // Feedback for every pending decision on bundleKey
+    void UpdateLearningModel(uint64_t bundleKey, bool deliverySuccess);
+    // Pending decisions whose bundle expired undelivered become failures
+    void ExpireDecisions(Time now);
+    
+    // Model averaging between meeting nodes, weighted by training samples
+    std::vector<double> GetWeights(void) const { return std::vector<double>(m_weights.begin(), m_weights.end()); }
+    uint32_t GetTrainedSamples(void) const { return m_trainedSamples; }
+    void AverageWith(const std::vector<double>& peerWeights, uint32_t peerSamples);
+    // Weights saved by a snapshot; false if they do not fit the feature count
+    bool SetWeights(const std::vector<double>& weights, uint32_t trainedSamples);
+    
+    // Mean squared error of the recorded predictions against their outcomes
+    double GetBrierScore(void) const { return m_resolvedDecisions ? m_brierSum / m_resolvedDecisions : 0.0; }
+    uint32_t GetResolvedDecisions(void) const { return m_resolvedDecisions; }
+    
+    // Batch inference: append rows, then ScoreBatch() fills logits row-major,
+    // logits[b * neighbours + n], and reuses the caller's storage
+    void AppendNeighbor(MLNeighborBatch& batch, const NodeContext& neighborNode) const;
+    void AppendBundle(MLBundleBatch& batch, const DtnBundle& bundle, Time now) const;
+    void ScoreBatch(const MLBundleBatch& bundles, const MLNeighborBatch& neighbors, std::vector<double>& logits);
+    // Forwarding threshold in logit space: comparing logits needs no exp per pair
+    double GetForwardThresholdLogit(double urgency) const;
+    MLFeatureVector GetPairFeatures(const MLBundleBatch& bundles, uint32_t b,
+                                    const MLNeighborBatch& neighbors, uint32_t n) const;
+    double LogitToProbability(double logit) { return Sigmoid(logit); }
+    
+private:
+    // Simple neural network weights (simplified implementation)
+    MLFeatureVector m_weights;
+    double m_learningRate;
+    
+    std::array<MLDecisionRecord, ML_DECISION_HISTORY> m_decisions;  // Ring, oldest overwritten
+    uint32_t m_nextDecision;
+    std::unordered_map<uint64_t, uint32_t> m_pendingPerBundle;  // Skips the ring scan for unknown keys
+    std::vector<std::pair<MLFeatureVector, double> > m_miniBatch;  // Features, label
+    uint32_t m_trainedSamples;
+    uint32_t m_resolvedDecisions;
+    double m_brierSum;
+    std::vector<double> m_bundleLogits;    // Scratch for ScoreBatch
+    std::vector<double> m_neighborLogits;  // Scratch for ScoreBatch
+    
+    double Sigmoid(double x);
+    MLFeatureVector ExtractFeatures(const DtnBundle& bundle, const NodeContext& neighborNode, Time now) const;
+    double PredictDeliverySuccess(const MLFeatureVector& features);
+    void ResolveDecision(MLDecisionRecord& record, bool deliverySuccess);
+    void TrainMiniBatch();
+};
+
+} // namespace ns3
+
+#endif // DTN_ML_ROUTING_ENGINE_H
@@ -0,0 +1,194 @@
+/*
+ * DTN Neighbour Discovery
+ * Beacon header serialisation and neighbour table liveness
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "dtn-neighbor-discovery.h"
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED(DtnBeaconHeader);
+
+TypeId DtnBeaconHeader::GetTypeId(void) {
+    static TypeId tid = TypeId("ns3::DtnBeaconHeader")
+        .SetParent<Header>()
+        .SetGroupName("Dtn")
+        .AddConstructor<DtnBeaconHeader>();
+    return tid;
+}
+
+DtnBeaconHeader::DtnBeaconHeader()
+    : m_senderNode(0),
+      m_interval(Seconds(0.0)) {
+}
+
+DtnBeaconHeader::~DtnBeaconHeader() {
+}
+
+TypeId DtnBeaconHeader::GetInstanceTypeId(void) const {
+    return GetTypeId();
+}
+
+uint32_t DtnBeaconHeader::GetSerializedSize(void) const {
+    uint32_t size = 9;
+    size += m_context.Has(DtnContextDelta::BATTERY) ? 2 : 0;
+    size += m_context.Has(DtnContextDelta::BUFFER) ? 2 : 0;
+    size += m_context.Has(DtnContextDelta::SOCIAL_WEIGHT) ? 2 : 0;
+    size += m_context.Has(DtnContextDelta::TRUST) ? 2 : 0;
+    size += m_context.Has(DtnContextDelta::POSITION) ? 8 : 0;
+    size += m_context.Has(DtnContextDelta::NODE_TYPE) ? 1 : 0;
+    return size;
+}
+
+void DtnBeaconHeader::Serialize(Buffer::Iterator start) const {
+    start.WriteHtonU32(m_senderNode);
+    start.WriteHtonU32(static_cast<uint32_t>(m_interval.GetMilliSeconds()));
+    start.WriteU8(m_context.mask);
+    if (m_context.Has(DtnContextDelta::BATTERY)) {
+        start.WriteHtonU16(QuantiseFraction(m_context.batteryLevel));
+    }
+    if (m_context.Has(DtnContextDelta::BUFFER)) {
+        start.WriteHtonU16(std::min<uint32_t>(m_context.bufferOccupancy, 0xFFFF));
+    }
+    if (m_context.Has(DtnContextDelta::SOCIAL_WEIGHT)) {
+        start.WriteHtonU16(QuantiseFraction(m_context.socialWeight));
+    }
+    if (m_context.Has(DtnContextDelta::TRUST)) {
+        start.WriteHtonU16(QuantiseFraction(m_context.trustScore));
+    }
+    if (m_context.Has(DtnContextDelta::POSITION)) {
+        start.WriteHtonU32(static_cast<uint32_t>(static_cast<int32_t>(std::lround(m_context.position.x * 10.0))));
+        start.WriteHtonU32(static_cast<uint32_t>(static_cast<int32_t>(std::lround(m_context.position.y * 10.0))));
+    }
+    if (m_context.Has(DtnContextDelta::NODE_TYPE)) {
+        start.WriteU8(m_context.nodeType);
+    }
+}
+
+uint32_t DtnBeaconHeader::Deserialize(Buffer::Iterator start) {
+    Buffer::Iterator i = start;
+    m_senderNode = i.ReadNtohU32();
+    m_interval = MilliSeconds(i.ReadNtohU32());
+    m_context = DtnContextDelta();
+    m_context.mask = i.ReadU8() & DtnContextDelta::ALL;
+    if (m_context.Has(DtnContextDelta::BATTERY)) {
+        m_context.batteryLevel = i.ReadNtohU16() / 65535.0;
+    }
+    if (m_context.Has(DtnContextDelta::BUFFER)) {
+        m_context.bufferOccupancy = i.ReadNtohU16();
+    }
+    if (m_context.Has(DtnContextDelta::SOCIAL_WEIGHT)) {
+        m_context.socialWeight = i.ReadNtohU16() / 65535.0;
+    }
+    if (m_context.Has(DtnContextDelta::TRUST)) {
+        m_context.trustScore = i.ReadNtohU16() / 65535.0;
+    }
+    if (m_context.Has(DtnContextDelta::POSITION)) {
+        m_context.position.x = static_cast<int32_t>(i.ReadNtohU32()) / 10.0;
+        m_context.position.y = static_cast<int32_t>(i.ReadNtohU32()) / 10.0;
+    }
+    if (m_context.Has(DtnContextDelta::NODE_TYPE)) {
+        m_context.nodeType = i.ReadU8();
+    }
+    return i.GetDistanceFrom(start);
+}
+
+void DtnBeaconHeader::Print(std::ostream& os) const {
+    os << "sender=" << m_senderNode << " interval=" << m_interval.GetSeconds() << "s"
+       << " context=0x" << std::hex << static_cast<uint32_t>(m_context.mask) << std::dec;
+}
+
+DtnNeighbor* NeighborTable::Heard(uint32_t nodeId, const Address& address, Time holdTime) {
+    Time now = Simulator::Now();
+    auto it = m_neighbors.find(nodeId);
+    if (it != m_neighbors.end()) {
+        it->second.address = address;
+        it->second.lastHeard = now;
+        it->second.holdTime = holdTime;
+        // A shorter hold time can bring the deadline before the pending
+        // check; a later one is picked up when that check reschedules
+        ScheduleCheck(now + holdTime);
+        return &it->second;
+    }
+
+    DtnNeighbor& neighbor = m_neighbors[nodeId];
+    neighbor.nodeId = nodeId;
+    neighbor.address = address;
+    neighbor.contactStart = now;
+    neighbor.lastHeard = now;
+    neighbor.holdTime = holdTime;
+    neighbor.hasVector = false;
+    ScheduleCheck(now + holdTime);
+
+    if (!m_contactUp.IsNull()) {
+        m_contactUp(nodeId);
+    }
+    return Find(nodeId);
+}
+
+DtnNeighbor* NeighborTable::FindByAddress(Ipv4Address address) {
+    for (auto& entry : m_neighbors) {
+        if (InetSocketAddress::ConvertFrom(entry.second.address).GetIpv4() == address) {
+            return &entry.second;
+        }
+    }
+    return nullptr;
+}
+
+void NeighborTable::Remove(uint32_t nodeId) {
+    if (m_neighbors.erase(nodeId) && !m_contactDown.IsNull()) {
+        m_contactDown(nodeId);
+    }
+}
+
+void NeighborTable::RemoveAll(void) {
+    std::vector<uint32_t> lost;
+    for (const auto& entry : m_neighbors) {
+        lost.push_back(entry.first);
+    }
+    Clear();
+    for (uint32_t nodeId : lost) {
+        if (!m_contactDown.IsNull()) {
+            m_contactDown(nodeId);
+        }
+    }
+}
+
+void NeighborTable::CheckContacts(void) {
+    Time now = Simulator::Now();
+    Time nextDeadline = Time::Max();
+    std::vector<uint32_t> lost;
+    for (const auto& entry : m_neighbors) {
+        Time deadline = entry.second.lastHeard + entry.second.holdTime;
+        if (deadline <= now) {
+            lost.push_back(entry.first);
+        } else {
+            nextDeadline = std::min(nextDeadline, deadline);
+        }
+    }
+
+    for (uint32_t nodeId : lost) {
+        m_neighbors.erase(nodeId);
+        if (!m_contactDown.IsNull()) {
+            m_contactDown(nodeId);
+        }
+    }
+
+    if (nextDeadline != Time::Max()) {
+        ScheduleCheck(nextDeadline);
+    }
+}
+
+void NeighborTable::ScheduleCheck(Time deadline) {
+    if (m_checkEvent.IsPending() && m_nextCheck <= deadline) {
+        return;
+    }
+    Simulator::Cancel(m_checkEvent);
+    m_nextCheck = deadline;
+    m_checkEvent = Simulator::Schedule(deadline - Simulator::Now(), &NeighborTable::CheckContacts, this);
+}
+
+} // namespace ns3
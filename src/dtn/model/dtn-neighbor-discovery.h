@@ -0,0 +1,191 @@
+/*
+ * DTN Neighbour Discovery
+ * Beacon header and neighbour table raising contact-up/contact-down events
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#ifndef DTN_NEIGHBOR_DISCOVERY_H
+#define DTN_NEIGHBOR_DISCOVERY_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "dtn-summary-vector-header.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <unordered_set>
+#include <vector>
+
+namespace ns3 {
+
+/*
+ * Node context piggy-backed on beacons. Only the fields flagged in mask
+ * go on the wire, so a beacon carries just what moved noticeably since
+ * the sender's previous advertisement; ALL marks a full refresh.
+ */
+struct DtnContextDelta {
+    enum Field {
+        BATTERY = 0x01,
+        BUFFER = 0x02,
+        SOCIAL_WEIGHT = 0x04,
+        TRUST = 0x08,
+        POSITION = 0x10,
+        NODE_TYPE = 0x20,
+        ALL = 0x3F
+    };
+
+    DtnContextDelta()
+        : mask(0),
+          batteryLevel(0.0),
+          bufferOccupancy(0),
+          socialWeight(0.0),
+          trustScore(0.0),
+          nodeType(0) {
+    }
+
+    bool Has(Field field) const { return (mask & field) != 0; }
+
+    uint8_t mask;
+    double batteryLevel;       // [0, 1]
+    uint32_t bufferOccupancy;  // Bundles held
+    double socialWeight;       // [0, 1]
+    double trustScore;         // [0, 1]
+    Vector position;           // x and y only, decimetre resolution
+    uint8_t nodeType;
+};
+
+/*
+ * Hello beacon broadcast by every node. It carries the sender and its
+ * beacon interval, so receivers can size the contact hold time to the
+ * sender's own rate, plus an optional context delta; bundle digests
+ * travel in unicast summary vectors once a contact is up. Interval 0 is
+ * a goodbye: the sender's radio is about to sleep.
+ *
+ * Wire layout (network byte order, 9 bytes + context fields):
+ *   sender(4) interval(4, ms) mask(1)
+ *   [battery(2)] [buffer(2)] [socialWeight(2)] [trust(2)]
+ *   [x(4, dm) y(4, dm)] [nodeType(1)]
+ * Fractions are quantised to 1/65535.
+ */
+class DtnBeaconHeader : public Header {
+public:
+    static TypeId GetTypeId(void);
+    DtnBeaconHeader();
+    virtual ~DtnBeaconHeader();
+
+    void SetSenderNode(uint32_t sender) { m_senderNode = sender; }
+    uint32_t GetSenderNode(void) const { return m_senderNode; }
+    void SetInterval(Time interval) { m_interval = interval; }
+    Time GetInterval(void) const { return m_interval; }
+    void SetContext(const DtnContextDelta& context) { m_context = context; }
+    const DtnContextDelta& GetContext(void) const { return m_context; }
+
+    virtual TypeId GetInstanceTypeId(void) const;
+    virtual uint32_t GetSerializedSize(void) const;
+    virtual void Serialize(Buffer::Iterator start) const;
+    virtual uint32_t Deserialize(Buffer::Iterator start);
+    virtual void Print(std::ostream& os) const;
+
+private:
+    static uint16_t QuantiseFraction(double value) {
+        return static_cast<uint16_t>(std::max(0.0, std::min(1.0, value)) * 0xFFFF + 0.5);
+    }
+
+    uint32_t m_senderNode;
+    Time m_interval;
+    DtnContextDelta m_context;
+};
+
+// Hold time for a sender beaconing every interval: three missed beacons close the contact
+inline Time BeaconHoldTime(Time interval) {
+    return MilliSeconds(interval.GetMilliSeconds() * 3);
+}
+
+/*
+ * One node currently in radio contact. Besides liveness it remembers what
+ * the peer is known to hold: its last summary vector plus every bundle
+ * exchanged with it since, so buffer changes during a long contact can be
+ * pushed without asking for a fresh vector.
+ */
+struct DtnNeighbor {
+    uint32_t nodeId;
+    Address address;   // Peer's DTN socket address
+    Time contactStart;
+    Time lastHeard;
+    Time holdTime;     // Contact drops after this long without hearing the peer
+    bool hasVector;
+    DtnSummaryVectorHeader vector;
+    DtnSummaryVectorHeader pendingVector;  // Parts received so far of the next vector
+    std::unordered_set<uint64_t> exchangedKeys;
+
+    bool Has(uint64_t key) const {
+        return (hasVector && vector.Contains(key)) || exchangedKeys.count(key) > 0;
+    }
+};
+
+/*
+ * Neighbour table fed by beacons (and any other message naming its
+ * sender). A node heard for the first time raises contact-up; one that
+ * stays silent for its hold time raises contact-down. Liveness is checked
+ * by a single timer armed at the earliest hold-time deadline, so a node
+ * with no neighbours schedules nothing beyond its own beacon.
+ */
+class NeighborTable {
+public:
+    typedef Callback<void, uint32_t> ContactCallback;
+
+    NeighborTable() {}
+    ~NeighborTable() { Clear(); }
+
+    void SetContactUpCallback(ContactCallback callback) { m_contactUp = callback; }
+    void SetContactDownCallback(ContactCallback callback) { m_contactDown = callback; }
+
+    // Refreshes (or opens) the contact with nodeId
+    DtnNeighbor* Heard(uint32_t nodeId, const Address& address, Time holdTime);
+
+    DtnNeighbor* Find(uint32_t nodeId) {
+        auto it = m_neighbors.find(nodeId);
+        return it == m_neighbors.end() ? nullptr : &it->second;
+    }
+    DtnNeighbor* FindByAddress(Ipv4Address address);
+
+    uint32_t GetSize(void) const { return m_neighbors.size(); }
+    bool IsEmpty(void) const { return m_neighbors.empty(); }
+
+    // The callback must not open or close contacts
+    template <typename F>
+    void ForEach(F callback) {
+        for (auto& entry : m_neighbors) {
+            callback(entry.second);
+        }
+    }
+
+    // Closes a contact at once, raising contact-down
+    void Remove(uint32_t nodeId);
+    // Closes every contact, raising contact-down for each
+    void RemoveAll(void);
+
+    // Forgets every neighbour without raising contact-down
+    void Clear(void) {
+        Simulator::Cancel(m_checkEvent);
+        m_neighbors.clear();
+    }
+
+private:
+    void CheckContacts(void);
+    void ScheduleCheck(Time deadline);
+
+    std::map<uint32_t, DtnNeighbor> m_neighbors;
+    ContactCallback m_contactUp;
+    ContactCallback m_contactDown;
+    EventId m_checkEvent;
+    Time m_nextCheck;
+};
+
+} // namespace ns3
+
+#endif // DTN_NEIGHBOR_DISCOVERY_H
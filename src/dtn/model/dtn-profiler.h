@@ -0,0 +1,144 @@
+/*
+ * DTN Profiler
+ * Per-phase wall-clock counters around the simulation hot paths
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#ifndef DTN_PROFILER_H
+#define DTN_PROFILER_H
+
+#include "ns3/core-module.h"
+#include <chrono>
+#include <ostream>
+#include <string>
+
+namespace ns3 {
+
+enum DtnProfilePhase {
+    DTN_PROFILE_PHY_RECEIVE = 0,  // Frames the Wi-Fi PHYs received (PhyRxEnd), counted only
+    DTN_PROFILE_PHY_FILTER,       // Spatial filter per transmitter/receiver pair
+    DTN_PROFILE_HANDLE_READ,      // Socket receive, including the routing it triggers
+    DTN_PROFILE_ROUTING,          // Routing passes and summary-vector exchanges
+    DTN_PROFILE_EXPIRY,           // TTL cleanup
+    DTN_PROFILE_TRACE_IO,         // Message-flow trace writes
+    DTN_PROFILE_STATS,            // Stats collector samples
+    DTN_PROFILE_ANIMATION_SETUP,  // AnimationInterface setup, before Simulator::Run() and outside its shares
+    DTN_PROFILE_PHASES
+};
+
+inline const char* DtnProfilePhaseName(uint32_t phase) {
+    static const char* names[] = {"PhyReceive", "PhyFilter", "HandleRead", "Routing",
+                                  "TtlExpiry", "TraceIO", "StatsSample", "AnimationSetup"};
+    static_assert(sizeof(names) / sizeof(names[0]) == DTN_PROFILE_PHASES, "One name per phase");
+    return phase < DTN_PROFILE_PHASES ? names[phase] : "Unknown";
+}
+
+class DtnProfileScope;
+
+/*
+ * Process-wide phase counters: calls, inclusive nanoseconds and self
+ * nanoseconds (less the phases nested inside, e.g. the routing a
+ * HandleRead triggers). The self times do not overlap, so Simulator::Run()
+ * wall clock less their sum is the time spent in ns-3 itself: the PHY and
+ * MAC state machines, the channel and NetAnim's per-packet trace sinks.
+ * None of those can be scoped from this module, so Ns3Other does not tell
+ * them apart; PhyReceive only counts the frames the PHYs delivered.
+ *
+ * Instrumentation goes through DTN_PROFILE_SCOPE / DTN_PROFILE_COUNT,
+ * which only exist when the module is built with DTN_PROFILING
+ * (./ns3 configure -- -DDTN_PROFILING=ON); otherwise they compile to
+ * nothing and the counters stay empty.
+ */
+class DtnProfiler {
+public:
+    struct Counter {
+        Counter()
+            : calls(0),
+              totalNs(0),
+              selfNs(0) {
+        }
+
+        uint64_t calls;
+        uint64_t totalNs;
+        uint64_t selfNs;
+    };
+
+    static DtnProfiler& Get(void);
+    static bool IsCompiledIn(void);
+
+    void Count(DtnProfilePhase phase) { m_counters[phase].calls++; }
+    const Counter& GetCounter(DtnProfilePhase phase) const { return m_counters[phase]; }
+    // Simulator::Run() wall clock the remainder is taken from
+    void AddRunTime(double wallSeconds) { m_runSeconds += wallSeconds; }
+    void Reset(void);
+
+    // PROFILE section: one row per phase plus the ns-3 remainder
+    void Write(std::ostream& os) const;
+    // Writes the table to path (empty for none) and logs it at
+    // Simulator::Destroy(); call after the devices are installed so the
+    // PHY receive counter can be connected
+    void ReportAtDestroy(std::string path);
+
+private:
+    friend class DtnProfileScope;
+
+    DtnProfiler();
+    void Report(void);
+
+    Counter m_counters[DTN_PROFILE_PHASES];
+    DtnProfileScope* m_current;  // Innermost open scope
+    double m_runSeconds;
+    std::string m_reportPath;
+    bool m_reportScheduled;
+};
+
+// Times its own lifetime into one phase; nests
+class DtnProfileScope {
+public:
+    explicit DtnProfileScope(DtnProfilePhase phase)
+        : m_phase(phase),
+          m_childNs(0),
+          m_parent(DtnProfiler::Get().m_current),
+          m_start(std::chrono::steady_clock::now()) {
+        DtnProfiler::Get().m_current = this;
+    }
+
+    ~DtnProfileScope() {
+        uint64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now() - m_start).count();
+        DtnProfiler& profiler = DtnProfiler::Get();
+        DtnProfiler::Counter& counter = profiler.m_counters[m_phase];
+        counter.calls++;
+        counter.totalNs += elapsed;
+        counter.selfNs += elapsed - m_childNs;
+        if (m_parent) {
+            m_parent->m_childNs += elapsed;
+        }
+        profiler.m_current = m_parent;
+    }
+
+private:
+    DtnProfileScope(const DtnProfileScope&) = delete;
+    DtnProfileScope& operator=(const DtnProfileScope&) = delete;
+
+    DtnProfilePhase m_phase;
+    uint64_t m_childNs;
+    DtnProfileScope* m_parent;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+#ifdef DTN_PROFILING
+#define DTN_PROFILE_CONCAT2(a, b) a##b
+#define DTN_PROFILE_CONCAT(a, b) DTN_PROFILE_CONCAT2(a, b)
+#define DTN_PROFILE_SCOPE(phase) DtnProfileScope DTN_PROFILE_CONCAT(dtnProfileScope, __LINE__)(phase)
+#define DTN_PROFILE_COUNT(phase) DtnProfiler::Get().Count(phase)
+#else
+#define DTN_PROFILE_SCOPE(phase) do { } while (false)
+#define DTN_PROFILE_COUNT(phase) do { } while (false)
+#endif
+
+} // namespace ns3
+
+#endif // DTN_PROFILER_H
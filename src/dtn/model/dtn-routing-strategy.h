@@ -0,0 +1,269 @@
+/*
+ * DTN Routing Strategies
+ * Pluggable forwarding decisions (Epidemic, PROPHET, Spray-and-Wait)
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#ifndef DTN_ROUTING_STRATEGY_H
+#define DTN_ROUTING_STRATEGY_H
+
+#include "ns3/core-module.h"
+#include <cmath>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+
+namespace ns3 {
+
+/*
+ * Per-node forwarding policy. The application owns the buffer and the
+ * summary-vector exchange; on every contact it calls NotifyContact() with
+ * the peer's advertised predictabilities and then asks ShouldForward() for
+ * each bundle the peer is missing. OnForward() splits the bundle's copy
+ * budget: the return value travels with the forwarded copy, the rest stays.
+ * WriteState()/ReadState() carry whatever a strategy learnt across a
+ * DtnSnapshot as whitespace-separated tokens.
+ */
+class RoutingStrategy : public SimpleRefCount<RoutingStrategy> {
+public:
+    RoutingStrategy() : m_nodeId(0) {}
+    virtual ~RoutingStrategy() {}
+
+    virtual void SetNodeId(uint32_t nodeId) { m_nodeId = nodeId; }
+    uint32_t GetNodeId(void) const { return m_nodeId; }
+
+    virtual std::string GetName(void) const = 0;
+
+    // Copy budget for a bundle created on this node
+    virtual uint32_t GetInitialCopies(void) const { return 1; }
+
+    // Contact opened with peer; peerPredictability is what the peer advertised
+    virtual void NotifyContact(uint32_t peer, const std::map<uint32_t, double>& peerPredictability) {}
+
+    // Table to advertise in our own summary vector (empty if unused)
+    virtual std::map<uint32_t, double> GetPredictabilities(void) { return std::map<uint32_t, double>(); }
+
+    // A bundle for the peer itself is always handed over
+    bool ShouldForward(uint32_t destination, uint32_t copies, uint32_t peer) {
+        return destination == peer || DoShouldForward(destination, copies, peer);
+    }
+
+    // Default: replicate without touching the copy budget
+    virtual uint32_t OnForward(uint32_t& copies) { return copies; }
+
+    // Learnt state, for snapshots; stateless strategies write nothing
+    virtual void WriteState(std::ostream& os) const {}
+    // False if the tokens are not a state this strategy wrote
+    virtual bool ReadState(std::istream& is) { return true; }
+
+protected:
+    virtual bool DoShouldForward(uint32_t destination, uint32_t copies, uint32_t peer) = 0;
+
+private:
+    uint32_t m_nodeId;
+};
+
+// Epidemic: every contact gets every bundle it is missing
+class EpidemicStrategy : public RoutingStrategy {
+public:
+    virtual std::string GetName(void) const { return "Epidemic"; }
+
+protected:
+    virtual bool DoShouldForward(uint32_t destination, uint32_t copies, uint32_t peer) { return true; }
+};
+
+/*
+ * PROPHET (Lindgren et al.): delivery predictabilities with encounter
+ * reinforcement, exponential aging and transitivity. A bundle is handed to
+ * a peer whose predictability for the destination beats ours (GRTR).
+ */
+class ProphetStrategy : public RoutingStrategy {
+public:
+    ProphetStrategy()
+        : m_pInit(0.75),
+          m_beta(0.25),
+          m_gamma(0.98),
+          m_agingUnit(Seconds(30.0)),
+          m_lastAging(Seconds(0.0)) {
+    }
+
+    void SetParameters(double pInit, double beta, double gamma, Time agingUnit) {
+        m_pInit = pInit;
+        m_beta = beta;
+        m_gamma = gamma;
+        m_agingUnit = agingUnit;
+    }
+
+    virtual std::string GetName(void) const { return "Prophet"; }
+
+    virtual void NotifyContact(uint32_t peer, const std::map<uint32_t, double>& peerPredictability) {
+        Age();
+
+        // Encounter: P(a,b) = P(a,b)_old + (1 - P(a,b)_old) * P_init
+        double& pPeer = m_predictability[peer];
+        pPeer = pPeer + (1.0 - pPeer) * m_pInit;
+
+        // Transitivity: P(a,c) = P(a,c)_old + (1 - P(a,c)_old) * P(a,b) * P(b,c) * beta
+        for (const auto& entry : peerPredictability) {
+            if (entry.first == GetNodeId() || entry.first == peer) {
+                continue;
+            }
+            double& pDest = m_predictability[entry.first];
+            pDest = pDest + (1.0 - pDest) * pPeer * entry.second * m_beta;
+        }
+
+        m_peerPredictability[peer] = peerPredictability;
+    }
+
+    virtual std::map<uint32_t, double> GetPredictabilities(void) {
+        Age();
+        return m_predictability;
+    }
+
+    double GetPredictability(uint32_t destination) const {
+        auto it = m_predictability.find(destination);
+        return it == m_predictability.end() ? 0.0 : it->second;
+    }
+
+    // <last aging ns> <n> {dest p}*n <peers> {peer <m> {dest p}*m}*
+    virtual void WriteState(std::ostream& os) const {
+        os << m_lastAging.GetNanoSeconds();
+        WriteTable(os, m_predictability);
+        os << " " << m_peerPredictability.size();
+        for (const auto& peer : m_peerPredictability) {
+            os << " " << peer.first;
+            WriteTable(os, peer.second);
+        }
+    }
+
+    virtual bool ReadState(std::istream& is) {
+        int64_t lastAgingNs;
+        uint32_t peers;
+        std::map<uint32_t, double> predictability;
+        std::map<uint32_t, std::map<uint32_t, double> > peerPredictability;
+        if (!(is >> lastAgingNs) || !ReadTable(is, predictability) || !(is >> peers)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < peers; ++i) {
+            uint32_t peer;
+            if (!(is >> peer) || !ReadTable(is, peerPredictability[peer])) {
+                return false;
+            }
+        }
+        m_lastAging = NanoSeconds(lastAgingNs);
+        m_predictability.swap(predictability);
+        m_peerPredictability.swap(peerPredictability);
+        return true;
+    }
+
+protected:
+    virtual bool DoShouldForward(uint32_t destination, uint32_t copies, uint32_t peer) {
+        auto table = m_peerPredictability.find(peer);
+        if (table == m_peerPredictability.end()) {
+            return false;
+        }
+        auto entry = table->second.find(destination);
+        double peerP = entry == table->second.end() ? 0.0 : entry->second;
+        return peerP > GetPredictability(destination);
+    }
+
+private:
+    // Aging: P = P_old * gamma^k, k = time units since the last aging
+    void Age(void) {
+        Time now = Simulator::Now();
+        double k = (now - m_lastAging).GetSeconds() / m_agingUnit.GetSeconds();
+        if (k <= 0.0) {
+            return;
+        }
+        double factor = std::pow(m_gamma, k);
+        for (auto it = m_predictability.begin(); it != m_predictability.end(); ) {
+            it->second *= factor;
+            if (it->second < 1e-4) {
+                it = m_predictability.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        m_lastAging = now;
+    }
+
+    static void WriteTable(std::ostream& os, const std::map<uint32_t, double>& table) {
+        os << " " << table.size();
+        for (const auto& entry : table) {
+            os << " " << entry.first << " " << entry.second;
+        }
+    }
+
+    static bool ReadTable(std::istream& is, std::map<uint32_t, double>& table) {
+        uint32_t size;
+        if (!(is >> size)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < size; ++i) {
+            uint32_t destination;
+            double p;
+            if (!(is >> destination >> p)) {
+                return false;
+            }
+            table[destination] = p;
+        }
+        return true;
+    }
+
+    double m_pInit;
+    double m_beta;
+    double m_gamma;
+    Time m_agingUnit;
+    Time m_lastAging;
+    std::map<uint32_t, double> m_predictability;
+    std::map<uint32_t, std::map<uint32_t, double> > m_peerPredictability;  // Last table per peer
+};
+
+/*
+ * Binary Spray-and-Wait (Spyropoulos et al.): a bundle starts with L
+ * copies; a holder with n > 1 copies hands floor(n/2) to the next node it
+ * meets and keeps the rest. With one copy left it only waits for the
+ * destination.
+ */
+class SprayAndWaitStrategy : public RoutingStrategy {
+public:
+    explicit SprayAndWaitStrategy(uint32_t initialCopies = 8)
+        : m_initialCopies(initialCopies) {
+    }
+
+    virtual std::string GetName(void) const { return "SprayAndWait"; }
+    virtual uint32_t GetInitialCopies(void) const { return m_initialCopies; }
+
+    virtual uint32_t OnForward(uint32_t& copies) {
+        uint32_t handed = copies / 2;
+        copies -= handed;
+        return handed;
+    }
+
+protected:
+    virtual bool DoShouldForward(uint32_t destination, uint32_t copies, uint32_t peer) { return copies > 1; }
+
+private:
+    uint32_t m_initialCopies;
+};
+
+// Builds the strategy named on the command line; 0 for an unknown name
+inline Ptr<RoutingStrategy> CreateRoutingStrategy(const std::string& name, uint32_t sprayCopies = 8) {
+    if (name == "Epidemic") {
+        return Create<EpidemicStrategy>();
+    }
+    if (name == "Prophet") {
+        return Create<ProphetStrategy>();
+    }
+    if (name == "SprayAndWait") {
+        return Create<SprayAndWaitStrategy>(sprayCopies);
+    }
+    return 0;
+}
+
+} // namespace ns3
+
+#endif // DTN_ROUTING_STRATEGY_H
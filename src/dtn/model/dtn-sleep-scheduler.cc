@@ -0,0 +1,231 @@
+/*
+ * DTN Sleep Scheduler
+ * Asynchronous duty-cycled wakeup schedules that put the radio to sleep between contacts
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "dtn-sleep-scheduler.h"
+#include "dtn-bundle.h"
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("DtnSleepScheduler");
+
+namespace {
+
+bool IsPrime(uint32_t n) {
+    if (n < 2) {
+        return false;
+    }
+    for (uint32_t d = 2; d * d <= n; ++d) {
+        if (n % d == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+DtnWakeupSchedule::DtnWakeupSchedule()
+    : m_slot(Seconds(1.0)),
+      m_primeA(0),
+      m_primeB(0) {
+}
+
+DtnWakeupSchedule::DtnWakeupSchedule(Time slot, uint32_t primeA, uint32_t primeB)
+    : m_slot(slot),
+      m_primeA(std::min(primeA, primeB)),
+      m_primeB(std::max(primeA, primeB)) {
+    NS_ABORT_MSG_UNLESS(slot.IsStrictlyPositive(), "Wakeup slot must be positive");
+    NS_ABORT_MSG_UNLESS(IsPrime(primeA) && IsPrime(primeB) && primeA != primeB,
+                        "Wakeup schedule needs two distinct primes, got " << primeA << " and " << primeB);
+}
+
+DtnWakeupSchedule DtnWakeupSchedule::ForNodeType(uint32_t nodeType, Time slot) {
+    switch (nodeType) {
+        case IOT_SENSOR:
+            return DtnWakeupSchedule(slot, 23, 29);
+        case CIVILIAN_DEVICE:
+            return DtnWakeupSchedule(slot, 7, 11);
+        default:
+            return DtnWakeupSchedule();
+    }
+}
+
+double DtnWakeupSchedule::GetDutyCycle(void) const {
+    if (IsAlwaysOn()) {
+        return 1.0;
+    }
+    // Slot 0 mod both primes is counted once
+    return 1.0 / m_primeA + 1.0 / m_primeB - 1.0 / ((double)m_primeA * m_primeB);
+}
+
+int64_t DtnWakeupSchedule::GetNextAwakeSlot(int64_t slot) const {
+    if (IsAlwaysOn()) {
+        return slot + 1;
+    }
+    int64_t nextA = (slot / m_primeA + 1) * m_primeA;
+    int64_t nextB = (slot / m_primeB + 1) * m_primeB;
+    return std::min(nextA, nextB);
+}
+
+uint64_t DtnWakeupSchedule::GetDiscoveryBound(const DtnWakeupSchedule& a, const DtnWakeupSchedule& b) {
+    if (a.IsAlwaysOn() && b.IsAlwaysOn()) {
+        return 1;
+    }
+    if (a.IsAlwaysOn() || b.IsAlwaysOn()) {
+        const DtnWakeupSchedule& duty = a.IsAlwaysOn() ? b : a;
+        return duty.m_primeA;
+    }
+    uint64_t bound = NO_GUARANTEE;
+    const uint32_t primesA[] = {a.m_primeA, a.m_primeB};
+    const uint32_t primesB[] = {b.m_primeA, b.m_primeB};
+    for (uint32_t pa : primesA) {
+        for (uint32_t pb : primesB) {
+            if (pa != pb) {
+                bound = std::min<uint64_t>(bound, (uint64_t)pa * pb);
+            }
+        }
+    }
+    return bound;
+}
+
+DtnSleepScheduler::DtnSleepScheduler()
+    : m_running(false),
+      m_awake(true) {
+}
+
+void DtnSleepScheduler::Start(const DtnWakeupSchedule& schedule, Time offset, Time guard) {
+    Stop();
+    m_schedule = schedule;
+    m_awakeTotal = Seconds(0.0);
+    Time now = Simulator::Now();
+    m_started = now;
+    m_stopped = now;
+    if (schedule.IsAlwaysOn()) {
+        return;
+    }
+
+    m_running = true;
+    m_guard = guard;
+    m_origin = now - offset;
+    m_keepAwakeUntil = now;
+    m_awakeSince = now;
+    int64_t slot = SlotAt(now);
+    if (m_schedule.IsAwakeSlot(slot)) {
+        m_awake = true;
+        Schedule(SlotStart(slot + 1), &DtnSleepScheduler::SlotEnd);
+    } else {
+        m_awake = false;
+        if (!m_sleep.IsNull()) {
+            m_sleep();
+        }
+        Schedule(SlotStart(m_schedule.GetNextAwakeSlot(slot)), &DtnSleepScheduler::Wake);
+    }
+    NS_LOG_DEBUG("Duty cycle " << 100.0 * m_schedule.GetDutyCycle() << "% over " << m_schedule.GetSlot().GetSeconds()
+                 << " s slots, primes " << m_schedule.GetPrimeA() << " and " << m_schedule.GetPrimeB());
+}
+
+void DtnSleepScheduler::Stop(void) {
+    if (!m_running) {
+        return;
+    }
+    Simulator::Cancel(m_event);
+    Time now = Simulator::Now();
+    if (m_awake) {
+        m_awakeTotal += now - m_awakeSince;
+    }
+    m_stopped = now;
+    m_running = false;
+    m_awake = true;
+}
+
+void DtnSleepScheduler::WakeNow(void) {
+    if (!m_running || m_awake) {
+        return;
+    }
+    Simulator::Cancel(m_event);
+    NS_LOG_DEBUG("Woken out of schedule");
+    Wake();
+    // Off the slot grid until the hold and any KeepAwake() window are over
+    Simulator::Cancel(m_event);
+    Schedule(Simulator::Now() + m_guard, &DtnSleepScheduler::TrySleep);
+}
+
+void DtnSleepScheduler::KeepAwake(Time duration) {
+    if (m_running) {
+        m_keepAwakeUntil = std::max(m_keepAwakeUntil, Simulator::Now() + duration);
+    }
+}
+
+Time DtnSleepScheduler::GetAwakeTime(void) const {
+    if (m_running && m_awake) {
+        return m_awakeTotal + (Simulator::Now() - m_awakeSince);
+    }
+    return m_awakeTotal;
+}
+
+Time DtnSleepScheduler::GetRunningTime(void) const {
+    return (m_running ? Simulator::Now() : m_stopped) - m_started;
+}
+
+void DtnSleepScheduler::Wake(void) {
+    Time now = Simulator::Now();
+    m_awake = true;
+    m_awakeSince = now;
+    if (!m_wake.IsNull()) {
+        m_wake();
+    }
+    if (!m_slotEdge.IsNull()) {
+        m_slotEdge();
+    }
+    Schedule(SlotStart(SlotAt(now) + 1), &DtnSleepScheduler::SlotEnd);
+}
+
+void DtnSleepScheduler::SlotEnd(void) {
+    if (!m_slotEdge.IsNull()) {
+        m_slotEdge();
+    }
+    int64_t slot = SlotAt(Simulator::Now());
+    if (m_schedule.IsAwakeSlot(slot)) {
+        // The next slot is awake too; this edge was its start
+        Schedule(SlotStart(slot + 1), &DtnSleepScheduler::SlotEnd);
+    } else {
+        Schedule(Simulator::Now() + m_guard, &DtnSleepScheduler::TrySleep);
+    }
+}
+
+void DtnSleepScheduler::TrySleep(void) {
+    Time now = Simulator::Now();
+    int64_t slot = SlotAt(now);
+    if (m_schedule.IsAwakeSlot(slot)) {
+        // Held into an awake slot: back on the schedule's edges
+        Schedule(SlotStart(slot + 1), &DtnSleepScheduler::SlotEnd);
+        return;
+    }
+    if (!m_hold.IsNull() && m_hold()) {
+        Schedule(SlotStart(slot + 1), &DtnSleepScheduler::TrySleep);
+        return;
+    }
+    if (now < m_keepAwakeUntil) {
+        Schedule(m_keepAwakeUntil, &DtnSleepScheduler::TrySleep);
+        return;
+    }
+
+    m_awake = false;
+    m_awakeTotal += now - m_awakeSince;
+    if (!m_sleep.IsNull()) {
+        m_sleep();
+    }
+    Schedule(SlotStart(m_schedule.GetNextAwakeSlot(slot)), &DtnSleepScheduler::Wake);
+}
+
+void DtnSleepScheduler::Schedule(Time at, void (DtnSleepScheduler::*handler)(void)) {
+    m_event = Simulator::Schedule(at - Simulator::Now(), handler, this);
+}
+
+} // namespace ns3
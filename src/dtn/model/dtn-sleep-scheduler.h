@@ -0,0 +1,130 @@
+/*
+ * DTN Sleep Scheduler
+ * Asynchronous duty-cycled wakeup schedules that put the radio to sleep between contacts
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#ifndef DTN_SLEEP_SCHEDULER_H
+#define DTN_SLEEP_SCHEDULER_H
+
+#include "ns3/core-module.h"
+#include <limits>
+
+namespace ns3 {
+
+/*
+ * Disco wakeup schedule: time is cut into slots and a node is awake in
+ * slot k when k is a multiple of either of its two primes, so the duty
+ * cycle is about 1/primeA + 1/primeB. Two nodes need no common clock:
+ * whatever the offset between their slot counters, the Chinese remainder
+ * theorem puts an awake slot of one on an awake slot of the other within
+ * the product of two distinct primes of theirs. Slot edges need not line
+ * up either, as long as a node beacons at both edges of its awake slots.
+ * primeA 0 is a node that never sleeps.
+ */
+class DtnWakeupSchedule {
+public:
+    static const uint64_t NO_GUARANTEE = std::numeric_limits<uint64_t>::max();
+
+    // Always on
+    DtnWakeupSchedule();
+    // Distinct primes
+    DtnWakeupSchedule(Time slot, uint32_t primeA, uint32_t primeB);
+
+    // Per NodeType duty cycle: IOT_SENSOR (23, 29) about 8%, CIVILIAN_DEVICE
+    // (7, 11) about 22%; responders, vehicles and infrastructure stay on
+    static DtnWakeupSchedule ForNodeType(uint32_t nodeType, Time slot = Seconds(1.0));
+
+    bool IsAlwaysOn(void) const { return m_primeA == 0; }
+    Time GetSlot(void) const { return m_slot; }
+    uint32_t GetPrimeA(void) const { return m_primeA; }
+    uint32_t GetPrimeB(void) const { return m_primeB; }
+    // Fraction of slots awake, 1 when always on
+    double GetDutyCycle(void) const;
+
+    bool IsAwakeSlot(int64_t slot) const {
+        return IsAlwaysOn() || slot % m_primeA == 0 || slot % m_primeB == 0;
+    }
+    // First awake slot after slot
+    int64_t GetNextAwakeSlot(int64_t slot) const;
+    // Most slots until two nodes on these schedules, at any whole-slot
+    // offset, are awake together: the smallest product of a prime of one
+    // and a different prime of the other, which two pairs of distinct
+    // primes always have, or the smaller prime facing an always-on node
+    static uint64_t GetDiscoveryBound(const DtnWakeupSchedule& a, const DtnWakeupSchedule& b);
+
+private:
+    Time m_slot;
+    uint32_t m_primeA;
+    uint32_t m_primeB;
+};
+
+/*
+ * Runs one node's wakeup schedule. It raises wake and sleep for the radio
+ * and a slot edge at the start and the end of every awake slot, where the
+ * node must beacon to keep the schedule's overlap guarantee. At the end
+ * of a slot the node stays up while the hold callback says so or a
+ * KeepAwake() window is open, and sleeps once Guard has passed without
+ * either (the guard lets a peer that heard the last beacon answer).
+ * WakeNow() breaks the schedule, for a bundle that cannot wait.
+ * One event is pending at a time; an always-on schedule schedules none.
+ */
+class DtnSleepScheduler {
+public:
+    typedef Callback<void> EventCallback;
+    typedef Callback<bool> HoldCallback;
+
+    DtnSleepScheduler();
+    ~DtnSleepScheduler() { Stop(); }
+
+    void SetWakeCallback(EventCallback callback) { m_wake = callback; }
+    void SetSleepCallback(EventCallback callback) { m_sleep = callback; }
+    void SetSlotEdgeCallback(EventCallback callback) { m_slotEdge = callback; }
+    void SetHoldCallback(HoldCallback callback) { m_hold = callback; }
+
+    // Slot counter zero lies offset before now; draw it at random per node
+    void Start(const DtnWakeupSchedule& schedule, Time offset, Time guard);
+    void Stop(void);
+
+    void WakeNow(void);
+    // Stays up at least duration from now
+    void KeepAwake(Time duration);
+
+    bool IsRunning(void) const { return m_running; }
+    bool IsAwake(void) const { return !m_running || m_awake; }
+    const DtnWakeupSchedule& GetSchedule(void) const { return m_schedule; }
+    // Awake time since Start, up to now
+    Time GetAwakeTime(void) const;
+    Time GetRunningTime(void) const;
+
+private:
+    int64_t SlotAt(Time time) const { return (time - m_origin).GetTimeStep() / m_schedule.GetSlot().GetTimeStep(); }
+    Time SlotStart(int64_t slot) const { return m_origin + m_schedule.GetSlot() * slot; }
+
+    void Wake(void);
+    void SlotEnd(void);
+    void TrySleep(void);
+    void Schedule(Time at, void (DtnSleepScheduler::*handler)(void));
+
+    DtnWakeupSchedule m_schedule;
+    Time m_guard;
+    Time m_origin;
+    Time m_started;
+    Time m_stopped;
+    Time m_awakeSince;
+    Time m_awakeTotal;  // Closed awake periods
+    Time m_keepAwakeUntil;
+    bool m_running;
+    bool m_awake;
+    EventId m_event;
+    EventCallback m_wake;
+    EventCallback m_sleep;
+    EventCallback m_slotEdge;
+    HoldCallback m_hold;
+};
+
+} // namespace ns3
+
+#endif // DTN_SLEEP_SCHEDULER_H
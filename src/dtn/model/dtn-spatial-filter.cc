@@ -0,0 +1,155 @@
+/*
+ * DTN Spatial Filter
+ * Uniform-grid transmit filter that keeps far-away receivers off the wireless channel
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "dtn-spatial-filter.h"
+#include "dtn-profiler.h"
+#include <cmath>
+#include <cstdlib>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("DtnSpatialFilter");
+
+NS_OBJECT_ENSURE_REGISTERED(DtnSpatialFilter);
+
+TypeId DtnSpatialFilter::GetTypeId(void) {
+    static TypeId tid = TypeId("ns3::DtnSpatialFilter")
+        .SetParent<SpectrumTransmitFilter>()
+        .SetGroupName("Dtn")
+        .AddConstructor<DtnSpatialFilter>()
+        .AddAttribute("MaxRange", "Distance beyond which receivers are dropped (m); also the grid cell size",
+                      DoubleValue(250.0),
+                      MakeDoubleAccessor(&DtnSpatialFilter::m_maxRange),
+                      MakeDoubleChecker<double>(1.0))
+        .AddAttribute("RefreshInterval",
+                      "Period of the full re-binning; course changes re-bin their node at once",
+                      TimeValue(Seconds(1.0)),
+                      MakeTimeAccessor(&DtnSpatialFilter::m_refreshInterval),
+                      MakeTimeChecker(MilliSeconds(1)));
+    return tid;
+}
+
+DtnSpatialFilter::DtnSpatialFilter()
+    : m_maxRange(250.0),
+      m_refreshInterval(Seconds(1.0)),
+      m_maxSpeed(0.0),
+      m_reach(1),
+      m_filtered(0),
+      m_passed(0) {
+}
+
+DtnSpatialFilter::~DtnSpatialFilter() {
+}
+
+void DtnSpatialFilter::DoDispose(void) {
+    NS_LOG_INFO("Spatial filter dropped " << m_filtered << " of " << m_filtered + m_passed
+                << " receiver evaluations");
+    m_refreshEvent.Cancel();
+    m_nodes = NodeContainer();
+    SpectrumTransmitFilter::DoDispose();
+}
+
+void DtnSpatialFilter::Add(NodeContainer nodes) {
+    m_nodes.Add(nodes);
+    if (!m_refreshEvent.IsPending()) {
+        m_refreshEvent = Simulator::Schedule(Seconds(0.0), &DtnSpatialFilter::Refresh, this);
+    }
+}
+
+void DtnSpatialFilter::Refresh(void) {
+    m_maxSpeed = 0.0;
+    for (NodeContainer::Iterator i = m_nodes.Begin(); i != m_nodes.End(); ++i) {
+        uint32_t nodeId = (*i)->GetId();
+        Ptr<MobilityModel> mobility = (*i)->GetObject<MobilityModel>();
+        if (!mobility) {
+            continue;
+        }
+        if (nodeId >= m_connected.size()) {
+            m_connected.resize(nodeId + 1, false);
+        }
+        if (!m_connected[nodeId]) {
+            mobility->TraceConnectWithoutContext("CourseChange",
+                                                 MakeCallback(&DtnSpatialFilter::CourseChanged, this));
+            m_connected[nodeId] = true;
+        }
+        Place(nodeId, mobility);
+    }
+    UpdateReach();
+    m_refreshEvent = Simulator::Schedule(m_refreshInterval, &DtnSpatialFilter::Refresh, this);
+}
+
+void DtnSpatialFilter::CourseChanged(Ptr<const MobilityModel> mobility) {
+    Ptr<Node> node = mobility->GetObject<Node>();
+    if (node) {
+        Place(node->GetId(), mobility);
+        UpdateReach();
+    }
+}
+
+void DtnSpatialFilter::Place(uint32_t nodeId, Ptr<const MobilityModel> mobility) {
+    if (nodeId >= m_cells.size()) {
+        m_cells.resize(nodeId + 1);
+    }
+    Vector position = mobility->GetPosition();
+    GridCell& cell = m_cells[nodeId];
+    cell.x = GetCell(position.x, m_maxRange);
+    cell.y = GetCell(position.y, m_maxRange);
+    cell.indexed = true;
+
+    Vector velocity = mobility->GetVelocity();
+    m_maxSpeed = std::max(m_maxSpeed, std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y));
+}
+
+void DtnSpatialFilter::UpdateReach(void) {
+    m_reach = GetReach(m_maxRange, m_maxSpeed, m_refreshInterval);
+}
+
+int32_t DtnSpatialFilter::GetCell(double coordinate, double maxRange) {
+    return static_cast<int32_t>(std::floor(coordinate / maxRange));
+}
+
+int32_t DtnSpatialFilter::GetReach(double maxRange, double maxSpeed, Time refreshInterval) {
+    // Both ends may have moved maxSpeed * RefreshInterval since they were binned
+    double drift = 2.0 * maxSpeed * refreshInterval.GetSeconds();
+    return static_cast<int32_t>(std::ceil((maxRange + drift) / maxRange));
+}
+
+const DtnSpatialFilter::GridCell* DtnSpatialFilter::Find(Ptr<const SpectrumPhy> phy) const {
+    Ptr<NetDevice> device = phy ? phy->GetDevice() : Ptr<NetDevice>(0);
+    if (!device || !device->GetNode()) {
+        return 0;
+    }
+    uint32_t nodeId = device->GetNode()->GetId();
+    if (nodeId >= m_cells.size() || !m_cells[nodeId].indexed) {
+        return 0;
+    }
+    return &m_cells[nodeId];
+}
+
+bool DtnSpatialFilter::DoFilter(Ptr<const SpectrumSignalParameters> params, Ptr<const SpectrumPhy> receiverPhy) {
+    DTN_PROFILE_SCOPE(DTN_PROFILE_PHY_FILTER);
+    const GridCell* sender = Find(params->txPhy);
+    const GridCell* receiver = Find(receiverPhy);
+    // Keep anything not indexed (yet): no position, or added after the last refresh
+    if (!sender || !receiver) {
+        ++m_passed;
+        return false;
+    }
+    if (std::abs(sender->x - receiver->x) > m_reach || std::abs(sender->y - receiver->y) > m_reach) {
+        ++m_filtered;
+        return true;
+    }
+    ++m_passed;
+    return false;
+}
+
+int64_t DtnSpatialFilter::DoAssignStreams(int64_t stream) {
+    return 0;
+}
+
+} // namespace ns3
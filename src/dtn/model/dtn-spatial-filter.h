@@ -0,0 +1,90 @@
+/*
+ * DTN Spatial Filter
+ * Uniform-grid transmit filter that keeps far-away receivers off the wireless channel
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#ifndef DTN_SPATIAL_FILTER_H
+#define DTN_SPATIAL_FILTER_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/spectrum-module.h"
+#include <vector>
+
+namespace ns3 {
+
+/*
+ * Spectrum transmit filter that drops receivers outside MaxRange of the
+ * sender before the channel evaluates propagation loss, copies the signal
+ * or schedules a receive event. Node positions are binned into a uniform
+ * grid of MaxRange-sized cells, re-binned on every mobility course change
+ * and every RefreshInterval; a receiver is kept while its cell is within
+ * reach of the sender's, the reach widening by the distance the fastest
+ * node can have drifted since it was binned. The test is conservative:
+ * it never drops a receiver within MaxRange, so the channel still needs
+ * its own range cut-off for the exact edge.
+ */
+class DtnSpatialFilter : public SpectrumTransmitFilter {
+public:
+    static TypeId GetTypeId(void);
+    DtnSpatialFilter();
+    virtual ~DtnSpatialFilter();
+
+    // Indexes the nodes from the first refresh on (simulation start), so
+    // their mobility may be installed after the channel
+    void Add(NodeContainer nodes);
+
+    uint64_t GetFiltered(void) const { return m_filtered; }
+    uint64_t GetPassed(void) const { return m_passed; }
+
+    // Grid cell holding coordinate, per axis
+    static int32_t GetCell(double coordinate, double maxRange);
+    // Cells either way a receiver may be binned and still be within
+    // maxRange, when every node may have moved maxSpeed * refreshInterval
+    static int32_t GetReach(double maxRange, double maxSpeed, Time refreshInterval);
+
+protected:
+    virtual void DoDispose(void);
+
+private:
+    struct GridCell {
+        GridCell()
+            : x(0),
+              y(0),
+              indexed(false) {
+        }
+
+        int32_t x;
+        int32_t y;
+        bool indexed;
+    };
+
+    virtual bool DoFilter(Ptr<const SpectrumSignalParameters> params, Ptr<const SpectrumPhy> receiverPhy);
+    virtual int64_t DoAssignStreams(int64_t stream);
+
+    void Refresh(void);
+    void CourseChanged(Ptr<const MobilityModel> mobility);
+    void Place(uint32_t nodeId, Ptr<const MobilityModel> mobility);
+    void UpdateReach(void);
+    const GridCell* Find(Ptr<const SpectrumPhy> phy) const;
+
+    double m_maxRange;
+    Time m_refreshInterval;
+    NodeContainer m_nodes;
+    std::vector<GridCell> m_cells;  // By node id
+    std::vector<bool> m_connected;  // CourseChange traced, by node id
+    double m_maxSpeed;  // Fastest node since the last refresh (m/s)
+    int32_t m_reach;  // Cells either way a receiver may be and still be kept
+    EventId m_refreshEvent;
+
+    uint64_t m_filtered;
+    uint64_t m_passed;
+};
+
+} // namespace ns3
+
+#endif // DTN_SPATIAL_FILTER_H
@@ -0,0 +1,441 @@
+/*
+ * DTN Statistics Collector
+ * Measured per-node counters, delivery latency quantiles and fixed-interval time series
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "dtn-stats-collector.h"
+#include "dtn-profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("DtnStatsCollector");
+
+NS_OBJECT_ENSURE_REGISTERED(DtnStatsCollector);
+
+// Bucket 0 holds [0, 1 ms); bucket k > 0 holds [1 ms * 1.05^(k-1), 1 ms * 1.05^k)
+static const double LATENCY_FLOOR = 1e-3;
+static const double LATENCY_GROWTH = 1.05;
+static const uint32_t LATENCY_BUCKETS = 426;  // Up to 10^6 s; the last bucket takes the rest
+
+static const uint32_t PRIORITY_CLASSES = 4;  // 0=Emergency .. 3=Low; higher values count as Low
+static const uint32_t MAX_HOPS = 255;  // The header's hop count saturates here
+static const uint32_t NODE_TYPES = IOT_SENSOR + 1;  // Other values count as the last type
+
+DtnLatencyHistogram::DtnLatencyHistogram()
+    : m_buckets(LATENCY_BUCKETS, 0) {
+    Reset();
+}
+
+void DtnLatencyHistogram::Reset(void) {
+    std::fill(m_buckets.begin(), m_buckets.end(), 0);
+    m_count = 0;
+    m_sum = 0.0;
+    m_min = std::numeric_limits<double>::max();
+    m_max = 0.0;
+}
+
+uint32_t DtnLatencyHistogram::BucketOf(double seconds) {
+    if (seconds < LATENCY_FLOOR) {
+        return 0;
+    }
+    double bucket = std::floor(std::log(seconds / LATENCY_FLOOR) / std::log(LATENCY_GROWTH)) + 1;
+    return std::min<double>(bucket, LATENCY_BUCKETS - 1);
+}
+
+double DtnLatencyHistogram::LowerEdge(uint32_t bucket) {
+    return bucket == 0 ? 0.0 : LATENCY_FLOOR * std::pow(LATENCY_GROWTH, bucket - 1);
+}
+
+void DtnLatencyHistogram::Add(double seconds) {
+    m_buckets[BucketOf(seconds)]++;
+    m_count++;
+    m_sum += seconds;
+    m_min = std::min(m_min, seconds);
+    m_max = std::max(m_max, seconds);
+}
+
+double DtnLatencyHistogram::GetQuantile(double q) const {
+    if (m_count == 0) {
+        return 0.0;
+    }
+    // Geometric middle of the bucket holding the q-th sample
+    uint64_t rank = std::max<uint64_t>(1, std::ceil(q * m_count));
+    uint64_t seen = 0;
+    for (uint32_t bucket = 0; bucket < LATENCY_BUCKETS; ++bucket) {
+        seen += m_buckets[bucket];
+        if (seen >= rank) {
+            double estimate = bucket == 0 ? LATENCY_FLOOR / 2
+                                          : LowerEdge(bucket) * std::sqrt(LATENCY_GROWTH);
+            return std::min(std::max(estimate, m_min), m_max);
+        }
+    }
+    return m_max;
+}
+
+void DtnLatencyHistogram::Write(std::ostream& os) const {
+    os << "LowerBound(s),UpperBound(s),Count\n";
+    for (uint32_t bucket = 0; bucket < LATENCY_BUCKETS; ++bucket) {
+        if (m_buckets[bucket]) {
+            os << LowerEdge(bucket) << "," << LowerEdge(bucket + 1) << "," << m_buckets[bucket] << "\n";
+        }
+    }
+}
+
+TypeId DtnStatsCollector::GetTypeId(void) {
+    static TypeId tid = TypeId("ns3::DtnStatsCollector")
+        .SetParent<Object>()
+        .SetGroupName("Dtn")
+        .AddConstructor<DtnStatsCollector>()
+        .AddAttribute("Interval", "Period of the time series samples",
+                      TimeValue(Seconds(30.0)),
+                      MakeTimeAccessor(&DtnStatsCollector::m_interval),
+                      MakeTimeChecker(MilliSeconds(1)));
+    return tid;
+}
+
+DtnStatsCollector::DtnStatsCollector()
+    : m_interval(Seconds(30.0)),
+      m_depletedNodes(0),
+      m_firstDepletion(Seconds(-1.0)),
+      m_priorityLatency(PRIORITY_CLASSES),
+      m_typeLatency(NODE_TYPES),
+      m_priorityGenerated(PRIORITY_CLASSES, 0),
+      m_hopCounts(MAX_HOPS + 1, 0),
+      m_carriedOver(0),
+      m_intervalBytes(0) {
+}
+
+DtnStatsCollector::~DtnStatsCollector() {
+}
+
+void DtnStatsCollector::DoDispose(void) {
+    m_sampleEvent.Cancel();
+    m_apps.clear();
+    m_appIndex.clear();
+    Object::DoDispose();
+}
+
+void DtnStatsCollector::Install(ApplicationContainer apps) {
+    for (ApplicationContainer::Iterator i = apps.Begin(); i != apps.End(); ++i) {
+        Ptr<DtnApplication> app = DynamicCast<DtnApplication>(*i);
+        if (!app) {
+            continue;
+        }
+        app->TraceConnectWithoutContext("BundleCreated",
+                                        MakeCallback(&DtnStatsCollector::BundleCreated, this));
+        app->TraceConnectWithoutContext("BundleDelivered",
+                                        MakeCallback(&DtnStatsCollector::BundleDelivered, this));
+        m_appIndex[app->GetNodeId()] = m_apps.size();
+        m_apps.push_back(app);
+        m_bufferSums.push_back(0);
+        m_depleted.push_back(false);
+    }
+    m_lastTotals = GetTotals();
+    m_lastSample = Simulator::Now();
+    m_installTime = Simulator::Now();
+    m_sampleEvent.Cancel();
+    m_sampleEvent = Simulator::Schedule(m_interval, &DtnStatsCollector::Sample, this);
+}
+
+void DtnStatsCollector::BundleCreated(const DtnBundle& bundle) {
+    m_priorityGenerated[std::min(bundle.priority, PRIORITY_CLASSES - 1)]++;
+}
+
+void DtnStatsCollector::BundleDelivered(const DtnBundle& bundle) {
+    // Its BundleCreated went by before we were watching
+    if (bundle.creationTime < m_installTime) {
+        m_carriedOver++;
+        return;
+    }
+    double latency = (Simulator::Now() - bundle.creationTime).GetSeconds();
+    m_latency.Add(latency);
+    m_intervalLatency.Add(latency);
+    m_priorityLatency[std::min(bundle.priority, PRIORITY_CLASSES - 1)].Add(latency);
+    m_hopCounts[std::min(bundle.hopCount, MAX_HOPS)]++;
+    auto source = m_appIndex.find(bundle.sourceNode);
+    if (source != m_appIndex.end()) {
+        m_typeLatency[std::min(m_apps[source->second]->GetNodeType(), NODE_TYPES - 1)].Add(latency);
+    }
+    if (bundle.payload) {
+        m_intervalBytes += bundle.payload->GetSize();
+    }
+}
+
+DtnApplicationStats DtnStatsCollector::GetTotals(void) const {
+    DtnApplicationStats totals;
+    for (const Ptr<DtnApplication>& app : m_apps) {
+        const DtnApplicationStats& stats = app->GetStats();
+        totals.bundlesCreated += stats.bundlesCreated;
+        totals.bundlesReceived += stats.bundlesReceived;
+        totals.bundlesDelivered += stats.bundlesDelivered;
+        totals.bundlesForwarded += stats.bundlesForwarded;
+        totals.bundlesDropped += stats.bundlesDropped;
+        totals.bundlesEvicted += stats.bundlesEvicted;
+        totals.framesSent += stats.framesSent;
+        totals.fragmentsSent += stats.fragmentsSent;
+        totals.custodyReleased += stats.custodyReleased;
+        totals.custodyAcksSent += stats.custodyAcksSent;
+        totals.bundlesPurged += stats.bundlesPurged;
+        totals.duplicatesDropped += stats.duplicatesDropped;
+        totals.contacts += stats.contacts;
+        totals.forwardsSuppressed += stats.forwardsSuppressed;
+        totals.sleepPeriods += stats.sleepPeriods;
+        totals.emergencyWakeups += stats.emergencyWakeups;
+        totals.peakBuffered = std::max(totals.peakBuffered, stats.peakBuffered);
+    }
+    return totals;
+}
+
+uint64_t DtnStatsCollector::GetGenerated(void) const {
+    uint64_t generated = 0;
+    for (uint64_t count : m_priorityGenerated) {
+        generated += count;
+    }
+    return generated;
+}
+
+double DtnStatsCollector::GetDeliveryRatio(void) const {
+    uint64_t generated = GetGenerated();
+    return generated ? 100.0 * m_latency.GetCount() / generated : 0.0;
+}
+
+double DtnStatsCollector::GetOverheadRatio(void) const {
+    uint64_t delivered = m_latency.GetCount();
+    return delivered ? (double)GetTotals().bundlesForwarded / delivered : 0.0;
+}
+
+void DtnStatsCollector::Sample(void) {
+    TakeSample();
+    m_sampleEvent = Simulator::Schedule(m_interval, &DtnStatsCollector::Sample, this);
+}
+
+void DtnStatsCollector::TakeSample(void) {
+    DTN_PROFILE_SCOPE(DTN_PROFILE_STATS);
+    DtnApplicationStats totals = GetTotals();
+
+    DtnTimeSample sample;
+    sample.time = Simulator::Now().GetSeconds();
+    sample.span = (Simulator::Now() - m_lastSample).GetSeconds();
+    sample.created = totals.bundlesCreated - m_lastTotals.bundlesCreated;
+    sample.received = totals.bundlesReceived - m_lastTotals.bundlesReceived;
+    sample.delivered = totals.bundlesDelivered - m_lastTotals.bundlesDelivered;
+    sample.forwarded = totals.bundlesForwarded - m_lastTotals.bundlesForwarded;
+    sample.dropped = totals.bundlesDropped - m_lastTotals.bundlesDropped;
+    sample.deliveredBytes = m_intervalBytes;
+    sample.meanLatency = m_intervalLatency.GetMean();
+    sample.p95Latency = m_intervalLatency.GetQuantile(0.95);
+    sample.buffered = 0;
+    sample.maxBufferUtilization = 0.0;
+    sample.activeNodes = 0;
+    double batterySum = 0.0;
+    uint32_t powered = 0;
+    for (uint32_t i = 0; i < m_apps.size(); ++i) {
+        uint32_t buffered = m_apps[i]->GetBufferedBundles();
+        sample.buffered += buffered;
+        sample.maxBufferUtilization = std::max(sample.maxBufferUtilization,
+                                               100.0 * buffered / m_apps[i]->GetBufferCapacity());
+        m_bufferSums[i] += buffered;
+        if (m_apps[i]->IsRunning()) {
+            sample.activeNodes++;
+        }
+        Ptr<energy::EnergySource> source = m_apps[i]->GetEnergySource();
+        if (!source) {
+            continue;
+        }
+        batterySum += m_apps[i]->GetBatteryLevel();
+        powered++;
+        if (!m_depleted[i] && source->GetRemainingEnergy() <= 0.0) {
+            m_depleted[i] = true;
+            if (m_depletedNodes++ == 0) {
+                m_firstDepletion = Simulator::Now();
+            }
+        }
+    }
+    sample.meanBattery = powered ? 100.0 * batterySum / powered : 100.0;
+    sample.depletedNodes = m_depletedNodes;
+    m_samples.push_back(sample);
+
+    m_lastTotals = totals;
+    m_lastSample = Simulator::Now();
+    m_intervalLatency.Reset();
+    m_intervalBytes = 0;
+}
+
+void DtnStatsCollector::WriteNodePerformance(std::ostream& os) const {
+    os << "NodeID,NodeType,MessagesGenerated,MessagesForwarded,MessagesDelivered,BufferUtilization(%),"
+       << "MessagesReceived,MessagesDropped,Duplicates,Contacts,BufferCapacity,PeakBuffered,MeanBuffered,"
+       << "MessagesEvicted\n";
+    for (uint32_t i = 0; i < m_apps.size(); ++i) {
+        const DtnApplicationStats& stats = m_apps[i]->GetStats();
+        uint32_t capacity = m_apps[i]->GetBufferCapacity();
+        double meanBuffered = m_samples.empty() ? 0.0 : (double)m_bufferSums[i] / m_samples.size();
+        os << m_apps[i]->GetNodeId() << "," << m_apps[i]->GetNodeType() << ","
+           << stats.bundlesCreated << "," << stats.bundlesForwarded << "," << stats.bundlesDelivered << ","
+           << 100.0 * stats.peakBuffered / capacity << ","
+           << stats.bundlesReceived << "," << stats.bundlesDropped << "," << stats.duplicatesDropped << ","
+           << stats.contacts << "," << capacity << "," << stats.peakBuffered << "," << meanBuffered << ","
+           << stats.bundlesEvicted << "\n";
+    }
+}
+
+void DtnStatsCollector::WriteLatency(std::ostream& os) const {
+    os << "DELIVERY_LATENCY\n";
+    os << "Deliveries," << m_latency.GetCount() << "\n";
+    os << "Mean(s)," << m_latency.GetMean() << "\n";
+    os << "Min(s)," << m_latency.GetMin() << "\n";
+    os << "P50(s)," << m_latency.GetQuantile(0.50) << "\n";
+    os << "P90(s)," << m_latency.GetQuantile(0.90) << "\n";
+    os << "P95(s)," << m_latency.GetQuantile(0.95) << "\n";
+    os << "P99(s)," << m_latency.GetQuantile(0.99) << "\n";
+    os << "Max(s)," << m_latency.GetMax() << "\n";
+
+    os << "\nLATENCY_HISTOGRAM\n";
+    m_latency.Write(os);
+}
+
+void DtnStatsCollector::WriteEndToEnd(std::ostream& os) const {
+    uint64_t hopSum = 0;
+    for (uint32_t hops = 0; hops <= MAX_HOPS; ++hops) {
+        hopSum += hops * m_hopCounts[hops];
+    }
+
+    os << "END_TO_END\n";
+    os << "BundlesGenerated," << GetGenerated() << "\n";
+    os << "BundlesDelivered," << m_latency.GetCount() << "\n";
+    os << "DeliveryRatio(%)," << GetDeliveryRatio() << "\n";
+    os << "CarriedOverDeliveries," << m_carriedOver << "\n";
+    os << "Transmissions," << GetTotals().bundlesForwarded << "\n";
+    os << "OverheadRatio," << GetOverheadRatio() << "\n";
+    os << "MeanHops," << (m_latency.GetCount() ? (double)hopSum / m_latency.GetCount() : 0.0) << "\n";
+
+    os << "\nPRIORITY_LATENCY\n";
+    os << "Priority,Generated,Delivered,DeliveryRatio(%),Mean(s),P50(s),P95(s),P99(s),Max(s)\n";
+    for (uint32_t priority = 0; priority < PRIORITY_CLASSES; ++priority) {
+        const DtnLatencyHistogram& latency = m_priorityLatency[priority];
+        uint64_t generated = m_priorityGenerated[priority];
+        os << priority << "," << generated << "," << latency.GetCount() << ","
+           << (generated ? 100.0 * latency.GetCount() / generated : 0.0) << ","
+           << latency.GetMean() << "," << latency.GetQuantile(0.50) << ","
+           << latency.GetQuantile(0.95) << "," << latency.GetQuantile(0.99) << ","
+           << latency.GetMax() << "\n";
+    }
+
+    os << "\nHOP_DISTRIBUTION\n";
+    os << "Hops,Deliveries\n";
+    for (uint32_t hops = 0; hops <= MAX_HOPS; ++hops) {
+        if (m_hopCounts[hops]) {
+            os << hops << "," << m_hopCounts[hops] << "\n";
+        }
+    }
+}
+
+void DtnStatsCollector::WriteTimeSeries(std::ostream& os) {
+    if (Simulator::Now() > m_lastSample) {
+        TakeSample();
+    }
+
+    os << "Time(s),Delay(ms),Throughput(Kbps),DropRate(%),ActiveNodes,"
+       << "Created,Received,Delivered,Forwarded,Dropped,P95Delay(ms),BufferedBundles,MaxBufferUtilization(%),"
+       << "MeanBattery(%),DepletedNodes\n";
+    for (const DtnTimeSample& sample : m_samples) {
+        uint32_t offered = sample.created + sample.received + sample.dropped;
+        os << sample.time << ","
+           << sample.meanLatency * 1000.0 << ","
+           << (sample.span > 0.0 ? sample.deliveredBytes * 8.0 / sample.span / 1000.0 : 0.0) << ","
+           << (offered ? 100.0 * sample.dropped / offered : 0.0) << ","
+           << sample.activeNodes << ","
+           << sample.created << "," << sample.received << "," << sample.delivered << ","
+           << sample.forwarded << "," << sample.dropped << ","
+           << sample.p95Latency * 1000.0 << ","
+           << sample.buffered << "," << sample.maxBufferUtilization << ","
+           << sample.meanBattery << "," << sample.depletedNodes << "\n";
+    }
+}
+
+void DtnStatsCollector::WriteEnergy(std::ostream& os) const {
+    uint32_t powered = 0;
+    double consumed = 0.0;
+    double batterySum = 0.0;
+    for (const Ptr<DtnApplication>& app : m_apps) {
+        if (app->GetEnergySource()) {
+            powered++;
+            consumed += app->GetEnergyConsumed();
+            batterySum += app->GetBatteryLevel();
+        }
+    }
+
+    os << "ENERGY\n";
+    os << "NodesWithEnergySource," << powered << "\n";
+    os << "NodesDepleted," << m_depletedNodes << "\n";
+    // Network lifetime: -1 when every node outlived the run
+    os << "FirstNodeDepleted(s)," << m_firstDepletion.GetSeconds() << "\n";
+    os << "MeanBatteryLeft(%)," << (powered ? 100.0 * batterySum / powered : 100.0) << "\n";
+    os << "EnergyConsumed(J)," << consumed << "\n";
+    os << "EnergyPerDelivery(J)," << (m_latency.GetCount() ? consumed / m_latency.GetCount() : 0.0) << "\n";
+    os << "ForwardsSuppressed," << GetTotals().forwardsSuppressed << "\n";
+}
+
+void DtnStatsCollector::WriteDutyCycle(std::ostream& os) const {
+    struct TypeTotals {
+        uint32_t nodes = 0;
+        double dutyCycle = 0.0;
+        double awake = 0.0;
+        uint32_t sleepPeriods = 0;
+        uint32_t emergencyWakeups = 0;
+        uint32_t powered = 0;
+        double battery = 0.0;
+        uint32_t draining = 0;
+        double lifetime = 0.0;
+        uint32_t originated = 0;
+    };
+    std::vector<TypeTotals> types(NODE_TYPES);
+    double elapsed = Simulator::Now().GetSeconds();
+    for (const Ptr<DtnApplication>& app : m_apps) {
+        TypeTotals& type = types[std::min(app->GetNodeType(), NODE_TYPES - 1)];
+        const DtnApplicationStats& stats = app->GetStats();
+        type.nodes++;
+        type.dutyCycle += app->GetWakeupSchedule().GetDutyCycle();
+        type.awake += app->GetAwakeFraction();
+        type.sleepPeriods += stats.sleepPeriods;
+        type.emergencyWakeups += stats.emergencyWakeups;
+        type.originated += stats.bundlesCreated;
+        Ptr<energy::EnergySource> source = app->GetEnergySource();
+        if (source) {
+            type.powered++;
+            type.battery += app->GetBatteryLevel();
+            // Linear projection of the drain so far
+            double consumed = app->GetEnergyConsumed();
+            if (consumed > 0.0) {
+                type.draining++;
+                type.lifetime += elapsed * source->GetInitialEnergy() / consumed / 3600.0;
+            }
+        }
+    }
+
+    os << "DUTY_CYCLE\n";
+    os << "NodeType,Nodes,DutyCycle(%),Awake(%),SleepPeriods,EmergencyWakeups,MeanBatteryLeft(%),"
+       << "ProjectedLifetime(h),Originated,Delivered,MeanLatency(s),P95Latency(s)\n";
+    for (uint32_t t = 0; t < NODE_TYPES; ++t) {
+        const TypeTotals& type = types[t];
+        if (type.nodes == 0) {
+            continue;
+        }
+        const DtnLatencyHistogram& latency = m_typeLatency[t];
+        // -1: no energy source, or nothing drawn yet
+        os << t << "," << type.nodes << ","
+           << 100.0 * type.dutyCycle / type.nodes << "," << 100.0 * type.awake / type.nodes << ","
+           << type.sleepPeriods << "," << type.emergencyWakeups << ","
+           << (type.powered ? 100.0 * type.battery / type.powered : -1.0) << ","
+           << (type.draining ? type.lifetime / type.draining : -1.0) << ","
+           << type.originated << "," << latency.GetCount() << ","
+           << latency.GetMean() << "," << latency.GetQuantile(0.95) << "\n";
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,163 @@
+/*
+ * DTN Statistics Collector
+ * Measured per-node counters, delivery latency quantiles and fixed-interval time series
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#ifndef DTN_STATS_COLLECTOR_H
+#define DTN_STATS_COLLECTOR_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "dtn-application.h"
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+/*
+ * Log-bucketed latency histogram: 5% wide buckets from 1 ms to 10^6 s,
+ * so memory is fixed whatever the number of samples and quantiles are
+ * within 2.5% of the exact value (clamped to the observed min and max).
+ */
+class DtnLatencyHistogram {
+public:
+    DtnLatencyHistogram();
+
+    void Add(double seconds);
+    void Reset(void);
+
+    uint64_t GetCount(void) const { return m_count; }
+    double GetMean(void) const { return m_count ? m_sum / m_count : 0.0; }
+    double GetMin(void) const { return m_count ? m_min : 0.0; }
+    double GetMax(void) const { return m_max; }
+    double GetQuantile(double q) const;
+
+    // One LowerBound(s),UpperBound(s),Count row per non-empty bucket
+    void Write(std::ostream& os) const;
+
+private:
+    static uint32_t BucketOf(double seconds);
+    static double LowerEdge(uint32_t bucket);
+
+    std::vector<uint64_t> m_buckets;
+    uint64_t m_count;
+    double m_sum;
+    double m_min;
+    double m_max;
+};
+
+// One row of the time series; counts are per interval, buffer fields at the sample time
+struct DtnTimeSample {
+    double time;
+    double span;  // s covered, up to time
+    uint32_t created;
+    uint32_t received;
+    uint32_t delivered;
+    uint32_t forwarded;
+    uint32_t dropped;
+    uint64_t deliveredBytes;
+    double meanLatency;  // s, deliveries of the interval
+    double p95Latency;
+    uint32_t buffered;  // Bundles held, all nodes
+    double maxBufferUtilization;  // %, fullest node
+    uint32_t activeNodes;
+    double meanBattery;  // %, remaining energy of the nodes with an energy source
+    uint32_t depletedNodes;  // So far
+};
+
+/*
+ * Watches a set of DTN applications while the simulation runs: every
+ * delivery (BundleDelivered trace) goes into the latency histograms, and
+ * every Interval the counters of all applications are sampled into the
+ * time series and each node's buffer occupancy is accumulated. Memory is
+ * one histogram per priority class, one counter set per node and one row
+ * per interval.
+ *
+ * End-to-end figures count bundles, not packets: a bundle is generated
+ * once at its source (BundleCreated) and delivered at most once (its
+ * destination suppresses later copies), latency runs from the creation
+ * time the bundle header carries across every hop, and the overhead
+ * ratio is bundle transmissions per delivered bundle. Across MPI ranks
+ * each rank only sees its own sources and destinations. Bundles created
+ * before Install() (carried over by a warm start from a DtnSnapshot) were
+ * never counted as generated, so their deliveries are only counted apart
+ * and stay out of the ratios and latencies.
+ */
+class DtnStatsCollector : public Object {
+public:
+    static TypeId GetTypeId(void);
+    DtnStatsCollector();
+    virtual ~DtnStatsCollector();
+
+    // Starts watching; sampling begins at the current time
+    void Install(ApplicationContainer apps);
+
+    const DtnLatencyHistogram& GetLatency(void) const { return m_latency; }
+    DtnApplicationStats GetTotals(void) const;
+
+    // Bundles generated by the watched applications, including those their buffer refused
+    uint64_t GetGenerated(void) const;
+    // Delivered / generated, %
+    double GetDeliveryRatio(void) const;
+    // Deliveries of bundles created before Install()
+    uint64_t GetCarriedOverDeliveries(void) const { return m_carriedOver; }
+    // Bundle transmissions per delivered bundle; 0 before the first delivery
+    double GetOverheadRatio(void) const;
+
+    // NODE_PERFORMANCE section
+    void WriteNodePerformance(std::ostream& os) const;
+    // DELIVERY_LATENCY and LATENCY_HISTOGRAM sections
+    void WriteLatency(std::ostream& os) const;
+    // END_TO_END, PRIORITY_LATENCY and HOP_DISTRIBUTION sections
+    void WriteEndToEnd(std::ostream& os) const;
+    // TIME_SERIES_DATA section, closing the last partial interval first
+    void WriteTimeSeries(std::ostream& os);
+    // ENERGY section: network lifetime and what the batteries paid for
+    void WriteEnergy(std::ostream& os) const;
+    // DUTY_CYCLE section: per node type, radio on-time and battery against
+    // the latency of the bundles those nodes originate
+    void WriteDutyCycle(std::ostream& os) const;
+
+    // When the first watched node ran out of energy, as of the last sample;
+    // negative while none has
+    Time GetFirstDepletion(void) const { return m_firstDepletion; }
+    uint32_t GetDepletedNodes(void) const { return m_depletedNodes; }
+
+protected:
+    virtual void DoDispose(void);
+
+private:
+    void BundleCreated(const DtnBundle& bundle);
+    void BundleDelivered(const DtnBundle& bundle);
+    void Sample(void);
+    void TakeSample(void);
+
+    Time m_interval;
+    std::vector<Ptr<DtnApplication>> m_apps;
+    std::vector<uint64_t> m_bufferSums;  // Per app, summed over samples
+    std::vector<bool> m_depleted;  // Per app, seen with its energy source empty
+    uint32_t m_depletedNodes;
+    Time m_firstDepletion;
+    DtnLatencyHistogram m_latency;
+    DtnLatencyHistogram m_intervalLatency;
+    std::vector<DtnLatencyHistogram> m_priorityLatency;
+    std::vector<DtnLatencyHistogram> m_typeLatency;  // By the source's NodeType
+    std::unordered_map<uint32_t, uint32_t> m_appIndex;  // By node id
+    std::vector<uint64_t> m_priorityGenerated;
+    std::vector<uint64_t> m_hopCounts;  // Deliveries by hop count
+    Time m_installTime;
+    uint64_t m_carriedOver;
+    uint64_t m_intervalBytes;
+    DtnApplicationStats m_lastTotals;
+    Time m_lastSample;
+    std::vector<DtnTimeSample> m_samples;
+    EventId m_sampleEvent;
+};
+
+} // namespace ns3
+
+#endif // DTN_STATS_COLLECTOR_H
@@ -0,0 +1,198 @@
+/*
+ * DTN Summary Vector
+ * Anti-entropy digest serialisation
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "dtn-summary-vector-header.h"
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED(DtnSummaryVectorHeader);
+
+TypeId DtnSummaryVectorHeader::GetTypeId(void) {
+    static TypeId tid = TypeId("ns3::DtnSummaryVectorHeader")
+        .SetParent<Header>()
+        .SetGroupName("Dtn")
+        .AddConstructor<DtnSummaryVectorHeader>();
+    return tid;
+}
+
+DtnSummaryVectorHeader::DtnSummaryVectorHeader()
+    : m_senderNode(0),
+      m_part(0),
+      m_partCount(1),
+      m_modelSamples(0) {
+}
+
+DtnSummaryVectorHeader::~DtnSummaryVectorHeader() {
+}
+
+void DtnSummaryVectorHeader::SetBundleKeys(std::vector<uint64_t> keys) {
+    std::sort(keys.begin(), keys.end());
+    m_keys.swap(keys);
+}
+
+void DtnSummaryVectorHeader::SetDeliveredKeys(std::vector<uint64_t> keys) {
+    m_deliveredKeys.swap(keys);
+}
+
+void DtnSummaryVectorHeader::SetModel(const std::vector<double>& weights, uint32_t samples) {
+    m_modelWeights.assign(weights.begin(), weights.begin() + std::min<size_t>(weights.size(), 0xFF));
+    m_modelSamples = samples;
+}
+
+std::vector<DtnSummaryVectorHeader> DtnSummaryVectorHeader::Split(uint32_t maxSize) const {
+    // Entries are at least 6 bytes, so no part can hold more than a 16-bit count
+    NS_ASSERT(maxSize <= 0xFFFF);
+    std::vector<DtnSummaryVectorHeader> parts(1);
+    parts[0].m_senderNode = m_senderNode;
+    parts[0].m_modelWeights = m_modelWeights;
+    parts[0].m_modelSamples = m_modelSamples;
+    uint32_t size = parts[0].GetSerializedSize();
+    auto room = [&](uint32_t bytes) -> DtnSummaryVectorHeader& {
+        if (size + bytes > maxSize && size > GetMinimumSize()) {
+            parts.push_back(DtnSummaryVectorHeader());
+            parts.back().m_senderNode = m_senderNode;
+            size = GetMinimumSize();
+        }
+        size += bytes;
+        return parts.back();
+    };
+    for (uint64_t key : m_keys) {
+        room(8).m_keys.push_back(key);
+    }
+    for (const std::pair<const uint32_t, double>& entry : m_predictabilities) {
+        room(6).m_predictabilities.insert(entry);
+    }
+    for (uint64_t key : m_deliveredKeys) {
+        room(8).m_deliveredKeys.push_back(key);
+    }
+
+    NS_ASSERT_MSG(parts.size() <= 0xFFFF, "Summary vector of " << m_keys.size() + m_deliveredKeys.size() << " keys needs "
+                  << parts.size() << " parts of " << maxSize << " bytes");
+    for (size_t k = 0; k < parts.size(); ++k) {
+        parts[k].m_part = static_cast<uint16_t>(k);
+        parts[k].m_partCount = static_cast<uint16_t>(parts.size());
+    }
+    return parts;
+}
+
+void DtnSummaryVectorHeader::Merge(const DtnSummaryVectorHeader& part) {
+    // Both key lists are sorted, so Contains() keeps working on the union
+    size_t middle = m_keys.size();
+    m_keys.insert(m_keys.end(), part.m_keys.begin(), part.m_keys.end());
+    std::inplace_merge(m_keys.begin(), m_keys.begin() + middle, m_keys.end());
+    m_predictabilities.insert(part.m_predictabilities.begin(), part.m_predictabilities.end());
+    m_deliveredKeys.insert(m_deliveredKeys.end(), part.m_deliveredKeys.begin(), part.m_deliveredKeys.end());
+    if (part.HasModel()) {
+        m_modelWeights = part.m_modelWeights;
+        m_modelSamples = part.m_modelSamples;
+    }
+    m_part = part.m_part;
+    m_partCount = part.m_partCount;
+}
+
+bool DtnSummaryVectorHeader::Contains(uint64_t key) const {
+    return std::binary_search(m_keys.begin(), m_keys.end(), key);
+}
+
+TypeId DtnSummaryVectorHeader::GetInstanceTypeId(void) const {
+    return GetTypeId();
+}
+
+uint32_t DtnSummaryVectorHeader::GetSerializedSize(void) const {
+    return 4 + 2 + 2 + 2 + 8 * m_keys.size() + 2 + 6 * std::min<size_t>(m_predictabilities.size(), 0xFFFF)
+        + 2 + 8 * m_deliveredKeys.size()
+        + 1 + (m_modelWeights.empty() ? 0 : 4 * m_modelWeights.size() + 4);
+}
+
+void DtnSummaryVectorHeader::Serialize(Buffer::Iterator start) const {
+    NS_ASSERT_MSG(m_keys.size() <= 0xFFFF && m_deliveredKeys.size() <= 0xFFFF,
+                  "Split() a summary vector of " << m_keys.size() << " + " << m_deliveredKeys.size() << " keys");
+    start.WriteHtonU32(m_senderNode);
+    start.WriteHtonU16(m_part);
+    start.WriteHtonU16(m_partCount);
+    start.WriteHtonU16(static_cast<uint16_t>(m_keys.size()));
+    for (uint64_t key : m_keys) {
+        start.WriteHtonU64(key);
+    }
+    
+    uint16_t tableCount = static_cast<uint16_t>(std::min<size_t>(m_predictabilities.size(), 0xFFFF));
+    start.WriteHtonU16(tableCount);
+    auto entry = m_predictabilities.begin();
+    for (uint16_t k = 0; k < tableCount; ++k, ++entry) {
+        double p = std::max(0.0, std::min(1.0, entry->second));
+        start.WriteHtonU32(entry->first);
+        start.WriteHtonU16(static_cast<uint16_t>(std::lround(p * 0xFFFF)));
+    }
+    
+    start.WriteHtonU16(static_cast<uint16_t>(m_deliveredKeys.size()));
+    for (uint64_t key : m_deliveredKeys) {
+        start.WriteHtonU64(key);
+    }
+    
+    start.WriteU8(static_cast<uint8_t>(m_modelWeights.size()));
+    for (double weight : m_modelWeights) {
+        float value = static_cast<float>(weight);
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        start.WriteHtonU32(bits);
+    }
+    if (!m_modelWeights.empty()) {
+        start.WriteHtonU32(m_modelSamples);
+    }
+}
+
+uint32_t DtnSummaryVectorHeader::Deserialize(Buffer::Iterator start) {
+    Buffer::Iterator i = start;
+    m_senderNode = i.ReadNtohU32();
+    m_part = i.ReadNtohU16();
+    m_partCount = i.ReadNtohU16();
+    uint16_t count = i.ReadNtohU16();
+    m_keys.clear();
+    m_keys.reserve(count);
+    for (uint16_t k = 0; k < count; ++k) {
+        m_keys.push_back(i.ReadNtohU64());
+    }
+    
+    uint16_t tableCount = i.ReadNtohU16();
+    m_predictabilities.clear();
+    for (uint16_t k = 0; k < tableCount; ++k) {
+        uint32_t node = i.ReadNtohU32();
+        m_predictabilities[node] = i.ReadNtohU16() / double(0xFFFF);
+    }
+    
+    uint16_t deliveredCount = i.ReadNtohU16();
+    m_deliveredKeys.clear();
+    m_deliveredKeys.reserve(deliveredCount);
+    for (uint16_t k = 0; k < deliveredCount; ++k) {
+        m_deliveredKeys.push_back(i.ReadNtohU64());
+    }
+    
+    uint8_t weightCount = i.ReadU8();
+    m_modelWeights.clear();
+    m_modelSamples = 0;
+    for (uint8_t k = 0; k < weightCount; ++k) {
+        uint32_t bits = i.ReadNtohU32();
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        m_modelWeights.push_back(value);
+    }
+    if (weightCount > 0) {
+        m_modelSamples = i.ReadNtohU32();
+    }
+    return i.GetDistanceFrom(start);
+}
+
+void DtnSummaryVectorHeader::Print(std::ostream& os) const {
+    os << "sender=" << m_senderNode << " part=" << m_part + 1 << "/" << m_partCount
+       << " bundles=" << m_keys.size()
+       << " predictabilities=" << m_predictabilities.size()
+       << " delivered=" << m_deliveredKeys.size()
+       << " weights=" << m_modelWeights.size();
+}
+
+} // namespace ns3
@@ -0,0 +1,100 @@
+/*
+ * DTN Summary Vector
+ * Anti-entropy digest exchanged between neighbours so only missing bundles are sent
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#ifndef DTN_SUMMARY_VECTOR_HEADER_H
+#define DTN_SUMMARY_VECTOR_HEADER_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <vector>
+
+namespace ns3 {
+
+/*
+ * Summary vector: the sender's node id and the sorted 64-bit keys
+ * (see MakeBundleKey) of every bundle it already holds or has delivered.
+ * Receivers answer with just the bundles missing from the vector.
+ * Routing strategies that need it (PROPHET) piggy-back their delivery
+ * predictability table, quantised to 16 bits per entry. Delivery reports
+ * list bundles known to have reached their destination, and a learning
+ * router may attach its model weights (float32) with their sample count.
+ *
+ * A vector too large for one datagram goes out as several (see Split());
+ * each part names its index and the part count, and the receiver Merge()s
+ * them and acts on the last one.
+ *
+ * Wire layout (network byte order):
+ *   sender(4) part(2) partCount(2)
+ *   count(2) count x key(8) tableCount(2) tableCount x (node(4) p(2))
+ *   deliveredCount(2) deliveredCount x key(8)
+ *   weightCount(1) weightCount x weight(4) [samples(4) if weightCount > 0]
+ */
+class DtnSummaryVectorHeader : public Header {
+public:
+    static TypeId GetTypeId(void);
+    DtnSummaryVectorHeader();
+    virtual ~DtnSummaryVectorHeader();
+
+    void SetSenderNode(uint32_t sender) { m_senderNode = sender; }
+    uint32_t GetSenderNode(void) const { return m_senderNode; }
+
+    // Keys are sorted here so Contains() can binary search
+    void SetBundleKeys(std::vector<uint64_t> keys);
+    const std::vector<uint64_t>& GetBundleKeys(void) const { return m_keys; }
+    bool Contains(uint64_t key) const;
+
+    void SetPredictabilities(const std::map<uint32_t, double>& table) { m_predictabilities = table; }
+    const std::map<uint32_t, double>& GetPredictabilities(void) const { return m_predictabilities; }
+
+    void SetDeliveredKeys(std::vector<uint64_t> keys);
+    const std::vector<uint64_t>& GetDeliveredKeys(void) const { return m_deliveredKeys; }
+
+    void SetModel(const std::vector<double>& weights, uint32_t samples);
+    bool HasModel(void) const { return !m_modelWeights.empty(); }
+    const std::vector<double>& GetModelWeights(void) const { return m_modelWeights; }
+    uint32_t GetModelSamples(void) const { return m_modelSamples; }
+
+    uint16_t GetPart(void) const { return m_part; }
+    uint16_t GetPartCount(void) const { return m_partCount; }
+    bool IsLastPart(void) const { return m_part + 1 >= m_partCount; }
+
+    // This vector as parts of at most maxSize serialized bytes (<= 65535),
+    // in order. Bundle keys, table entries and delivered keys fill each
+    // part and spill into the next; the model rides whole in the first.
+    std::vector<DtnSummaryVectorHeader> Split(uint32_t maxSize) const;
+    // Adds the keys, table entries and model of another part of the same vector
+    void Merge(const DtnSummaryVectorHeader& part);
+
+    // Size of a vector with every section empty
+    static uint32_t GetMinimumSize(void) { return 15; }
+
+    virtual TypeId GetInstanceTypeId(void) const;
+    virtual uint32_t GetSerializedSize(void) const;
+    virtual void Serialize(Buffer::Iterator start) const;
+    virtual uint32_t Deserialize(Buffer::Iterator start);
+    virtual void Print(std::ostream& os) const;
+
+private:
+    uint32_t m_senderNode;
+    uint16_t m_part;
+    uint16_t m_partCount;
+    std::vector<uint64_t> m_keys;
+    std::map<uint32_t, double> m_predictabilities;
+    std::vector<uint64_t> m_deliveredKeys;
+    std::vector<double> m_modelWeights;
+    uint32_t m_modelSamples;
+};
+
+} // namespace ns3
+
+#endif // DTN_SUMMARY_VECTOR_HEADER_H
@@ -0,0 +1,290 @@
+/*
+ * DTN Application Tests
+ * Custody transfer between DTN applications over replayed contacts
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "ns3/test.h"
+#include "ns3/dtn-application.h"
+#include "ns3/dtn-contact-plan.h"
+#include "ns3/dtn-helper.h"
+#include <vector>
+
+using namespace ns3;
+
+namespace {
+
+/*
+ * DTN application without a socket whose routing pass offers every
+ * bundle not awaiting custody to one contact that never acknowledges,
+ * and records when each pass ran
+ */
+class CustodyRetryProbe : public DtnApplication {
+public:
+    static const uint32_t PEER = 7;
+
+    void AddPeer(void) { m_neighbors.Heard(PEER, InetSocketAddress(Ipv4Address("10.0.0.7"), 9), Seconds(1000)); }
+
+    std::vector<Time> passes;
+
+protected:
+    virtual void DoRoutingPass(void) {
+        Time now = Simulator::Now();
+        passes.push_back(now);
+        DtnNeighbor* peer = m_neighbors.Find(PEER);
+        m_bundleStore.ForEach([&](DtnBundle& bundle) {
+            if (!AwaitingCustody(bundle, now)) {
+                ForwardBundle(bundle, bundle.copies, *peer);
+            }
+            return true;
+        });
+    }
+};
+
+// DTN application without a socket routing its buffer to one contact on demand
+class ForwardProbe : public DtnApplication {
+public:
+    static const uint32_t PEER = 7;
+
+    void RouteToPeer(void) {
+        DtnNeighbor* peer = m_neighbors.Heard(PEER, InetSocketAddress(Ipv4Address("10.0.0.7"), 9), Seconds(1000));
+        peer->hasVector = true;
+        RouteToNeighbor(*peer);
+    }
+
+    double GetBundleEnergy(void) {
+        double energy = 0.0;
+        m_bundleStore.ForEach([&](DtnBundle& bundle) {
+            energy = GetTransmitEnergy(bundle);
+            return false;
+        });
+        return energy;
+    }
+};
+
+// DTN applications from dtn on nodes that hear each other only during plan
+ApplicationContainer InstallPlanned(NodeContainer nodes, const DtnContactPlan& plan, const DtnHelper& dtn) {
+    NetDeviceContainer devices = DtnHelper::InstallContactPlan(nodes, plan);
+    DtnHelper::InstallInternet(nodes, devices, "10.1.0.0");
+    return dtn.Install(nodes);
+}
+
+Ptr<DtnApplication> GetDtn(ApplicationContainer apps, uint32_t i) {
+    return DynamicCast<DtnApplication>(apps.Get(i));
+}
+
+} // namespace
+
+/*
+ * Offers made at different times retry at their own deadlines, even when
+ * a retry pass makes a fresh offer that times out after an older one
+ */
+class DtnCustodyRetryTestCase : public TestCase {
+public:
+    DtnCustodyRetryTestCase()
+        : TestCase("Custody retry at the earliest offer deadline") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        Ptr<CustodyRetryProbe> probe = CreateObject<CustodyRetryProbe>();
+        probe->SetAttribute("CustodyTransfer", BooleanValue(true));
+        probe->SetAttribute("CustodyTimeout", TimeValue(Seconds(10)));
+        probe->AddPeer();
+
+        // Offered at 0 s and 3 s, so due back at 10 s and 13 s, then every 10 s
+        Simulator::Schedule(Seconds(0), [probe]() { probe->SendBundle(9, 2, "first"); });
+        Simulator::Schedule(Seconds(3), [probe]() { probe->SendBundle(9, 2, "second"); });
+        Simulator::Stop(Seconds(24));
+        Simulator::Run();
+
+        std::vector<Time> expected = {Seconds(0), Seconds(3), Seconds(10), Seconds(13), Seconds(20), Seconds(23)};
+        NS_TEST_ASSERT_MSG_EQ(probe->passes.size(), expected.size(), "Routing passes");
+        for (uint32_t i = 0; i < expected.size() && i < probe->passes.size(); ++i) {
+            NS_TEST_ASSERT_MSG_EQ(probe->passes[i], expected[i], "Routing pass " << i);
+        }
+        NS_TEST_ASSERT_MSG_EQ(probe->GetStats().bundlesForwarded, 6u, "Each offer repeated per timeout");
+        probe->Dispose();
+        Simulator::Destroy();
+    }
+};
+
+/*
+ * A node handing bundles over under custody transfer drops its copies
+ * once the next hop acknowledges them: one bundle the peer stores, one
+ * the peer is the destination of
+ */
+class DtnCustodyReleaseTestCase : public TestCase {
+public:
+    DtnCustodyReleaseTestCase()
+        : TestCase("Custody release on the next hop's ACK") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        NodeContainer nodes;
+        nodes.Create(3);
+        uint32_t source = nodes.Get(0)->GetId();
+        uint32_t relay = nodes.Get(1)->GetId();
+        uint32_t destination = nodes.Get(2)->GetId();
+        DtnContactPlan plan;
+        plan.Add(DtnContact(Seconds(5), Seconds(15), source, relay));
+
+        DtnHelper dtn;
+        dtn.SetRoutingStrategy("Epidemic");
+        dtn.SetAttribute("CustodyTransfer", BooleanValue(true));
+        ApplicationContainer apps = InstallPlanned(nodes, plan, dtn);
+        apps.Start(Seconds(0));
+        apps.Stop(Seconds(20));
+        Ptr<DtnApplication> sender = GetDtn(apps, 0);
+        Simulator::Schedule(Seconds(1), &DtnApplication::SendBundle, sender, destination, 2, std::string("carried"));
+        Simulator::Schedule(Seconds(1), &DtnApplication::SendBundle, sender, relay, 2, std::string("delivered"));
+        Simulator::Stop(Seconds(21));
+        Simulator::Run();
+
+        const DtnApplicationStats& senderStats = sender->GetStats();
+        const DtnApplicationStats& relayStats = GetDtn(apps, 1)->GetStats();
+        NS_TEST_ASSERT_MSG_EQ(senderStats.bundlesForwarded, 2u, "Each bundle offered once");
+        NS_TEST_ASSERT_MSG_EQ(relayStats.bundlesDelivered, 1u, "Delivered to the relay");
+        NS_TEST_ASSERT_MSG_EQ(GetDtn(apps, 1)->GetBufferedBundles(), 1u, "Relay took custody of the other");
+        NS_TEST_ASSERT_MSG_EQ(relayStats.custodyAcksSent, 1u, "Both acknowledged in one ACK");
+        NS_TEST_ASSERT_MSG_EQ(senderStats.custodyReleased, 2u, "Both copies released");
+        NS_TEST_ASSERT_MSG_EQ(sender->GetBufferedBundles(), 0u, "Sender holds nothing");
+        NS_TEST_ASSERT_MSG_EQ(GetDtn(apps, 2)->GetStats().bundlesReceived, 0u, "Destination never in contact");
+        Simulator::Destroy();
+    }
+};
+
+/*
+ * The source meets the destination only after a relay delivered its
+ * bundle there: with Vaccination the destination's delivery report
+ * purges the source's copy, without it the copy stays until its TTL
+ */
+class DtnVaccinationTestCase : public TestCase {
+public:
+    DtnVaccinationTestCase()
+        : TestCase("Vaccination purges copies delivered elsewhere") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        Run(true);
+        Run(false);
+    }
+
+    void Run(bool vaccination) {
+        NodeContainer nodes;
+        nodes.Create(3);
+        uint32_t source = nodes.Get(0)->GetId();
+        uint32_t relay = nodes.Get(1)->GetId();
+        uint32_t destination = nodes.Get(2)->GetId();
+        DtnContactPlan plan;
+        plan.Add(DtnContact(Seconds(5), Seconds(15), source, relay));
+        plan.Add(DtnContact(Seconds(20), Seconds(30), relay, destination));
+        plan.Add(DtnContact(Seconds(35), Seconds(45), source, destination));
+
+        DtnHelper dtn;
+        dtn.SetRoutingStrategy("Epidemic");
+        dtn.SetAttribute("Vaccination", BooleanValue(vaccination));
+        ApplicationContainer apps = InstallPlanned(nodes, plan, dtn);
+        apps.Start(Seconds(0));
+        apps.Stop(Seconds(50));
+        Ptr<DtnApplication> sender = GetDtn(apps, 0);
+        Simulator::Schedule(Seconds(1), &DtnApplication::SendBundle, sender, destination, 2, std::string("vaccine"));
+        Simulator::Stop(Seconds(51));
+        Simulator::Run();
+
+        const DtnApplicationStats& destinationStats = GetDtn(apps, 2)->GetStats();
+        NS_TEST_ASSERT_MSG_EQ(destinationStats.bundlesDelivered, 1u, "Delivered through the relay");
+        NS_TEST_ASSERT_MSG_EQ(sender->GetStats().bundlesPurged, vaccination ? 1u : 0u, "Purged only with vaccination");
+        NS_TEST_ASSERT_MSG_EQ(sender->GetBufferedBundles(), vaccination ? 0u : 1u, "Source copy");
+        NS_TEST_ASSERT_MSG_EQ(sender->GetStats().bundlesForwarded, 1u, "Never offered to the destination");
+        Simulator::Destroy();
+    }
+};
+
+// Bundle keys restart with every simulation, and so does the shared pool
+class DtnPayloadPoolLifetimeTestCase : public TestCase {
+public:
+    DtnPayloadPoolLifetimeTestCase()
+        : TestCase("Payload pool cleared by Simulator::Destroy") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        for (uint32_t run = 0; run < 2; run++) {
+            DtnPayloadPool& pool = DtnApplication::GetPayloadPool();
+            pool.Intern(MakeBundleKey(1, 1), Create<Packet>(8 + run), Seconds(100));
+            NS_TEST_ASSERT_MSG_EQ(pool.GetSize(), 1u, "Interned");
+            Simulator::Run();
+            NS_TEST_ASSERT_MSG_EQ(pool.GetSize(), 1u, "Kept to the end of the run");
+            Simulator::Destroy();
+            NS_TEST_ASSERT_MSG_EQ(pool.GetSize(), 0u, "Cleared with the simulation");
+        }
+    }
+};
+
+/*
+ * Sends queued earlier in a routing pass count against the battery
+ * before the energy source is charged for them, and only the forwards
+ * actually given up count as suppressed
+ */
+class DtnForwardEnergyTestCase : public TestCase {
+public:
+    DtnForwardEnergyTestCase()
+        : TestCase("Forwards within one pass share the battery") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        Ptr<ForwardProbe> probe = CreateObject<ForwardProbe>();
+        probe->SetAttribute("LowBatteryThreshold", DoubleValue(0.5));
+        probe->SetRoutingStrategy(Create<EpidemicStrategy>());
+        for (uint32_t i = 0; i < 4; i++) {
+            probe->SendBundle(9, 2, "same size");
+        }
+
+        // A reserve of 2.5 forwards and 2.5 more above it: two fit
+        double cost = probe->GetBundleEnergy();
+        Ptr<energy::BasicEnergySource> battery = CreateObject<energy::BasicEnergySource>();
+        battery->SetInitialEnergy(5 * cost);
+        probe->SetEnergySource(battery);
+        probe->RouteToPeer();
+        NS_TEST_ASSERT_MSG_EQ(probe->GetStats().bundlesForwarded, 2u, "Forwards the battery affords");
+        NS_TEST_ASSERT_MSG_EQ(probe->GetStats().forwardsSuppressed, 2u, "The rest suppressed");
+        probe->Dispose();
+
+        // Capped at one forward a pass, the capped-out bundles were never
+        // going out and are not suppressed
+        probe = CreateObject<ForwardProbe>();
+        probe->SetAttribute("MaxForwardsPerContact", UintegerValue(1));
+        probe->SetRoutingStrategy(Create<EpidemicStrategy>());
+        for (uint32_t i = 0; i < 4; i++) {
+            probe->SendBundle(9, 2, "same size");
+        }
+        battery = CreateObject<energy::BasicEnergySource>();
+        battery->SetInitialEnergy(100 * cost);
+        probe->SetEnergySource(battery);
+        probe->RouteToPeer();
+        NS_TEST_ASSERT_MSG_EQ(probe->GetStats().bundlesForwarded, 1u, "One forward a pass");
+        NS_TEST_ASSERT_MSG_EQ(probe->GetStats().forwardsSuppressed, 0u, "Cap is not the battery");
+        probe->Dispose();
+        Simulator::Destroy();
+    }
+};
+
+class DtnApplicationTestSuite : public TestSuite {
+public:
+    DtnApplicationTestSuite()
+        : TestSuite("dtn-application", Type::UNIT) {
+        AddTestCase(new DtnCustodyRetryTestCase, Duration::QUICK);
+        AddTestCase(new DtnCustodyReleaseTestCase, Duration::QUICK);
+        AddTestCase(new DtnVaccinationTestCase, Duration::QUICK);
+        AddTestCase(new DtnPayloadPoolLifetimeTestCase, Duration::QUICK);
+        AddTestCase(new DtnForwardEnergyTestCase, Duration::QUICK);
+    }
+};
+
+static DtnApplicationTestSuite g_dtnApplicationTestSuite;
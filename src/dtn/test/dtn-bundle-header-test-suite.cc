@@ -0,0 +1,277 @@
+/*
+ * DTN Bundle Wire Format Tests
+ * Bundle header and route path serialization, fragment reassembly, custody ACKs
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "ns3/test.h"
+#include "ns3/dtn-bundle-header.h"
+#include <vector>
+
+using namespace ns3;
+
+namespace {
+
+Ptr<Packet> MakePayload(uint32_t size) {
+    std::vector<uint8_t> bytes(size);
+    for (uint32_t i = 0; i < size; ++i) {
+        bytes[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+    return Create<Packet>(bytes.data(), size);
+}
+
+std::vector<uint8_t> Bytes(Ptr<const Packet> packet) {
+    std::vector<uint8_t> bytes(packet->GetSize());
+    packet->CopyData(bytes.data(), bytes.size());
+    return bytes;
+}
+
+} // namespace
+
+/*
+ * Bundle header round trip, including LEB128 route-path hops of every
+ * varint length and a path that outgrew MAX_HOPS
+ */
+class DtnBundleHeaderTestCase : public TestCase {
+public:
+    DtnBundleHeaderTestCase()
+        : TestCase("Bundle header and route path serialization") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        DtnRoutePath path;
+        const uint32_t hops[] = {5, 127, 128, 16383, 16384, 0xFFFFFFFF};
+        for (uint32_t hop : hops) {
+            path.Append(hop);
+        }
+        // Count byte, then 1 + 1 + 2 + 2 + 3 + 5 varint bytes
+        NS_TEST_ASSERT_MSG_EQ(path.GetSerializedSize(), 15u, "LEB128 route-path size");
+
+        DtnBundleHeader header;
+        header.SetBundleId(4711);
+        header.SetSourceNode(3);
+        header.SetDestinationNode(70000);
+        header.SetPriority(1);
+        header.SetHopCount(6);
+        header.SetCopies(513);
+        header.SetCreationTime(NanoSeconds(12345678901LL));
+        header.SetTtl(Seconds(300));
+        header.SetFlags(DTN_BUNDLE_FLAG_CUSTODY);
+        header.SetRoutePath(path);
+        NS_TEST_ASSERT_MSG_EQ(header.GetSerializedSize(), 29u + 15u, "Bundle header size");
+
+        Ptr<Packet> packet = Create<Packet>();
+        packet->AddHeader(header);
+        NS_TEST_ASSERT_MSG_EQ(packet->GetSize(), header.GetSerializedSize(), "Serialized size");
+        DtnBundleHeader read;
+        packet->RemoveHeader(read);
+        NS_TEST_ASSERT_MSG_EQ(packet->GetSize(), 0u, "Header consumed whole");
+        NS_TEST_ASSERT_MSG_EQ(read.GetBundleId(), 4711u, "Bundle id");
+        NS_TEST_ASSERT_MSG_EQ(read.GetSourceNode(), 3u, "Source");
+        NS_TEST_ASSERT_MSG_EQ(read.GetDestinationNode(), 70000u, "Destination");
+        NS_TEST_ASSERT_MSG_EQ(read.GetPriority(), 1, "Priority");
+        NS_TEST_ASSERT_MSG_EQ(read.GetHopCount(), 6, "Hop count");
+        NS_TEST_ASSERT_MSG_EQ(read.GetCopies(), 513, "Copies");
+        NS_TEST_ASSERT_MSG_EQ(read.GetCreationTime(), NanoSeconds(12345678901LL), "Creation time");
+        NS_TEST_ASSERT_MSG_EQ(read.GetTtl(), Seconds(300), "TTL");
+        NS_TEST_ASSERT_MSG_EQ(read.IsCustodyRequested(), true, "Custody flag");
+        const DtnRoutePath& readPath = read.GetRoutePath();
+        NS_TEST_ASSERT_MSG_EQ(readPath.GetSize(), 6u, "Route path length");
+        for (uint32_t k = 0; k < readPath.GetSize(); ++k) {
+            NS_TEST_ASSERT_MSG_EQ(readPath.Get(k), hops[k], "Route path hop " << k);
+        }
+        NS_TEST_ASSERT_MSG_EQ(readPath.IsTruncated(), false, "Short path not truncated");
+
+        // The oldest hops go once MAX_HOPS are held, and the wire says so
+        DtnRoutePath longPath;
+        for (uint32_t node = 0; node < DtnRoutePath::MAX_HOPS + 4; ++node) {
+            longPath.Append(node);
+        }
+        header.SetRoutePath(longPath);
+        packet = Create<Packet>();
+        packet->AddHeader(header);
+        packet->RemoveHeader(read);
+        NS_TEST_ASSERT_MSG_EQ(read.GetRoutePath().GetSize(), DtnRoutePath::MAX_HOPS, "Path capped");
+        NS_TEST_ASSERT_MSG_EQ(read.GetRoutePath().IsTruncated(), true, "Truncation flag");
+        NS_TEST_ASSERT_MSG_EQ(read.GetRoutePath().Get(0), 4u, "Oldest hop kept");
+        NS_TEST_ASSERT_MSG_EQ(read.GetRoutePath().GetPreviousHop(99), DtnRoutePath::MAX_HOPS + 2,
+                              "Previous hop");
+    }
+};
+
+/*
+ * A datagram cut short anywhere inside the header deserializes as invalid
+ * without the route path's hop count or varints reading past the buffer
+ */
+class DtnBundleHeaderTruncatedTestCase : public TestCase {
+public:
+    DtnBundleHeaderTruncatedTestCase()
+        : TestCase("Truncated bundle header is rejected") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        DtnRoutePath path;
+        path.Append(3);
+        path.Append(16384);
+        path.Append(0xFFFFFFFF);
+        DtnBundleHeader header;
+        header.SetBundleId(9);
+        header.SetRoutePath(path);
+        const uint32_t size = header.GetSerializedSize();
+
+        for (uint32_t cut = 1; cut <= size; ++cut) {
+            Ptr<Packet> packet = Create<Packet>();
+            packet->AddHeader(header);
+            packet->RemoveAtEnd(cut);
+            DtnBundleHeader read;
+            packet->RemoveHeader(read);
+            NS_TEST_ASSERT_MSG_EQ(read.IsValid(), false, "Header cut by " << cut << " bytes");
+        }
+
+        // A hop count larger than the hops that follow it
+        Ptr<Packet> packet = Create<Packet>();
+        packet->AddHeader(header);
+        uint8_t bytes[64];
+        packet->CopyData(bytes, size);
+        bytes[29] = 5;
+        packet = Create<Packet>(bytes, size);
+        DtnBundleHeader read;
+        packet->RemoveHeader(read);
+        NS_TEST_ASSERT_MSG_EQ(read.IsValid(), false, "Overstated hop count");
+
+        packet = Create<Packet>();
+        packet->AddHeader(header);
+        packet->RemoveHeader(read);
+        NS_TEST_ASSERT_MSG_EQ(read.IsValid(), true, "Whole header");
+    }
+};
+
+// Overlapping slices from senders with different frame sizes
+class DtnReassemblyTestCase : public TestCase {
+public:
+    DtnReassemblyTestCase()
+        : TestCase("Fragment reassembly with overlapping slices") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        Ptr<Packet> payload = MakePayload(100);
+        DtnReassembly reassembly(100);
+        NS_TEST_ASSERT_MSG_EQ(reassembly.AddSlice(90, payload->CreateFragment(0, 20)), false, "Past the end");
+
+        // 40-byte slices from one sender, 30-byte ones from another
+        NS_TEST_ASSERT_MSG_EQ(reassembly.AddSlice(80, payload->CreateFragment(80, 20)), true, "Slice");
+        NS_TEST_ASSERT_MSG_EQ(reassembly.AddSlice(0, payload->CreateFragment(0, 40)), true, "Slice");
+        NS_TEST_ASSERT_MSG_EQ(reassembly.IsComplete(), false, "Gap at 40");
+        NS_TEST_ASSERT_MSG_EQ(reassembly.AddSlice(30, payload->CreateFragment(30, 30)), true, "Slice");
+        NS_TEST_ASSERT_MSG_EQ(reassembly.IsComplete(), false, "Gap at 60");
+        NS_TEST_ASSERT_MSG_EQ(reassembly.AddSlice(40, payload->CreateFragment(40, 40)), true, "Slice");
+        NS_TEST_ASSERT_MSG_EQ(reassembly.IsComplete(), true, "Covered");
+
+        Ptr<Packet> whole = reassembly.Assemble();
+        NS_TEST_ASSERT_MSG_EQ(whole->GetSize(), 100u, "Reassembled size");
+        NS_TEST_ASSERT_MSG_EQ((Bytes(whole) == Bytes(payload)), true, "Reassembled bytes");
+
+        // One slice holding the whole payload completes at once
+        DtnReassembly single(100);
+        single.AddSlice(0, payload->Copy());
+        NS_TEST_ASSERT_MSG_EQ(single.IsComplete(), true, "Single slice");
+        NS_TEST_ASSERT_MSG_EQ((Bytes(single.Assemble()) == Bytes(payload)), true, "Single slice bytes");
+    }
+};
+
+/*
+ * Custody ACK round trip, an ACK split into MaxFrameSize parts, and key
+ * counts that overstate the datagram
+ */
+class DtnCustodyAckTestCase : public TestCase {
+public:
+    DtnCustodyAckTestCase()
+        : TestCase("Custody ACK serialization and split") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        DtnCustodyAckHeader ack;
+        ack.SetSenderNode(11);
+        ack.SetAcceptedKeys({MakeBundleKey(1, 2), MakeBundleKey(3, 4)});
+        ack.SetDeliveredKeys({MakeBundleKey(5, 6)});
+
+        Ptr<Packet> packet = Create<Packet>();
+        packet->AddHeader(ack);
+        NS_TEST_ASSERT_MSG_EQ(packet->GetSize(), DtnCustodyAckHeader::GetMinimumSize() + 3 * 8, "Size");
+        DtnCustodyAckHeader read;
+        packet->RemoveHeader(read);
+        NS_TEST_ASSERT_MSG_EQ(read.IsValid(), true, "Valid");
+        NS_TEST_ASSERT_MSG_EQ(packet->GetSize(), 0u, "ACK consumed whole");
+        NS_TEST_ASSERT_MSG_EQ(read.GetSenderNode(), 11u, "Sender");
+        NS_TEST_ASSERT_MSG_EQ(read.GetAcceptedKeys().size(), 2u, "Accepted keys");
+        NS_TEST_ASSERT_MSG_EQ(read.GetAcceptedKeys()[1], MakeBundleKey(3, 4), "Accepted key");
+        NS_TEST_ASSERT_MSG_EQ(read.GetDeliveredKeys().size(), 1u, "Delivered keys");
+        NS_TEST_ASSERT_MSG_EQ(read.GetDeliveredKeys()[0], MakeBundleKey(5, 6), "Delivered key");
+
+        DtnCustodyAckHeader empty;
+        packet = Create<Packet>();
+        packet->AddHeader(empty);
+        NS_TEST_ASSERT_MSG_EQ(packet->GetSize(), DtnCustodyAckHeader::GetMinimumSize(), "Empty ACK size");
+
+        // More keys than one 16-bit count, in 1400-byte parts
+        std::vector<uint64_t> accepted;
+        std::vector<uint64_t> delivered;
+        for (uint32_t k = 0; k < 70000; ++k) {
+            accepted.push_back(MakeBundleKey(1, k));
+        }
+        for (uint32_t k = 0; k < 300; ++k) {
+            delivered.push_back(MakeBundleKey(2, k));
+        }
+        DtnCustodyAckHeader large;
+        large.SetSenderNode(7);
+        large.SetAcceptedKeys(accepted);
+        large.SetDeliveredKeys(delivered);
+        std::vector<DtnCustodyAckHeader> parts = large.Split(1400);
+        NS_TEST_ASSERT_MSG_EQ(parts.size(), (70300 + 173) / 174, "174 keys per part");
+        std::vector<uint64_t> readAccepted;
+        std::vector<uint64_t> readDelivered;
+        for (const DtnCustodyAckHeader& part : parts) {
+            NS_TEST_ASSERT_MSG_LT_OR_EQ(part.GetSerializedSize(), 1400u, "Part fits");
+            packet = Create<Packet>();
+            packet->AddHeader(part);
+            packet->RemoveHeader(read);
+            NS_TEST_ASSERT_MSG_EQ(read.IsValid(), true, "Part valid");
+            NS_TEST_ASSERT_MSG_EQ(read.GetSenderNode(), 7u, "Every part names the sender");
+            readAccepted.insert(readAccepted.end(), read.GetAcceptedKeys().begin(), read.GetAcceptedKeys().end());
+            readDelivered.insert(readDelivered.end(), read.GetDeliveredKeys().begin(),
+                                 read.GetDeliveredKeys().end());
+        }
+        NS_TEST_ASSERT_MSG_EQ((readAccepted == accepted), true, "No accepted key lost");
+        NS_TEST_ASSERT_MSG_EQ((readDelivered == delivered), true, "No delivered key lost");
+
+        // Counts promising more keys than the datagram holds
+        for (uint32_t cut : {1u, 8u, 9u, 17u, 24u}) {
+            packet = Create<Packet>();
+            packet->AddHeader(ack);
+            packet->RemoveAtEnd(cut);
+            packet->RemoveHeader(read);
+            NS_TEST_ASSERT_MSG_EQ(read.IsValid(), false, "ACK cut by " << cut << " bytes");
+            NS_TEST_ASSERT_MSG_EQ(read.GetAcceptedKeys().size() + read.GetDeliveredKeys().size(), 0u,
+                                  "No keys from a short ACK");
+        }
+    }
+};
+
+class DtnBundleHeaderTestSuite : public TestSuite {
+public:
+    DtnBundleHeaderTestSuite()
+        : TestSuite("dtn-bundle-header", Type::UNIT) {
+        AddTestCase(new DtnBundleHeaderTestCase, Duration::QUICK);
+        AddTestCase(new DtnBundleHeaderTruncatedTestCase, Duration::QUICK);
+        AddTestCase(new DtnReassemblyTestCase, Duration::QUICK);
+        AddTestCase(new DtnCustodyAckTestCase, Duration::QUICK);
+    }
+};
+
+static DtnBundleHeaderTestSuite g_dtnBundleHeaderTestSuite;
@@ -0,0 +1,171 @@
+/*
+ * DTN Bundle Store Tests
+ * TTL expiry, visiting order and buffer management
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "ns3/test.h"
+#include "ns3/dtn-bundle-header.h"
+#include "ns3/dtn-bundle-store.h"
+#include "ns3/dtn-bundle.h"
+#include <vector>
+
+using namespace ns3;
+
+namespace {
+
+DtnBundle MakeBundle(uint32_t source, uint32_t id, uint32_t priority, Time creation, Time ttl) {
+    DtnBundle bundle;
+    bundle.sourceNode = source;
+    bundle.bundleId = id;
+    bundle.priority = priority;
+    bundle.creationTime = creation;
+    bundle.ttl = ttl;
+    return bundle;
+}
+
+// Keys of a store in ForEach() order
+std::vector<uint64_t> VisitOrder(const BundleStore<DtnBundle>& store) {
+    std::vector<uint64_t> keys;
+    store.ForEach([&](const DtnBundle& bundle) {
+        keys.push_back(MakeBundleKey(bundle.sourceNode, bundle.bundleId));
+        return true;
+    });
+    return keys;
+}
+
+} // namespace
+
+// TTL expiry through the lazy heap and priority-class visiting order
+class DtnBundleStoreTestCase : public TestCase {
+public:
+    DtnBundleStoreTestCase()
+        : TestCase("Bundle store expiry and visiting order") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        BundleStore<DtnBundle> store(4);
+        NS_TEST_ASSERT_MSG_EQ(store.GetNextExpiry(), Time::Max(), "Empty store never expires");
+        NS_TEST_ASSERT_MSG_EQ(store.Insert(MakeBundle(1, 1, 2, Seconds(0), Seconds(30))), true, "Insert");
+        NS_TEST_ASSERT_MSG_EQ(store.Insert(MakeBundle(1, 2, 3, Seconds(0), Seconds(10))), true, "Insert");
+        NS_TEST_ASSERT_MSG_EQ(store.Insert(MakeBundle(2, 1, 0, Seconds(5), Seconds(50))), true, "Insert");
+        NS_TEST_ASSERT_MSG_EQ(store.Insert(MakeBundle(2, 2, 2, Seconds(5), Seconds(15))), true, "Insert");
+        NS_TEST_ASSERT_MSG_EQ(store.Insert(MakeBundle(2, 1, 0, Seconds(5), Seconds(50))), false, "Duplicate");
+        NS_TEST_ASSERT_MSG_EQ(store.IsFull(), true, "Store full");
+        NS_TEST_ASSERT_MSG_EQ(store.Insert(MakeBundle(3, 1, 0, Seconds(6), Seconds(50))), false, "Full");
+
+        // Most urgent class first, FIFO within a class
+        std::vector<uint64_t> order = VisitOrder(store);
+        std::vector<uint64_t> expected = {MakeBundleKey(2, 1), MakeBundleKey(1, 1), MakeBundleKey(2, 2),
+                                          MakeBundleKey(1, 2)};
+        NS_TEST_ASSERT_MSG_EQ((order == expected), true, "Visiting order");
+
+        // Expiry at creationTime + ttl, skipping the removed bundle's heap entry
+        store.Remove(MakeBundleKey(1, 2));
+        NS_TEST_ASSERT_MSG_EQ(store.GetNextExpiry(), Seconds(20), "Removed bundle's expiry skipped");
+        NS_TEST_ASSERT_MSG_EQ(store.ExpireBundles(Seconds(19)), 0u, "Nothing expired yet");
+        NS_TEST_ASSERT_MSG_EQ(store.ExpireBundles(Seconds(30)), 2u, "Two bundles expired");
+        NS_TEST_ASSERT_MSG_EQ(store.GetSize(), 1u, "One left");
+        NS_TEST_ASSERT_MSG_EQ(store.Contains(MakeBundleKey(2, 1)), true, "Longest TTL kept");
+        NS_TEST_ASSERT_MSG_EQ(store.GetNextExpiry(), Seconds(55), "Next expiry");
+
+        // Freed slots are reused; a re-inserted key expires at its new TTL only
+        NS_TEST_ASSERT_MSG_EQ(store.Insert(MakeBundle(1, 1, 2, Seconds(30), Seconds(100))), true, "Reinsert");
+        NS_TEST_ASSERT_MSG_EQ(store.ExpireBundles(Seconds(60)), 1u, "Only the old bundle expired");
+        NS_TEST_ASSERT_MSG_EQ(store.Contains(MakeBundleKey(1, 1)), true, "Reinserted bundle kept");
+        NS_TEST_ASSERT_MSG_EQ(store.GetNextExpiry(), Seconds(130), "Reinserted expiry");
+        NS_TEST_ASSERT_MSG_EQ(VisitOrder(store).size(), 1u, "Visit skips freed slots");
+    }
+};
+
+// Victims the drop policies pick for a newcomer to a full store
+class DtnDropPolicyTestCase : public TestCase {
+public:
+    DtnDropPolicyTestCase()
+        : TestCase("Bundle store drop-policy victims") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        BundleStore<DtnBundle> store(4);
+        store.Insert(MakeBundle(1, 1, 2, Seconds(0), Seconds(30)));
+        store.Insert(MakeBundle(1, 2, 3, Seconds(0), Seconds(10)));
+        store.Insert(MakeBundle(2, 1, 0, Seconds(5), Seconds(50)));
+        store.Insert(MakeBundle(2, 2, 2, Seconds(5), Seconds(15)));
+
+        // Lowest class no more urgent than the newcomer, oldest first
+        DtnBundle medical = MakeBundle(3, 1, 1, Seconds(6), Seconds(50));
+        auto noScore = [](const DtnBundle&) { return 0.0; };
+        const DtnBundle* victim = store.SelectVictim(medical, DTN_DROP_LOWEST_PRIORITY, noScore);
+        NS_TEST_ASSERT_MSG_EQ((victim != nullptr), true, "Low bundle evictable");
+        NS_TEST_ASSERT_MSG_EQ(victim->bundleId, 2u, "Low class goes first");
+        store.Remove(MakeBundleKey(1, 2));
+        victim = store.SelectVictim(medical, DTN_DROP_LOWEST_PRIORITY, noScore);
+        NS_TEST_ASSERT_MSG_EQ(MakeBundleKey(victim->sourceNode, victim->bundleId), MakeBundleKey(1, 1),
+                              "Oldest General bundle next");
+        DtnBundle low = MakeBundle(3, 2, 3, Seconds(6), Seconds(50));
+        NS_TEST_ASSERT_MSG_EQ((store.SelectVictim(low, DTN_DROP_LOWEST_PRIORITY, noScore) == nullptr), true,
+                              "Nothing less urgent than Low");
+        NS_TEST_ASSERT_MSG_EQ((store.SelectVictim(medical, DTN_DROP_TAIL, noScore) == nullptr), true,
+                              "Drop tail refuses");
+
+        // Least retention: the lowest score, if below the newcomer's
+        auto byTtl = [](const DtnBundle& bundle) { return bundle.ttl.GetSeconds(); };
+        victim = store.SelectVictim(medical, DTN_DROP_LEAST_RETENTION, byTtl);
+        NS_TEST_ASSERT_MSG_EQ(victim->ttl, Seconds(15), "Lowest retention score");
+        DtnBundle shortLived = MakeBundle(3, 3, 2, Seconds(6), Seconds(1));
+        NS_TEST_ASSERT_MSG_EQ((store.SelectVictim(shortLived, DTN_DROP_LEAST_RETENTION, byTtl) == nullptr), true,
+                              "Newcomer scored lowest");
+    }
+};
+
+/*
+ * Interning trusts the key: a later copy under it gets the first one
+ * back, even with other bytes, until the entry's TTL or Clear()
+ */
+class DtnPayloadPoolTestCase : public TestCase {
+public:
+    DtnPayloadPoolTestCase()
+        : TestCase("Payload pool interning by key") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        static const uint8_t first[] = {1, 2, 3};
+        static const uint8_t other[] = {9, 9};
+        Ptr<Packet> arrived = Create<Packet>(first, sizeof(first));
+        DtnPayloadPool pool;
+        Ptr<Packet> canonical = pool.Intern(7, arrived, Seconds(10));
+        NS_TEST_ASSERT_MSG_EQ(canonical != arrived, true, "Interned into its own buffer");
+        NS_TEST_ASSERT_MSG_EQ(canonical->GetSize(), 3u, "Same bytes");
+        NS_TEST_ASSERT_MSG_EQ(pool.Intern(7, Create<Packet>(first, sizeof(first)), Seconds(10)) == canonical, true,
+                              "Copies share the first");
+        NS_TEST_ASSERT_MSG_EQ(pool.Intern(7, Create<Packet>(other, sizeof(other)), Seconds(10)) == canonical, true,
+                              "Bytes not compared");
+        NS_TEST_ASSERT_MSG_EQ(pool.Intern(8, Create<Packet>(other, sizeof(other)), Seconds(20))->GetSize(), 2u,
+                              "Other key, own payload");
+        NS_TEST_ASSERT_MSG_EQ(pool.GetSize(), 2u, "One entry per key");
+
+        pool.ExpireBundles(Seconds(10));
+        NS_TEST_ASSERT_MSG_EQ(pool.GetSize(), 1u, "Gone at its TTL");
+        NS_TEST_ASSERT_MSG_EQ(pool.Intern(7, Create<Packet>(other, sizeof(other)), Seconds(30)) == canonical, false,
+                              "Interned afresh after expiry");
+        pool.Clear();
+        NS_TEST_ASSERT_MSG_EQ(pool.GetSize(), 0u, "Cleared");
+    }
+};
+
+class DtnBundleStoreTestSuite : public TestSuite {
+public:
+    DtnBundleStoreTestSuite()
+        : TestSuite("dtn-bundle-store", Type::UNIT) {
+        AddTestCase(new DtnBundleStoreTestCase, Duration::QUICK);
+        AddTestCase(new DtnDropPolicyTestCase, Duration::QUICK);
+        AddTestCase(new DtnPayloadPoolTestCase, Duration::QUICK);
+    }
+};
+
+static DtnBundleStoreTestSuite g_dtnBundleStoreTestSuite;
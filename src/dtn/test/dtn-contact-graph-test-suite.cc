@@ -0,0 +1,102 @@
+/*
+ * DTN Contact Graph Tests
+ * Earliest-arrival routes over scheduled contacts
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "ns3/test.h"
+#include "ns3/dtn-contact-graph.h"
+#include "ns3/dtn-routing-strategy.h"
+
+using namespace ns3;
+
+// Earliest arrival over scheduled contacts, waiting for a later contact
+class DtnContactGraphTestCase : public TestCase {
+public:
+    DtnContactGraphTestCase()
+        : TestCase("Contact graph earliest-arrival routes") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        Ptr<DtnContactGraph> graph = Create<DtnContactGraph>(MilliSeconds(1));
+        uint32_t first = graph->AddContact(DtnContact(Seconds(10), Seconds(20), 0, 1));
+        uint32_t second = graph->AddContact(DtnContact(Seconds(30), Seconds(40), 1, 2));
+        graph->AddContact(DtnContact(Seconds(100), Seconds(110), 2, 0));
+        graph->AddContact(DtnContact(Seconds(0), Seconds(5), 3, 4));
+
+        // Through node 1, waiting there for the second contact, beats the direct one
+        DtnContactRoute route = graph->FindRoute(0, 2, Seconds(0));
+        NS_TEST_ASSERT_MSG_EQ(route.Exists(), true, "Route found");
+        NS_TEST_ASSERT_MSG_EQ(route.nextHop, 1u, "Next hop");
+        NS_TEST_ASSERT_MSG_EQ(route.arrival, Seconds(30) + MilliSeconds(1), "Earliest arrival");
+        NS_TEST_ASSERT_MSG_EQ(route.validUntil, Seconds(20), "Valid until the first contact ends");
+        NS_TEST_ASSERT_MSG_EQ(route.contacts.size(), 2u, "Two contacts");
+        NS_TEST_ASSERT_MSG_EQ(route.contacts[0], first, "First contact");
+        NS_TEST_ASSERT_MSG_EQ(route.contacts[1], second, "Second contact");
+        NS_TEST_ASSERT_MSG_EQ(graph->IsCurrent(route, Seconds(15)), true, "Current while unchanged");
+        NS_TEST_ASSERT_MSG_EQ(graph->IsCurrent(route, Seconds(25)), false, "Stale once a contact ended");
+
+        // Once the first contact is over only the direct one is left
+        route = graph->FindRoute(0, 2, Seconds(25));
+        NS_TEST_ASSERT_MSG_EQ(route.nextHop, 2u, "Direct next hop");
+        NS_TEST_ASSERT_MSG_EQ(route.arrival, Seconds(100) + MilliSeconds(1), "Direct arrival");
+
+        // A new contact that arrives earlier outdates the cached route
+        route = graph->FindRoute(0, 2, Seconds(0));
+        graph->AddContact(DtnContact(Seconds(2), Seconds(8), 0, 2));
+        NS_TEST_ASSERT_MSG_EQ(graph->IsCurrent(route, Seconds(1)), false, "Beaten by a new contact");
+        route = graph->FindRoute(0, 2, Seconds(1));
+        NS_TEST_ASSERT_MSG_EQ(route.arrival, Seconds(2) + MilliSeconds(1), "New contact taken");
+
+        NS_TEST_ASSERT_MSG_EQ(graph->FindRoute(0, 4, Seconds(0)).Exists(), false, "Disconnected component");
+        NS_TEST_ASSERT_MSG_EQ(graph->FindRoute(0, 9, Seconds(0)).Exists(), false, "Unknown node");
+        graph->RemoveNode(1);
+        NS_TEST_ASSERT_MSG_EQ(graph->FindRoute(0, 2, Seconds(9)).nextHop, 2u, "Around a removed node");
+    }
+};
+
+// Only the route's next hop gets the bundle; without a route the fallback decides
+class ContactGraphStrategyTestCase : public TestCase {
+public:
+    ContactGraphStrategyTestCase()
+        : TestCase("Contact graph strategy next hops and route cache") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        Ptr<DtnContactGraph> graph = Create<DtnContactGraph>(MilliSeconds(1));
+        graph->AddContact(DtnContact(Seconds(10), Seconds(20), 0, 1));
+        graph->AddContact(DtnContact(Seconds(30), Seconds(40), 1, 2));
+        ContactGraphStrategy cgr(graph, Create<EpidemicStrategy>());
+        cgr.SetNodeId(0);
+
+        NS_TEST_ASSERT_MSG_EQ(cgr.ShouldForward(2, 1, 1), true, "Next hop");
+        NS_TEST_ASSERT_MSG_EQ(cgr.ShouldForward(2, 1, 3), false, "Off the route");
+        NS_TEST_ASSERT_MSG_EQ(cgr.ShouldForward(2, 1, 2), true, "Destination itself");
+        NS_TEST_ASSERT_MSG_EQ(cgr.GetRouteComputations(), 1u, "Route cached");
+        NS_TEST_ASSERT_MSG_EQ(cgr.ShouldForward(7, 1, 3), true, "Fallback without a route");
+        NS_TEST_ASSERT_MSG_EQ(cgr.GetRouteComputations(), 2u, "One search per destination");
+
+        // A change elsewhere in the graph keeps the cached route
+        graph->AddContact(DtnContact(Seconds(50), Seconds(60), 5, 6));
+        cgr.ShouldForward(2, 1, 1);
+        NS_TEST_ASSERT_MSG_EQ(cgr.GetRouteComputations(), 2u, "Kept across an unrelated change");
+        graph->RemoveNode(1);
+        NS_TEST_ASSERT_MSG_EQ(cgr.ShouldForward(2, 1, 1), true, "No route left, fallback floods");
+        NS_TEST_ASSERT_MSG_EQ(cgr.GetRouteComputations(), 3u, "Broken route recomputed");
+    }
+};
+
+class DtnContactGraphTestSuite : public TestSuite {
+public:
+    DtnContactGraphTestSuite()
+        : TestSuite("dtn-contact-graph", Type::UNIT) {
+        AddTestCase(new DtnContactGraphTestCase, Duration::QUICK);
+        AddTestCase(new ContactGraphStrategyTestCase, Duration::QUICK);
+    }
+};
+
+static DtnContactGraphTestSuite g_dtnContactGraphTestSuite;
@@ -0,0 +1,97 @@
+/*
+ * DTN Contact Plan Tests
+ * Contact plan files written and read back
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "ns3/test.h"
+#include "ns3/dtn-contact-plan.h"
+#include <fstream>
+
+using namespace ns3;
+
+/*
+ * A written plan loads back as the same contacts, a pair going down and
+ * up at the same instant included, and one never going down stays open
+ */
+class DtnContactPlanRoundTripTestCase : public TestCase {
+public:
+    DtnContactPlanRoundTripTestCase()
+        : TestCase("Contact plan Write/Load round trip") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        DtnContactPlan recorded;
+        recorded.Add(DtnContact(Seconds(10), Seconds(20), 1, 2));
+        recorded.Add(DtnContact(Seconds(20), Seconds(30.5), 1, 2));
+        recorded.Add(DtnContact(Seconds(15), Time::Max(), 3, 1));
+        std::string path = CreateTempDirFilename("dtn-contact-plan.txt");
+        NS_TEST_ASSERT_MSG_EQ(recorded.Write(path), true, "Plan written");
+
+        DtnContactPlan replayed;
+        NS_TEST_ASSERT_MSG_EQ(replayed.Load(path), true, "Plan read");
+        NS_TEST_ASSERT_MSG_EQ(replayed.GetSize(), 3u, "Every contact back");
+        const std::vector<DtnContact>& contacts = replayed.GetContacts();
+        // In the order they went down, the open one last
+        NS_TEST_ASSERT_MSG_EQ(contacts[0].start, Seconds(10), "First contact start");
+        NS_TEST_ASSERT_MSG_EQ(contacts[0].end, Seconds(20), "First contact end");
+        NS_TEST_ASSERT_MSG_EQ(contacts[1].start, Seconds(20), "Reopened at the same instant");
+        NS_TEST_ASSERT_MSG_EQ(contacts[1].end, Seconds(30.5), "Second contact end");
+        NS_TEST_ASSERT_MSG_EQ(contacts[1].nodeA, 1u, "Second contact nodes");
+        NS_TEST_ASSERT_MSG_EQ(contacts[1].nodeB, 2u, "Second contact nodes");
+        NS_TEST_ASSERT_MSG_EQ(contacts[2].start, Seconds(15), "Open contact start");
+        NS_TEST_ASSERT_MSG_EQ(contacts[2].end, Time::Max(), "Open until the end of the run");
+        NS_TEST_ASSERT_MSG_EQ(MakeContactKey(contacts[2].nodeA, contacts[2].nodeB), MakeContactKey(1, 3),
+                              "Open contact nodes");
+    }
+};
+
+// CRAWDAD-style intervals, comments and unreadable lines
+class DtnContactPlanImportTestCase : public TestCase {
+public:
+    DtnContactPlanImportTestCase()
+        : TestCase("Contact plan import of interval traces") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        std::string path = CreateTempDirFilename("dtn-contact-trace.txt");
+        {
+            std::ofstream file(path.c_str());
+            file << "# iMote trace\n"
+                 << "4 5 100 160 3 0\n"
+                 << "\n"
+                 << "5 6 200 200\n"      // Empty interval
+                 << "6 7 -1 10\n"        // Negative time
+                 << "7 8 300 360.25  # trailing comment\n"
+                 << "0.5 CONN 1 2 sideways\n";
+        }
+
+        DtnContactPlan plan;
+        NS_TEST_ASSERT_MSG_EQ(plan.Load(path), true, "Trace read");
+        NS_TEST_ASSERT_MSG_EQ(plan.GetSize(), 2u, "Two contacts kept");
+        const std::vector<DtnContact>& contacts = plan.GetContacts();
+        NS_TEST_ASSERT_MSG_EQ(contacts[0].nodeA, 4u, "Node A");
+        NS_TEST_ASSERT_MSG_EQ(contacts[0].nodeB, 5u, "Node B");
+        NS_TEST_ASSERT_MSG_EQ(contacts[0].end, Seconds(160), "Extra columns ignored");
+        NS_TEST_ASSERT_MSG_EQ(contacts[1].start, Seconds(300), "Start");
+        NS_TEST_ASSERT_MSG_EQ(contacts[1].end, Seconds(360.25), "Comment stripped");
+
+        NS_TEST_ASSERT_MSG_EQ(plan.Load(CreateTempDirFilename("no-such-dir/plan.txt")), false, "Missing file");
+        NS_TEST_ASSERT_MSG_EQ(plan.GetSize(), 2u, "Nothing added");
+    }
+};
+
+class DtnContactPlanTestSuite : public TestSuite {
+public:
+    DtnContactPlanTestSuite()
+        : TestSuite("dtn-contact-plan", Type::UNIT) {
+        AddTestCase(new DtnContactPlanRoundTripTestCase, Duration::QUICK);
+        AddTestCase(new DtnContactPlanImportTestCase, Duration::QUICK);
+    }
+};
+
+static DtnContactPlanTestSuite g_dtnContactPlanTestSuite;
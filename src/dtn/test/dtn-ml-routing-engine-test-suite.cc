@@ -0,0 +1,109 @@
+/*
+ * DTN ML Routing Engine Tests
+ * Online learning from delivery feedback and model averaging
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "ns3/test.h"
+#include "ns3/dtn-bundle-header.h"
+#include "ns3/dtn-ml-routing-engine.h"
+#include <vector>
+
+using namespace ns3;
+
+/*
+ * Decisions wait in the ring until delivery or expiry resolves them; a
+ * full mini-batch then takes one averaged gradient step from zero weights
+ */
+class DtnMlOnlineLearningTestCase : public TestCase {
+public:
+    DtnMlOnlineLearningTestCase()
+        : TestCase("ML online learning from delivery feedback") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        MLRoutingEngine engine;
+        MLFeatureVector features;
+        features.fill(1.0);
+
+        // Two copies of bundle 0 resolve together; bundle 1 expires undelivered
+        engine.RecordDecision(MakeBundleKey(1, 0), features, 0.5, Seconds(100));
+        engine.RecordDecision(MakeBundleKey(1, 0), features, 0.5, Seconds(100));
+        engine.RecordDecision(MakeBundleKey(1, 1), features, 0.5, Seconds(10));
+        engine.UpdateLearningModel(MakeBundleKey(9, 9), true);
+        NS_TEST_ASSERT_MSG_EQ(engine.GetResolvedDecisions(), 0u, "Unknown bundle ignored");
+        engine.UpdateLearningModel(MakeBundleKey(1, 0), true);
+        NS_TEST_ASSERT_MSG_EQ(engine.GetResolvedDecisions(), 2u, "Both copies resolved");
+        engine.ExpireDecisions(Seconds(9));
+        NS_TEST_ASSERT_MSG_EQ(engine.GetResolvedDecisions(), 2u, "Not expired yet");
+        engine.ExpireDecisions(Seconds(10));
+        NS_TEST_ASSERT_MSG_EQ(engine.GetResolvedDecisions(), 3u, "Expiry is a failure");
+        engine.UpdateLearningModel(MakeBundleKey(1, 1), true);
+        NS_TEST_ASSERT_MSG_EQ(engine.GetResolvedDecisions(), 3u, "Resolved only once");
+        NS_TEST_ASSERT_MSG_EQ_TOL(engine.GetBrierScore(), 0.25, 1e-12, "Brier score");
+
+        // No step before the batch fills; 13 more successes fill it
+        NS_TEST_ASSERT_MSG_EQ(engine.GetTrainedSamples(), 0u, "Batch not full");
+        for (uint32_t id = 2; id < ML_MINI_BATCH; ++id) {
+            engine.RecordDecision(MakeBundleKey(1, id), features, 0.5, Seconds(100));
+            engine.UpdateLearningModel(MakeBundleKey(1, id), true);
+        }
+        NS_TEST_ASSERT_MSG_EQ(engine.GetTrainedSamples(), ML_MINI_BATCH, "One mini-batch trained");
+
+        // Zero weights predict 0.5: 15 errors of +0.5 and one of -0.5, times 0.1 / 16
+        double expected = 0.1 * (15 * 0.5 - 0.5) / ML_MINI_BATCH;
+        std::vector<double> weights = engine.GetWeights();
+        NS_TEST_ASSERT_MSG_EQ(weights.size(), ML_FEATURE_COUNT, "Weight count");
+        for (uint32_t i = 0; i < weights.size(); ++i) {
+            NS_TEST_ASSERT_MSG_EQ_TOL(weights[i], expected, 1e-12, "Gradient step on weight " << i);
+        }
+    }
+};
+
+// Sample-weighted averaging between meeting nodes
+class DtnMlModelAveragingTestCase : public TestCase {
+public:
+    DtnMlModelAveragingTestCase()
+        : TestCase("ML model averaging") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        MLRoutingEngine engine;
+        std::vector<double> own(ML_FEATURE_COUNT, 0.1);
+        NS_TEST_ASSERT_MSG_EQ(engine.SetWeights(own, 16), true, "Weights set");
+        NS_TEST_ASSERT_MSG_EQ(engine.SetWeights(std::vector<double>(3, 0.0), 16), false, "Wrong size rejected");
+
+        // Malformed or untrained peers change nothing
+        engine.AverageWith(std::vector<double>(3, 1.0), 40);
+        engine.AverageWith(std::vector<double>(ML_FEATURE_COUNT, 1.0), 0);
+        NS_TEST_ASSERT_MSG_EQ_TOL(engine.GetWeights()[0], 0.1, 1e-12, "Ignored peers");
+
+        std::vector<double> peer(ML_FEATURE_COUNT, 0.4);
+        engine.AverageWith(peer, 47);
+        double expected = (17 * 0.1 + 48 * 0.4) / 65;
+        for (double weight : engine.GetWeights()) {
+            NS_TEST_ASSERT_MSG_EQ_TOL(weight, expected, 1e-12, "Weighted average");
+        }
+        NS_TEST_ASSERT_MSG_EQ(engine.GetTrainedSamples(), 31u, "Sample count averaged");
+
+        // Meeting the same peer again moves towards it without inflating the count
+        engine.AverageWith(peer, 47);
+        NS_TEST_ASSERT_MSG_GT(engine.GetWeights()[0], expected, "Closer to the peer");
+        NS_TEST_ASSERT_MSG_EQ(engine.GetTrainedSamples(), 39u, "Count stays bounded");
+    }
+};
+
+class DtnMlRoutingEngineTestSuite : public TestSuite {
+public:
+    DtnMlRoutingEngineTestSuite()
+        : TestSuite("dtn-ml-routing-engine", Type::UNIT) {
+        AddTestCase(new DtnMlOnlineLearningTestCase, Duration::QUICK);
+        AddTestCase(new DtnMlModelAveragingTestCase, Duration::QUICK);
+    }
+};
+
+static DtnMlRoutingEngineTestSuite g_dtnMlRoutingEngineTestSuite;
@@ -0,0 +1,74 @@
+/*
+ * DTN Neighbour Discovery Tests
+ * Neighbour table contact-up/contact-down timing
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "ns3/test.h"
+#include "ns3/dtn-neighbor-discovery.h"
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/*
+ * Contacts close one hold time after the peer was last heard: a refresh
+ * pushes the deadline out, and a shrunk hold time pulls it in ahead of
+ * the check already pending
+ */
+class DtnNeighborTableTestCase : public TestCase {
+public:
+    DtnNeighborTableTestCase()
+        : TestCase("Neighbour table hold-time expiry") {
+    }
+
+private:
+    void ContactUp(uint32_t nodeId) { m_up.push_back(std::make_pair(Simulator::Now(), nodeId)); }
+    void ContactDown(uint32_t nodeId) { m_down.push_back(std::make_pair(Simulator::Now(), nodeId)); }
+
+    void Hear(uint32_t nodeId, Time holdTime) {
+        m_table.Heard(nodeId, InetSocketAddress(Ipv4Address("10.0.0.1"), 9), holdTime);
+    }
+
+    virtual void DoRun(void) {
+        m_table.SetContactUpCallback(MakeCallback(&DtnNeighborTableTestCase::ContactUp, this));
+        m_table.SetContactDownCallback(MakeCallback(&DtnNeighborTableTestCase::ContactDown, this));
+
+        NS_TEST_ASSERT_MSG_EQ(BeaconHoldTime(Seconds(1)), Seconds(3), "Three missed beacons");
+
+        // Node 1 refreshed at 2 s; node 2's hold time shrinks at 4 s; node 3 never refreshed
+        Simulator::Schedule(Seconds(0), &DtnNeighborTableTestCase::Hear, this, 1, Seconds(3));
+        Simulator::Schedule(Seconds(0), &DtnNeighborTableTestCase::Hear, this, 2, Seconds(10));
+        Simulator::Schedule(Seconds(1), &DtnNeighborTableTestCase::Hear, this, 3, Seconds(2.5));
+        Simulator::Schedule(Seconds(2), &DtnNeighborTableTestCase::Hear, this, 1, Seconds(3));
+        Simulator::Schedule(Seconds(4), &DtnNeighborTableTestCase::Hear, this, 2, Seconds(0.5));
+        Simulator::Run();
+        Simulator::Destroy();
+
+        NS_TEST_ASSERT_MSG_EQ(m_up.size(), 3u, "One contact-up per node, refreshes excluded");
+        std::vector<std::pair<Time, uint32_t> > expected = {
+            {Seconds(3.5), 3}, {Seconds(4.5), 2}, {Seconds(5), 1}};
+        NS_TEST_ASSERT_MSG_EQ(m_down.size(), expected.size(), "Every contact closed");
+        for (uint32_t i = 0; i < m_down.size() && i < expected.size(); ++i) {
+            NS_TEST_ASSERT_MSG_EQ(m_down[i].second, expected[i].second, "Contact-down order");
+            NS_TEST_ASSERT_MSG_EQ(m_down[i].first, expected[i].first, "Contact-down time of " << m_down[i].second);
+        }
+        NS_TEST_ASSERT_MSG_EQ(m_table.IsEmpty(), true, "Table empty");
+    }
+
+    NeighborTable m_table;
+    std::vector<std::pair<Time, uint32_t> > m_up;
+    std::vector<std::pair<Time, uint32_t> > m_down;
+};
+
+class DtnNeighborDiscoveryTestSuite : public TestSuite {
+public:
+    DtnNeighborDiscoveryTestSuite()
+        : TestSuite("dtn-neighbor-discovery", Type::UNIT) {
+        AddTestCase(new DtnNeighborTableTestCase, Duration::QUICK);
+    }
+};
+
+static DtnNeighborDiscoveryTestSuite g_dtnNeighborDiscoveryTestSuite;
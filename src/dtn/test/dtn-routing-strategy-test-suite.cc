@@ -0,0 +1,92 @@
+/*
+ * DTN Routing Strategy Tests
+ * PROPHET predictabilities and Spray-and-Wait copy budgets
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "ns3/test.h"
+#include "ns3/dtn-routing-strategy.h"
+#include <map>
+
+using namespace ns3;
+
+// Encounter reinforcement, transitivity through a peer's table, and aging
+class DtnProphetTestCase : public TestCase {
+public:
+    DtnProphetTestCase()
+        : TestCase("PROPHET encounter, transitivity and aging") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        Ptr<ProphetStrategy> prophet = Create<ProphetStrategy>();
+        prophet->SetNodeId(1);
+
+        // P(1,2) = 0.75; P(1,3) = 0.75 * 0.5 * beta; our own entry is skipped
+        std::map<uint32_t, double> peerTable = {{1, 0.9}, {3, 0.5}};
+        prophet->NotifyContact(2, peerTable);
+        NS_TEST_ASSERT_MSG_EQ_TOL(prophet->GetPredictability(2), 0.75, 1e-9, "Encounter");
+        NS_TEST_ASSERT_MSG_EQ_TOL(prophet->GetPredictability(3), 0.09375, 1e-9, "Transitivity");
+        NS_TEST_ASSERT_MSG_EQ(prophet->GetPredictabilities().count(1), 0u, "No entry for ourselves");
+
+        // A second encounter closes a quarter of the remaining gap
+        prophet->NotifyContact(2, peerTable);
+        NS_TEST_ASSERT_MSG_EQ_TOL(prophet->GetPredictability(2), 0.9375, 1e-9, "Reinforced");
+
+        // GRTR: the peer's 0.5 for node 3 beats ours, nothing known for node 4
+        NS_TEST_ASSERT_MSG_EQ(prophet->ShouldForward(3, 1, 2), true, "Better carrier");
+        NS_TEST_ASSERT_MSG_EQ(prophet->ShouldForward(4, 1, 2), false, "Unknown destination");
+        NS_TEST_ASSERT_MSG_EQ(prophet->ShouldForward(4, 1, 4), true, "Destination itself");
+        NS_TEST_ASSERT_MSG_EQ(prophet->ShouldForward(3, 1, 5), false, "Peer never met");
+
+        // Two 30 s aging units later: P = P_old * 0.98^2
+        double p2 = prophet->GetPredictability(2);
+        std::map<uint32_t, double> aged;
+        Simulator::Schedule(Seconds(60), [&]() { aged = prophet->GetPredictabilities(); });
+        Simulator::Run();
+        Simulator::Destroy();
+        NS_TEST_ASSERT_MSG_EQ_TOL(aged[2], p2 * 0.98 * 0.98, 1e-9, "Aged");
+    }
+};
+
+// Binary spraying halves the budget down to one copy, then waits
+class DtnSprayAndWaitTestCase : public TestCase {
+public:
+    DtnSprayAndWaitTestCase()
+        : TestCase("Spray-and-Wait copy halving") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        SprayAndWaitStrategy spray(8);
+        uint32_t copies = spray.GetInitialCopies();
+        NS_TEST_ASSERT_MSG_EQ(copies, 8u, "Initial budget");
+
+        const uint32_t handed[] = {4, 2, 1};
+        for (uint32_t expected : handed) {
+            NS_TEST_ASSERT_MSG_EQ(spray.ShouldForward(9, copies, 2), true, "Spray phase");
+            NS_TEST_ASSERT_MSG_EQ(spray.OnForward(copies), expected, "Half handed over");
+            NS_TEST_ASSERT_MSG_EQ(copies, expected, "Half kept");
+        }
+        NS_TEST_ASSERT_MSG_EQ(spray.ShouldForward(9, copies, 2), false, "Wait phase");
+        NS_TEST_ASSERT_MSG_EQ(spray.ShouldForward(9, copies, 9), true, "Destination in wait phase");
+
+        // An odd budget keeps the larger half
+        copies = 5;
+        NS_TEST_ASSERT_MSG_EQ(spray.OnForward(copies), 2u, "Floor handed over");
+        NS_TEST_ASSERT_MSG_EQ(copies, 3u, "Ceiling kept");
+    }
+};
+
+class DtnRoutingStrategyTestSuite : public TestSuite {
+public:
+    DtnRoutingStrategyTestSuite()
+        : TestSuite("dtn-routing-strategy", Type::UNIT) {
+        AddTestCase(new DtnProphetTestCase, Duration::QUICK);
+        AddTestCase(new DtnSprayAndWaitTestCase, Duration::QUICK);
+    }
+};
+
+static DtnRoutingStrategyTestSuite g_dtnRoutingStrategyTestSuite;
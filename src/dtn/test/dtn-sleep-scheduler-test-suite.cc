@@ -0,0 +1,89 @@
+/*
+ * DTN Sleep Scheduler Tests
+ * Overlap guarantee of the wakeup schedules
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "ns3/test.h"
+#include "ns3/dtn-bundle.h"
+#include "ns3/dtn-sleep-scheduler.h"
+#include <algorithm>
+
+using namespace ns3;
+
+namespace {
+
+// Longest run of slots in which a, and b with its slot counter offset
+// ahead, are never awake together; period is a common period of both
+uint64_t GetLongestMiss(const DtnWakeupSchedule& a, const DtnWakeupSchedule& b, int64_t offset, int64_t period) {
+    uint64_t longest = 0;
+    uint64_t run = 0;
+    // Two periods, so a run across the wrap is seen whole
+    for (int64_t slot = 0; slot < 2 * period; ++slot) {
+        if (a.IsAwakeSlot(slot) && b.IsAwakeSlot(slot + offset)) {
+            run = 0;
+        } else {
+            longest = std::max(longest, ++run);
+        }
+    }
+    return longest;
+}
+
+} // namespace
+
+/*
+ * Whatever the offset between two slot counters, every window of
+ * GetDiscoveryBound() slots holds a slot both nodes are awake in
+ */
+class DtnDiscoveryBoundTestCase : public TestCase {
+public:
+    DtnDiscoveryBoundTestCase()
+        : TestCase("Wakeup schedules meet within the discovery bound") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        DtnWakeupSchedule sensor = DtnWakeupSchedule::ForNodeType(IOT_SENSOR);
+        DtnWakeupSchedule civilian = DtnWakeupSchedule::ForNodeType(CIVILIAN_DEVICE);
+        DtnWakeupSchedule responder = DtnWakeupSchedule::ForNodeType(EMERGENCY_RESPONDER);
+        NS_TEST_ASSERT_MSG_EQ(DtnWakeupSchedule::GetDiscoveryBound(sensor, civilian), 7u * 23u, "Sensor and civilian");
+        NS_TEST_ASSERT_MSG_EQ(DtnWakeupSchedule::GetDiscoveryBound(civilian, civilian), 7u * 11u, "Same primes");
+        NS_TEST_ASSERT_MSG_EQ(DtnWakeupSchedule::GetDiscoveryBound(sensor, responder), 23u, "Facing always-on");
+        NS_TEST_ASSERT_MSG_EQ(DtnWakeupSchedule::GetDiscoveryBound(responder, responder), 1u, "Both always on");
+
+        // Offsets over b's own period cover every alignment
+        struct Pair {
+            DtnWakeupSchedule a;
+            DtnWakeupSchedule b;
+            int64_t period;
+        };
+        const Pair pairs[] = {
+            {sensor, civilian, 7 * 11 * 23 * 29},
+            {civilian, civilian, 7 * 11},
+            {civilian, sensor, 7 * 11 * 23 * 29},
+            {sensor, responder, 23 * 29},
+        };
+        for (const Pair& pair : pairs) {
+            uint64_t bound = DtnWakeupSchedule::GetDiscoveryBound(pair.a, pair.b);
+            int64_t offsets = pair.b.IsAlwaysOn() ? 1 : (int64_t)pair.b.GetPrimeA() * pair.b.GetPrimeB();
+            uint64_t longest = 0;
+            for (int64_t offset = 0; offset < offsets; ++offset) {
+                longest = std::max(longest, GetLongestMiss(pair.a, pair.b, offset, pair.period));
+            }
+            NS_TEST_ASSERT_MSG_LT(longest, bound, "Missed for a whole bound, primes " << pair.a.GetPrimeA() << "/"
+                                  << pair.a.GetPrimeB() << " and " << pair.b.GetPrimeA() << "/" << pair.b.GetPrimeB());
+        }
+    }
+};
+
+class DtnSleepSchedulerTestSuite : public TestSuite {
+public:
+    DtnSleepSchedulerTestSuite()
+        : TestSuite("dtn-sleep-scheduler", Type::UNIT) {
+        AddTestCase(new DtnDiscoveryBoundTestCase, Duration::QUICK);
+    }
+};
+
+static DtnSleepSchedulerTestSuite g_dtnSleepSchedulerTestSuite;
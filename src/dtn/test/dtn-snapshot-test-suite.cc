@@ -0,0 +1,169 @@
+/*
+ * DTN Snapshot Tests
+ * Snapshots written, read back and restored into a fresh run
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "ns3/test.h"
+#include "ns3/dtn-contact-plan.h"
+#include "ns3/dtn-helper.h"
+#include "ns3/dtn-snapshot.h"
+#include <fstream>
+#include <sstream>
+
+using namespace ns3;
+
+namespace {
+
+// Two DTN nodes out of contact, both moving at (1, 2, 0) m/s from 10 m apart
+ApplicationContainer InstallNodes(NodeContainer nodes) {
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
+    mobility.Install(nodes);
+    for (uint32_t i = 0; i < nodes.GetN(); i++) {
+        Ptr<ConstantVelocityMobilityModel> model = nodes.Get(i)->GetObject<ConstantVelocityMobilityModel>();
+        model->SetPosition(Vector(10.0 * i, 0.0, 0.0));
+        model->SetVelocity(Vector(1.0, 2.0, 0.0));
+    }
+    NetDeviceContainer devices = DtnHelper::InstallContactPlan(nodes, DtnContactPlan());
+    DtnHelper::InstallInternet(nodes, devices, "10.1.0.0");
+    DtnHelper dtn;
+    dtn.SetRoutingStrategy("Prophet");
+    return dtn.Install(nodes);
+}
+
+Ptr<DtnApplication> GetDtn(ApplicationContainer apps, uint32_t i) {
+    return DynamicCast<DtnApplication>(apps.Get(i));
+}
+
+std::string ReadFile(std::string path) {
+    std::ifstream file(path.c_str());
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+} // namespace
+
+/*
+ * A captured run written and loaded back writes the same file again, and
+ * restored into a fresh run puts the buffers and positions back
+ */
+class DtnSnapshotRoundTripTestCase : public TestCase {
+public:
+    DtnSnapshotRoundTripTestCase()
+        : TestCase("Snapshot Write/Load round trip and restore") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        std::string path = CreateTempDirFilename("dtn-snapshot.txt");
+        DtnSnapshot captured;
+        {
+            NodeContainer nodes;
+            nodes.Create(2);
+            ApplicationContainer apps = InstallNodes(nodes);
+            apps.Start(Seconds(0));
+            Ptr<DtnApplication> first = GetDtn(apps, 0);
+            Ptr<DtnApplication> second = GetDtn(apps, 1);
+            uint32_t firstId = nodes.Get(0)->GetId();
+            uint32_t secondId = nodes.Get(1)->GetId();
+            Simulator::Schedule(Seconds(1), [=]() {
+                first->SendBundle(secondId, 0, "urgent");
+                first->SendBundle(secondId, 2, "routine");
+                second->SendBundle(firstId, 1, "reply");
+            });
+            Simulator::Schedule(Seconds(10), &DtnSnapshot::Capture, &captured, nodes);
+            Simulator::Stop(Seconds(10.5));
+            Simulator::Run();
+            Simulator::Destroy();
+        }
+        NS_TEST_ASSERT_MSG_EQ(captured.GetTime(), Seconds(10), "Capture time");
+        NS_TEST_ASSERT_MSG_EQ(captured.GetNodeCount(), 2u, "Nodes captured");
+        NS_TEST_ASSERT_MSG_EQ(captured.GetBundleCount(), 3u, "Bundles captured");
+        NS_TEST_ASSERT_MSG_EQ(captured.Write(path), true, "Snapshot written");
+
+        DtnSnapshot loaded;
+        NS_TEST_ASSERT_MSG_EQ(loaded.Load(path), true, "Snapshot read");
+        NS_TEST_ASSERT_MSG_EQ(loaded.GetTime(), Seconds(10), "Loaded time");
+        NS_TEST_ASSERT_MSG_EQ(loaded.GetBundleCount(), 3u, "Loaded bundles");
+        std::string again = CreateTempDirFilename("dtn-snapshot-again.txt");
+        NS_TEST_ASSERT_MSG_EQ(loaded.Write(again), true, "Loaded snapshot written");
+        NS_TEST_ASSERT_MSG_EQ((ReadFile(again) == ReadFile(path)), true, "Same file after a round trip");
+
+        NodeContainer nodes;
+        nodes.Create(2);
+        ApplicationContainer apps = InstallNodes(nodes);
+        apps.Start(loaded.GetTime());
+        Simulator::Schedule(loaded.GetTime(), &DtnSnapshot::Restore, &loaded, nodes);
+        Simulator::Stop(Seconds(10.5));
+        Simulator::Run();
+        NS_TEST_ASSERT_MSG_EQ(GetDtn(apps, 0)->GetBufferedBundles(), 2u, "First buffer restored");
+        NS_TEST_ASSERT_MSG_EQ(GetDtn(apps, 1)->GetBufferedBundles(), 1u, "Second buffer restored");
+        // Restored at (10, 20) and (20, 20), moving on at the saved velocity
+        Vector position = nodes.Get(1)->GetObject<MobilityModel>()->GetPosition();
+        NS_TEST_ASSERT_MSG_EQ_TOL(position.x, 20.5, 1e-9, "Restored x");
+        NS_TEST_ASSERT_MSG_EQ_TOL(position.y, 21.0, 1e-9, "Restored y");
+        Simulator::Destroy();
+    }
+};
+
+// A file with any unreadable record is rejected whole and leaves the snapshot as it was
+class DtnSnapshotRejectTestCase : public TestCase {
+public:
+    DtnSnapshotRejectTestCase()
+        : TestCase("Snapshot rejects unreadable files") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        std::string path = CreateTempDirFilename("dtn-snapshot-good.txt");
+        {
+            std::ofstream file(path.c_str());
+            file << "# two nodes\n"
+                 << "SNAPSHOT " << DtnSnapshot::VERSION << " 5000000000\n"
+                 << "NODE 0 1 2 0 0 0 0\n"
+                 << "APP 0 1 3\n"
+                 << "BUNDLE 0 1 0 1 2 0 3600000000000 0 1 0 0 0 0 0 1 0 6869\n"
+                 << "NODE 1 4 5 0 0 0 0\n";
+        }
+        DtnSnapshot snapshot;
+        NS_TEST_ASSERT_MSG_EQ(snapshot.Load(path), true, "Hand-written snapshot read");
+        NS_TEST_ASSERT_MSG_EQ(snapshot.GetTime(), Seconds(5), "Time");
+        NS_TEST_ASSERT_MSG_EQ(snapshot.GetNodeCount(), 2u, "Nodes");
+        NS_TEST_ASSERT_MSG_EQ(snapshot.GetBundleCount(), 1u, "Bundles");
+
+        // Other version, no header, truncated bundle, bad payload hex, not a number, empty
+        const char* broken[] = {
+            "SNAPSHOT 99 0\n",
+            "NODE 0 1 2 0 0 0 0\n",
+            "SNAPSHOT 1 0\nBUNDLE 0 1 0 1 2 0 1 0 1 0\n",
+            "SNAPSHOT 1 0\nBUNDLE 0 1 0 1 2 0 1 0 1 0 0 0 0 0 0 6g\n",
+            "SNAPSHOT 1 0\nAPP 0 one 3\n",
+            "# nothing but a comment\n",
+        };
+        std::string brokenPath = CreateTempDirFilename("dtn-snapshot-broken.txt");
+        for (const char* contents : broken) {
+            {
+                std::ofstream file(brokenPath.c_str());
+                file << contents;
+            }
+            NS_TEST_ASSERT_MSG_EQ(snapshot.Load(brokenPath), false, "Rejected: " << contents);
+            NS_TEST_ASSERT_MSG_EQ(snapshot.GetBundleCount(), 1u, "Kept after: " << contents);
+        }
+        NS_TEST_ASSERT_MSG_EQ(snapshot.Load(CreateTempDirFilename("no-such-dir/snapshot.txt")), false, "Missing file");
+    }
+};
+
+class DtnSnapshotTestSuite : public TestSuite {
+public:
+    DtnSnapshotTestSuite()
+        : TestSuite("dtn-snapshot", Type::UNIT) {
+        AddTestCase(new DtnSnapshotRoundTripTestCase, Duration::QUICK);
+        AddTestCase(new DtnSnapshotRejectTestCase, Duration::QUICK);
+    }
+};
+
+static DtnSnapshotTestSuite g_dtnSnapshotTestSuite;
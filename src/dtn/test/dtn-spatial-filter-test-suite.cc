@@ -0,0 +1,64 @@
+/*
+ * DTN Spatial Filter Tests
+ * Grid reach bound of the transmit filter
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "ns3/test.h"
+#include "ns3/dtn-spatial-filter.h"
+#include <cstdlib>
+
+using namespace ns3;
+
+/*
+ * The filter must never drop a receiver within MaxRange. Per axis: two
+ * nodes binned at a and b that have since drifted up to maxSpeed *
+ * RefreshInterval each, and are now within MaxRange, sit at most reach
+ * cells apart. A Euclidean distance within MaxRange bounds both axes.
+ */
+class DtnSpatialFilterReachTestCase : public TestCase {
+public:
+    DtnSpatialFilterReachTestCase()
+        : TestCase("Spatial filter reach bound") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        const double maxRange = 250.0;
+        const Time interval = Seconds(1);
+        NS_TEST_ASSERT_MSG_EQ(DtnSpatialFilter::GetReach(maxRange, 0.0, interval), 1, "Static nodes");
+        NS_TEST_ASSERT_MSG_EQ(DtnSpatialFilter::GetReach(maxRange, 40.0, interval), 2, "Drift widens the reach");
+        NS_TEST_ASSERT_MSG_EQ(DtnSpatialFilter::GetCell(-0.5, maxRange), -1, "Cells floor below zero");
+
+        const double speeds[] = {0.0, 5.0, 40.0, 150.0};
+        for (double speed : speeds) {
+            int32_t reach = DtnSpatialFilter::GetReach(maxRange, speed, interval);
+            double drift = speed * interval.GetSeconds();
+            // Binned separations up to the farthest that can drift back within range
+            double widest = maxRange + 2.0 * drift;
+            for (double a = -600.0; a <= 600.0; a += 7.3) {
+                for (double step = 0.0; step <= 400.0; step += 1.0) {
+                    double separation = std::min(step / 400.0 * widest, widest);
+                    for (double b : {a - separation, a + separation}) {
+                        int32_t cells = std::abs(DtnSpatialFilter::GetCell(a, maxRange) -
+                                                 DtnSpatialFilter::GetCell(b, maxRange));
+                        NS_TEST_ASSERT_MSG_LT_OR_EQ(cells, reach, "Kept at speed " << speed << ", a " << a
+                                                                                   << ", b " << b);
+                    }
+                }
+            }
+        }
+    }
+};
+
+class DtnSpatialFilterTestSuite : public TestSuite {
+public:
+    DtnSpatialFilterTestSuite()
+        : TestSuite("dtn-spatial-filter", Type::UNIT) {
+        AddTestCase(new DtnSpatialFilterReachTestCase, Duration::QUICK);
+    }
+};
+
+static DtnSpatialFilterTestSuite g_dtnSpatialFilterTestSuite;
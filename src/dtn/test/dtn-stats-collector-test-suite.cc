@@ -0,0 +1,79 @@
+/*
+ * DTN Statistics Tests
+ * Latency histogram quantile accuracy
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "ns3/test.h"
+#include "ns3/dtn-stats-collector.h"
+#include <cmath>
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+// Quantiles within 2.5% of the exact sample, clamped to the observed range
+class DtnLatencyHistogramTestCase : public TestCase {
+public:
+    DtnLatencyHistogramTestCase()
+        : TestCase("Latency histogram quantiles") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        DtnLatencyHistogram histogram;
+        NS_TEST_ASSERT_MSG_EQ(histogram.GetQuantile(0.5), 0.0, "Empty histogram");
+
+        // 0.1 s .. 1000 s, spread over four decades; the q-th sample is exact for comparison
+        const uint32_t samples = 10000;
+        for (uint32_t i = 1; i <= samples; ++i) {
+            histogram.Add(0.1 * i);
+        }
+        NS_TEST_ASSERT_MSG_EQ(histogram.GetCount(), samples, "Count");
+        NS_TEST_ASSERT_MSG_EQ_TOL(histogram.GetMean(), 0.1 * (samples + 1) / 2, 1e-6, "Exact mean");
+        NS_TEST_ASSERT_MSG_EQ_TOL(histogram.GetMin(), 0.1, 1e-12, "Min");
+        NS_TEST_ASSERT_MSG_EQ_TOL(histogram.GetMax(), 1000.0, 1e-9, "Max");
+        const double quantiles[] = {0.001, 0.01, 0.25, 0.5, 0.9, 0.99, 0.999};
+        for (double q : quantiles) {
+            double exact = 0.1 * std::ceil(q * samples);
+            double estimate = histogram.GetQuantile(q);
+            NS_TEST_ASSERT_MSG_EQ_TOL(estimate / exact, 1.0, 0.025, "Quantile " << q << ": " << estimate
+                                                                                << " for " << exact);
+        }
+        NS_TEST_ASSERT_MSG_EQ_TOL(histogram.GetQuantile(1.0), 1000.0, 1000.0 * 0.025, "Maximum quantile");
+
+        // Every sample lands in exactly one written bucket
+        std::ostringstream csv;
+        histogram.Write(csv);
+        std::istringstream rows(csv.str());
+        std::string row;
+        std::getline(rows, row);
+        uint64_t total = 0;
+        while (std::getline(rows, row)) {
+            total += std::stoull(row.substr(row.rfind(',') + 1));
+        }
+        NS_TEST_ASSERT_MSG_EQ(total, samples, "Bucket counts");
+
+        // A lone sample, even below the 1 ms floor, is reported as itself
+        histogram.Reset();
+        NS_TEST_ASSERT_MSG_EQ(histogram.GetCount(), 0u, "Reset");
+        histogram.Add(0.0002);
+        NS_TEST_ASSERT_MSG_EQ_TOL(histogram.GetQuantile(0.5), 0.0002, 1e-12, "Clamped to the sample");
+        histogram.Reset();
+        histogram.Add(42.0);
+        NS_TEST_ASSERT_MSG_EQ_TOL(histogram.GetQuantile(0.0), 42.0, 1e-12, "Lowest quantile");
+        NS_TEST_ASSERT_MSG_EQ_TOL(histogram.GetQuantile(0.99), 42.0, 1e-12, "Highest quantile");
+    }
+};
+
+class DtnStatsCollectorTestSuite : public TestSuite {
+public:
+    DtnStatsCollectorTestSuite()
+        : TestSuite("dtn-stats-collector", Type::UNIT) {
+        AddTestCase(new DtnLatencyHistogramTestCase, Duration::QUICK);
+    }
+};
+
+static DtnStatsCollectorTestSuite g_dtnStatsCollectorTestSuite;
@@ -0,0 +1,106 @@
+/*
+ * DTN Summary Vector Tests
+ * Summary vector serialization, split and merge
+ *
+ * Author: Krishnendu
+ * Project: Final Year - Massive DTN Implementation
+ */
+
+#include "ns3/test.h"
+#include "ns3/dtn-bundle-header.h"
+#include "ns3/dtn-summary-vector-header.h"
+#include <map>
+#include <vector>
+
+using namespace ns3;
+
+// Summary vector round trip, and a vector split into parts and merged again
+class DtnSummaryVectorTestCase : public TestCase {
+public:
+    DtnSummaryVectorTestCase()
+        : TestCase("Summary vector serialization, split and merge") {
+    }
+
+private:
+    virtual void DoRun(void) {
+        DtnSummaryVectorHeader vector;
+        vector.SetSenderNode(42);
+        vector.SetBundleKeys({MakeBundleKey(9, 1), MakeBundleKey(2, 7), MakeBundleKey(2, 3)});
+        vector.SetPredictabilities({{1, 0.25}, {8, 1.0}, {30, 0.0}});
+        vector.SetDeliveredKeys({MakeBundleKey(5, 5)});
+        vector.SetModel({0.5, -1.25}, 17);
+
+        Ptr<Packet> packet = Create<Packet>();
+        packet->AddHeader(vector);
+        NS_TEST_ASSERT_MSG_EQ(packet->GetSize(), vector.GetSerializedSize(), "Serialized size");
+        DtnSummaryVectorHeader read;
+        packet->RemoveHeader(read);
+        NS_TEST_ASSERT_MSG_EQ(packet->GetSize(), 0u, "Vector consumed whole");
+        NS_TEST_ASSERT_MSG_EQ(read.GetSenderNode(), 42u, "Sender");
+        NS_TEST_ASSERT_MSG_EQ(read.GetPartCount(), 1, "Single part");
+        NS_TEST_ASSERT_MSG_EQ(read.IsLastPart(), true, "Single part is the last");
+        NS_TEST_ASSERT_MSG_EQ(read.GetBundleKeys().size(), 3u, "Key count");
+        NS_TEST_ASSERT_MSG_EQ(read.GetBundleKeys().front(), MakeBundleKey(2, 3), "Keys sorted");
+        NS_TEST_ASSERT_MSG_EQ(read.Contains(MakeBundleKey(9, 1)), true, "Contains a key");
+        NS_TEST_ASSERT_MSG_EQ(read.Contains(MakeBundleKey(9, 2)), false, "Not a key");
+        NS_TEST_ASSERT_MSG_EQ(read.GetPredictabilities().size(), 3u, "Table size");
+        NS_TEST_ASSERT_MSG_EQ_TOL(read.GetPredictabilities().at(1), 0.25, 1.0 / 0xFFFF, "Quantised p");
+        NS_TEST_ASSERT_MSG_EQ_TOL(read.GetPredictabilities().at(8), 1.0, 1.0 / 0xFFFF, "Quantised p = 1");
+        NS_TEST_ASSERT_MSG_EQ(read.GetDeliveredKeys().size(), 1u, "Delivered keys");
+        NS_TEST_ASSERT_MSG_EQ(read.GetDeliveredKeys().front(), MakeBundleKey(5, 5), "Delivered key");
+        NS_TEST_ASSERT_MSG_EQ(read.GetModelWeights().size(), 2u, "Model weights");
+        NS_TEST_ASSERT_MSG_EQ_TOL(read.GetModelWeights()[1], -1.25, 1e-6, "Model weight");
+        NS_TEST_ASSERT_MSG_EQ(read.GetModelSamples(), 17u, "Model samples");
+
+        // Thousands of keys in 200-byte parts
+        std::vector<uint64_t> keys;
+        std::vector<uint64_t> delivered;
+        std::map<uint32_t, double> table;
+        for (uint32_t k = 0; k < 3000; ++k) {
+            keys.push_back(MakeBundleKey(k % 97, k));
+            delivered.push_back(MakeBundleKey(200 + k % 13, k));
+        }
+        for (uint32_t node = 0; node < 300; ++node) {
+            table[node] = node / 300.0;
+        }
+        DtnSummaryVectorHeader large;
+        large.SetSenderNode(7);
+        large.SetBundleKeys(keys);
+        large.SetDeliveredKeys(delivered);
+        large.SetPredictabilities(table);
+        std::vector<DtnSummaryVectorHeader> parts = large.Split(200);
+        NS_TEST_ASSERT_MSG_GT(parts.size(), 1u, "Large vector split");
+
+        DtnSummaryVectorHeader merged;
+        for (const DtnSummaryVectorHeader& part : parts) {
+            NS_TEST_ASSERT_MSG_LT_OR_EQ(part.GetSerializedSize(), 200u, "Part fits");
+            NS_TEST_ASSERT_MSG_EQ(part.GetPartCount(), parts.size(), "Part count");
+            packet = Create<Packet>();
+            packet->AddHeader(part);
+            packet->RemoveHeader(read);
+            NS_TEST_ASSERT_MSG_EQ(read.GetSenderNode(), 7u, "Every part names the sender");
+            if (read.GetPart() == 0) {
+                merged = read;
+            } else {
+                merged.Merge(read);
+            }
+        }
+        NS_TEST_ASSERT_MSG_EQ(merged.IsLastPart(), true, "Merged up to the last part");
+        NS_TEST_ASSERT_MSG_EQ((merged.GetBundleKeys() == large.GetBundleKeys()), true, "Keys merged in order");
+        NS_TEST_ASSERT_MSG_EQ(merged.GetDeliveredKeys().size(), delivered.size(), "Delivered keys merged");
+        NS_TEST_ASSERT_MSG_EQ(merged.GetPredictabilities().size(), table.size(), "Table merged");
+        for (uint64_t key : keys) {
+            NS_TEST_ASSERT_MSG_EQ(merged.Contains(key), true, "Merged vector contains " << key);
+        }
+    }
+};
+
+class DtnSummaryVectorTestSuite : public TestSuite {
+public:
+    DtnSummaryVectorTestSuite()
+        : TestSuite("dtn-summary-vector", Type::UNIT) {
+        AddTestCase(new DtnSummaryVectorTestCase, Duration::QUICK);
+    }
+};
+
+static DtnSummaryVectorTestSuite g_dtnSummaryVectorTestSuite;